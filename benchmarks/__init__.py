@@ -0,0 +1,25 @@
+"""
+Benchmark suite for the egg drop, radiation pattern and Life engines.
+
+Run `python -m benchmarks --help` from the repository root.
+"""
+
+import importlib
+from typing import List, Tuple
+
+from .harness import Case
+
+SUITES = ("bench_egg_drop", "bench_radiation", "bench_life")
+
+
+def load_cases() -> Tuple[List[Case], List[str]]:
+    """Return every case whose subsystem imports, and why the others were skipped"""
+    cases, skipped = [], []
+    for suite in SUITES:
+        try:
+            module = importlib.import_module(f"{__name__}.{suite}")
+        except (ImportError, RuntimeError) as e:
+            skipped.append(f"{suite}: {e}")
+            continue
+        cases.extend(module.CASES)
+    return cases, skipped
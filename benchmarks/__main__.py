@@ -0,0 +1,104 @@
+"""Command line entry point: python -m benchmarks [filters] [options]"""
+
+import argparse
+import json
+import os
+import sys
+
+from . import load_cases
+from .harness import (ROOT, compare, format_bytes, format_rate, load_baseline, machine_info,
+                      measure, run_in_worker, save_baseline)
+
+DEFAULT_BASELINE = os.path.join(ROOT, "benchmarks", "baseline.json")
+
+
+def _default_threads() -> str:
+    counts, n = [], 1
+    while n < (os.cpu_count() or 1):
+        counts.append(n)
+        n *= 2
+    return ",".join(map(str, counts + [os.cpu_count() or 1]))
+
+
+def _parse_args(argv):
+    parser = argparse.ArgumentParser(
+        prog="python -m benchmarks",
+        description="Measure egg drop, array factor and Life throughput, optionally against a stored baseline.")
+    parser.add_argument("filters", nargs="*", help="only run cases whose name starts with one of these")
+    parser.add_argument("--threads", default=_default_threads(),
+                        help="comma-separated thread counts for threaded cases (default: %(default)s)")
+    parser.add_argument("--repeat", type=int, default=10, help="timed runs per case (default: %(default)s)")
+    parser.add_argument("--warmup", type=int, default=1, help="untimed runs first (default: %(default)s)")
+    parser.add_argument("--baseline", default=DEFAULT_BASELINE, help="baseline file (default: %(default)s)")
+    parser.add_argument("--save-baseline", action="store_true", help="store this run as the baseline")
+    parser.add_argument("--compare", action="store_true",
+                        help="compare against the baseline, exit 1 on a regression")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="relative throughput drop counted as a regression (default: %(default)s)")
+    parser.add_argument("--json", metavar="PATH", help="also write the results to PATH")
+    parser.add_argument("--list", action="store_true", help="list the cases and exit")
+    parser.add_argument("--worker", help=argparse.SUPPRESS)
+    return parser.parse_args(argv)
+
+
+def _worker(args) -> int:
+    cases, _ = load_cases()
+    case = next(c for c in cases if c.name == args.worker)
+    result = measure(case, int(args.threads), args.repeat, args.warmup)
+    print(json.dumps(result.to_json()))
+    return 0
+
+
+def main(argv=None) -> int:
+    args = _parse_args(argv)
+    if args.worker:
+        return _worker(args)
+
+    cases, skipped = load_cases()
+    for note in skipped:
+        print(f"skipped {note}", file=sys.stderr)
+    cases = [c for c in cases if not args.filters or c.name.startswith(tuple(args.filters))]
+    if args.list:
+        for case in cases:
+            print(case.name)
+        return 0
+
+    baseline = {}
+    if args.compare:
+        machine, baseline = load_baseline(args.baseline)
+        if machine != machine_info():
+            print(f"warning: baseline was measured on {machine}", file=sys.stderr)
+
+    thread_counts = sorted({int(t) for t in args.threads.split(",")})
+    results = []
+    print(f"{'case':<44} {'thr':>3} {'median':>15} {'±ci95':>7} {'speedup':>7} {'rss':>10}  status")
+    for case in cases:
+        single = None
+        for threads in thread_counts if case.threaded else [1]:
+            result = run_in_worker(case.name, threads, args.repeat, args.warmup)
+            results.append(result)
+            single = single or result.median
+            comparison = compare([result], baseline, args.threshold)[0] if args.compare else None
+            status = ""
+            if comparison:
+                status = comparison.status if comparison.baseline is None else \
+                    f"{comparison.status} ({comparison.change:+.1%})"
+            print(f"{case.name:<44} {threads:>3} {format_rate(result.median) + result.unit:>15} "
+                  f"{result.spread:>6.1%} {result.median / single:>6.2f}x "
+                  f"{format_bytes(result.rss_growth):>10}  {status}", flush=True)
+
+    if args.json:
+        save_baseline(args.json, results)
+    if args.save_baseline:
+        save_baseline(args.baseline, results)
+        print(f"baseline saved to {args.baseline}")
+    if args.compare:
+        regressions = [c for c in compare(results, baseline, args.threshold) if c.status == "REGRESSION"]
+        for c in regressions:
+            print(f"regression: {c.current.key} {c.change:+.1%}", file=sys.stderr)
+        return 1 if regressions else 0
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,44 @@
+"""Egg drop query throughput"""
+
+import os
+import sys
+
+from .harness import ROOT, Case
+
+# dragon_eggs is a script directory rather than a package
+sys.path.insert(0, os.path.join(ROOT, "dragon_eggs"))
+import numpy as np
+from egg_drop_hybrid import HybridEggDropSolver
+
+BATCH_QUERIES = 200_000
+BATCH_FLOORS = 1_000_000
+SWEEP_FLOORS = 2_000
+
+
+def _batch(closed_form: bool) -> Case:
+    def setup(threads):
+        rng = np.random.default_rng(0)
+        return HybridEggDropSolver(), rng.integers(1, BATCH_FLOORS + 2, BATCH_QUERIES, dtype=np.uint32)
+
+    def run(state):
+        solver, breaking = state
+        solver.find_breaking_points(breaking, BATCH_FLOORS, closed_form=closed_form)
+        return len(breaking)
+
+    suffix = "_closed_form" if closed_form else ""
+    return Case(f"egg_drop.batch{suffix}[floors={BATCH_FLOORS}]", "queries/s", setup, run, threaded=False)
+
+
+def _sweep() -> Case:
+    def setup(threads):
+        return HybridEggDropSolver(), threads
+
+    def run(state):
+        solver, threads = state
+        stats, _ = solver.sweep(1, SWEEP_FLOORS, threads=threads)
+        return stats["queries"]
+
+    return Case(f"egg_drop.sweep[floors=1..{SWEEP_FLOORS}]", "queries/s", setup, run)
+
+
+CASES = [_batch(False), _batch(True), _sweep()]
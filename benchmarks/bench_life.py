@@ -0,0 +1,30 @@
+"""Life cell updates per second on each backend"""
+
+import random
+
+from life import Game, Grid
+
+from .harness import Case
+
+
+def _soup(size: int) -> Grid:
+    rng = random.Random(1)
+    return Grid((r, c) for r in range(size) for c in range(size) if rng.random() < 0.35)
+
+
+def _steps(backend: str, size: int, generations: int) -> Case:
+    soup = _soup(size)
+
+    def setup(threads):
+        return Game(soup, backend=backend, threads=threads if backend != "python" else None)
+
+    def run(game):
+        game.run(generations)
+        # Nominal updates: the soup's square for every generation
+        return size * size * generations
+
+    return Case(f"life.{backend}[soup={size},gens={generations}]", "cells/s", setup, run,
+                threaded=backend != "python")
+
+
+CASES = [_steps("native", 512, 256), _steps("tiled", 512, 256), _steps("python", 64, 16)]
@@ -0,0 +1,28 @@
+"""Array factor evaluations per second against array size and angle count"""
+
+import numpy as np
+
+from radiation_pattern.linear_array_hybrid import ArrayParameters, calculate_pattern
+
+from .harness import Case
+
+ELEMENTS = (16, 128, 1024)
+ANGLES = (721, 16384)
+
+
+def _pattern(n_elements: int, n_angles: int, precision: str) -> Case:
+    def setup(threads):
+        params = ArrayParameters(n_elements=n_elements, spacing_wavelength=0.5, steering_angle=20.0)
+        return params, np.linspace(-90, 90, n_angles)
+
+    def run(state):
+        params, theta = state
+        calculate_pattern(params, theta, precision=precision)
+        return n_elements * n_angles
+
+    # The C kernels only go parallel above 1000 angles
+    name = f"radiation.pattern_{precision}[N={n_elements},M={n_angles}]"
+    return Case(name, "evals/s", setup, run, threaded=n_angles > 1000)
+
+CASES = [_pattern(n, m, "double") for n in ELEMENTS for m in ANGLES]
+CASES.append(_pattern(128, 16384, "single"))
@@ -0,0 +1,230 @@
+"""Timing, statistics and baseline comparison shared by every benchmark case"""
+
+import json
+import os
+import platform
+import random
+import statistics
+import subprocess
+import sys
+import time
+from dataclasses import dataclass, field
+from typing import Callable, Dict, List, Optional
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# Bootstrap resamples for the confidence interval of the median
+BOOTSTRAP_RESAMPLES = 2000
+
+
+@dataclass
+class Case:
+    """One benchmark: setup(threads) builds fresh state, run(state) is the timed work.
+
+    run returns how much work it did, in unit (queries, evaluations, cell
+    updates), so results are throughputs; threaded cases are repeated for
+    every requested thread count.
+    """
+    name: str
+    unit: str
+    setup: Callable[[int], object]
+    run: Callable[[object], float]
+    threaded: bool = True
+
+
+@dataclass
+class Result:
+    """Throughput samples of one case at one thread count"""
+    name: str
+    unit: str
+    threads: int
+    samples: List[float]
+    peak_rss: int = 0
+    rss_growth: int = 0
+    median: float = field(init=False)
+    ci_low: float = field(init=False)
+    ci_high: float = field(init=False)
+
+    def __post_init__(self):
+        self.median = statistics.median(self.samples)
+        self.ci_low, self.ci_high = bootstrap_ci(self.samples)
+
+    @property
+    def key(self) -> str:
+        return f"{self.name}@{self.threads}"
+
+    @property
+    def spread(self) -> float:
+        """Relative half-width of the confidence interval"""
+        return (self.ci_high - self.ci_low) / (2 * self.median) if self.median else 0.0
+
+    def to_json(self) -> dict:
+        return {"name": self.name, "unit": self.unit, "threads": self.threads,
+                "samples": self.samples, "peak_rss": self.peak_rss,
+                "rss_growth": self.rss_growth}
+
+    @classmethod
+    def from_json(cls, data: dict) -> "Result":
+        return cls(data["name"], data["unit"], data["threads"], data["samples"],
+                   data.get("peak_rss", 0), data.get("rss_growth", 0))
+
+
+def bootstrap_ci(samples: List[float], confidence: float = 0.95) -> tuple:
+    """Percentile bootstrap interval of the median, seeded so reruns agree"""
+    if len(samples) < 2:
+        return samples[0], samples[0]
+    rng = random.Random(0)
+    medians = sorted(statistics.median(rng.choices(samples, k=len(samples)))
+                     for _ in range(BOOTSTRAP_RESAMPLES))
+    tail = (1 - confidence) / 2
+    return medians[int(tail * len(medians))], medians[int((1 - tail) * len(medians)) - 1]
+
+
+def current_rss() -> int:
+    """Resident set size of this process in bytes, 0 where /proc is unavailable"""
+    try:
+        with open("/proc/self/statm") as f:
+            return int(f.read().split()[1]) * os.sysconf("SC_PAGE_SIZE")
+    except (OSError, ValueError, AttributeError):
+        return 0
+
+
+def reset_peak_rss() -> bool:
+    """Restart the kernel's RSS high-water mark (Linux), so peak_rss() covers only what follows"""
+    try:
+        with open("/proc/self/clear_refs", "w") as f:
+            f.write("5")
+        return True
+    except OSError:
+        return False
+
+
+def peak_rss() -> int:
+    """Peak resident set size of this process in bytes, since the last reset_peak_rss()"""
+    try:
+        with open("/proc/self/status") as f:
+            for line in f:
+                if line.startswith("VmHWM:"):
+                    return int(line.split()[1]) * 1024
+    except (OSError, ValueError):
+        pass
+    try:
+        import resource
+    except ImportError:
+        return 0
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # Linux reports KiB, macOS bytes
+    return peak if sys.platform == "darwin" else peak * 1024
+
+
+def machine_info() -> dict:
+    """What a baseline was measured on, to warn when comparing across machines"""
+    cpu = platform.processor()
+    try:
+        with open("/proc/cpuinfo") as f:
+            cpu = next(line.split(":", 1)[1].strip() for line in f if line.startswith("model name"))
+    except (OSError, StopIteration):
+        pass
+    return {"cpu": cpu, "cores": os.cpu_count(), "python": platform.python_version(),
+            "native_isa": os.environ.get("NATIVE_ISA", "auto")}
+
+
+def measure(case: Case, threads: int, repeat: int, warmup: int) -> Result:
+    """Time a case in this process; run by the worker with OMP_NUM_THREADS set"""
+    idle_peak = peak_rss()
+    for _ in range(warmup):
+        case.run(case.setup(threads))
+    # Growth is the timed runs' peak above the RSS they start from. Without a
+    # resettable high-water mark only the lifetime peak is visible, so compare it
+    # with the idle worker's instead and let warm-up count too
+    rss_before = current_rss() if reset_peak_rss() else 0
+    if not rss_before:
+        rss_before = idle_peak
+    samples = []
+    for _ in range(repeat):
+        state = case.setup(threads)
+        start = time.perf_counter()
+        units = case.run(state)
+        elapsed = time.perf_counter() - start
+        samples.append(units / elapsed)
+        del state
+    peak = peak_rss()
+    return Result(case.name, case.unit, threads, samples, peak, max(0, peak - rss_before))
+
+
+def run_in_worker(name: str, threads: int, repeat: int, warmup: int) -> Result:
+    """Measure one case in a fresh interpreter.
+
+    OpenMP sizes its thread pool once per process, so every thread count
+    gets its own; the worker's peak RSS is then the case's alone.
+    """
+    env = dict(os.environ, OMP_NUM_THREADS=str(threads))
+    cmd = [sys.executable, "-m", "benchmarks", "--worker", name, "--threads", str(threads),
+           "--repeat", str(repeat), "--warmup", str(warmup)]
+    proc = subprocess.run(cmd, cwd=ROOT, env=env, capture_output=True, text=True)
+    if proc.returncode != 0:
+        raise RuntimeError(f"{name} with {threads} threads failed:\n{proc.stderr.strip()}")
+    return Result.from_json(json.loads(proc.stdout.strip().splitlines()[-1]))
+
+
+def save_baseline(path: str, results: List[Result]) -> None:
+    """Store results, replacing the file atomically"""
+    data = {"machine": machine_info(), "results": [r.to_json() for r in results]}
+    tmp = f"{path}.tmp"
+    with open(tmp, "w") as f:
+        json.dump(data, f, indent=1)
+    os.replace(tmp, path)
+
+
+def load_baseline(path: str) -> tuple:
+    """Return (machine info, results by key) of a stored baseline"""
+    with open(path) as f:
+        data = json.load(f)
+    results = [Result.from_json(r) for r in data["results"]]
+    return data.get("machine", {}), {r.key: r for r in results}
+
+
+@dataclass
+class Comparison:
+    """Change of one result against its baseline"""
+    current: Result
+    baseline: Optional[Result]
+    change: float = 0.0
+    status: str = "new"
+
+
+def compare(results: List[Result], baseline: Dict[str, Result], threshold: float) -> List[Comparison]:
+    """Classify each result against the baseline.
+
+    A case regresses when its median throughput dropped by more than
+    threshold and the confidence intervals of the two medians do not
+    overlap; a larger drop inside the noise is reported as 'noisy' so a
+    flaky run does not fail the suite, and should be rerun.
+    """
+    comparisons = []
+    for result in results:
+        base = baseline.get(result.key)
+        if base is None:
+            comparisons.append(Comparison(result, None))
+            continue
+        change = result.median / base.median - 1
+        separated = result.ci_high < base.ci_low or result.ci_low > base.ci_high
+        if change < -threshold:
+            status = "REGRESSION" if separated else "noisy"
+        elif change > threshold and separated:
+            status = "improved"
+        else:
+            status = "ok"
+        comparisons.append(Comparison(result, base, change, status))
+    return comparisons
+
+
+def format_rate(value: float) -> str:
+    for scale, prefix in ((1e9, "G"), (1e6, "M"), (1e3, "k")):
+        if value >= scale:
+            return f"{value / scale:.2f} {prefix}"
+    return f"{value:.2f} "
+
+
+def format_bytes(value: int) -> str:
+    return f"{value / (1 << 20):.1f} MiB"
@@ -6,8 +6,17 @@ import os
 import sys
 import time
 import ctypes
-from ctypes import Structure, c_uint32, c_double
-from typing import Tuple
+from ctypes import Structure, c_bool, c_char_p, c_uint32, c_uint64, c_double, c_size_t, c_int, c_void_p
+from typing import Optional, Tuple
+import numpy as np
+import numpy.ctypeslib as npct
+
+try:
+    import native_build
+except ImportError:
+    # Running from a checkout: the build helper sits at the repository root
+    sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+    import native_build
 
 class EggDropResult(Structure):
     """Mirror of the C structure for results"""
@@ -18,21 +27,79 @@ class EggDropResult(Structure):
         ("execution_time_ns", c_double)
     ]
 
+class EggDropResult64(Structure):
+    """Mirror of the C structure for 64-bit results"""
+    _fields_ = [
+        ("breaking_floor", c_uint64),
+        ("drops_used", c_uint64),
+        ("optimal_drops", c_uint64),
+        ("execution_time_ns", c_double)
+    ]
+
+class KEggResult(Structure):
+    """Mirror of the C structure for k-egg results"""
+    _fields_ = [
+        ("breaking_floor", c_uint64),
+        ("drops_used", c_uint64),
+        ("optimal_drops", c_uint64),
+        ("eggs_broken", c_uint32)
+    ]
+
+class EggDropSweepStats(Structure):
+    """Mirror of the C structure for sweep statistics"""
+    _fields_ = [
+        ("queries", c_uint64),
+        ("total_drops", c_uint64),
+        ("max_drops", c_uint64),
+        ("worst_total_floors", c_uint64),
+        ("worst_breaking_floor", c_uint64),
+        ("at_optimal", c_uint64),
+        ("over_optimal", c_uint64),
+        ("mean_drops", c_double)
+    ]
+
+class EggDropStats(Structure):
+    """Mirror of the C structure for the hot-path counters"""
+    _fields_ = [
+        ("calls", c_uint64),
+        ("queries", c_uint64),
+        ("plan_cache_hits", c_uint64),
+        ("plan_cache_misses", c_uint64),
+        ("allocations", c_uint64),
+        ("allocated_bytes", c_uint64),
+        ("setup_cycles", c_uint64),
+        ("kernel_cycles", c_uint64),
+        ("threads", c_uint32),
+        ("ns_per_cycle", c_double)
+    ]
+
+# numpy view of EggDropResult so batch results can be filled in place
+EGG_DROP_RESULT_DTYPE = np.dtype([
+    ("breaking_floor", np.uint32),
+    ("drops_used", np.uint32),
+    ("optimal_drops", np.uint32),
+    ("execution_time_ns", np.float64)
+], align=True)
+assert EGG_DROP_RESULT_DTYPE.itemsize == ctypes.sizeof(EggDropResult)
+
+EGG_DROP_RESULT64_DTYPE = np.dtype([
+    ("breaking_floor", np.uint64),
+    ("drops_used", np.uint64),
+    ("optimal_drops", np.uint64),
+    ("execution_time_ns", np.float64)
+], align=True)
+assert EGG_DROP_RESULT64_DTYPE.itemsize == ctypes.sizeof(EggDropResult64)
+
+# get_drop_points64 refuses to return more points (8 MB) unless asked to
+MAX_DROP_POINTS64 = 1 << 20
+
 def load_egg_drop_lib() -> ctypes.CDLL:
     """Load the compiled C library"""
     # Get the directory of this script
     script_dir = os.path.dirname(os.path.abspath(__file__))
     
-    # Set the correct library name based on platform
-    if sys.platform == 'win32':
-        lib_path = os.path.join(script_dir, 'egg_drop_lib.dll')
-        # Compile the library if it doesn't exist
-        if not os.path.exists(lib_path):
-            os.system(f'gcc -O3 -shared -o "{lib_path}" "{os.path.join(script_dir, "egg_drop_lib.c")}" -lm')
-    else:
-        lib_path = os.path.join(script_dir, 'egg_drop_lib.so')
-        if not os.path.exists(lib_path):
-            os.system(f'gcc -O3 -fPIC -shared -o "{lib_path}" "{os.path.join(script_dir, "egg_drop_lib.c")}" -lm')
+    # Best current build for this CPU, compiling the baseline if needed
+    lib_path = native_build.native_lib_path(script_dir, "egg_drop_lib")
     
     try:
         lib = ctypes.CDLL(lib_path)
@@ -46,16 +113,221 @@ def load_egg_drop_lib() -> ctypes.CDLL:
     lib.get_optimal_drops.argtypes = [c_uint32]
     lib.get_optimal_drops.restype = c_uint32
     
+    array_1d_uint32 = npct.ndpointer(dtype=np.uint32, ndim=1, flags='CONTIGUOUS')
+    array_1d_result = npct.ndpointer(dtype=EGG_DROP_RESULT_DTYPE, ndim=1, flags='CONTIGUOUS')
+    
+    lib.find_breaking_points.argtypes = [
+        array_1d_uint32,       # breaking_floors
+        array_1d_uint32,       # total_floors
+        c_size_t,              # count
+        array_1d_result        # results_out
+    ]
+    lib.find_breaking_points.restype = c_int
+    
+    lib.find_breaking_point_closed_form.argtypes = [c_uint32, c_uint32]
+    lib.find_breaking_point_closed_form.restype = EggDropResult
+    
+    lib.find_breaking_points_closed_form.argtypes = lib.find_breaking_points.argtypes
+    lib.find_breaking_points_closed_form.restype = c_int
+    
+    # Drop plans are opaque handles owned by the C library
+    lib.create_drop_plan.argtypes = [c_uint32]
+    lib.create_drop_plan.restype = c_void_p
+    
+    lib.acquire_drop_plan.argtypes = [c_uint32]
+    lib.acquire_drop_plan.restype = c_void_p
+    
+    lib.query_drop_plan.argtypes = [c_void_p, c_uint32]
+    lib.query_drop_plan.restype = EggDropResult
+    
+    lib.destroy_drop_plan.argtypes = [c_void_p]
+    lib.destroy_drop_plan.restype = None
+    
+    lib.set_plan_cache_capacity.argtypes = [c_uint32]
+    lib.set_plan_cache_capacity.restype = c_int
+    
+    lib.get_plan_cache_capacity.argtypes = []
+    lib.get_plan_cache_capacity.restype = c_uint32
+    
+    lib.set_timing_enabled.argtypes = [c_bool]
+    lib.set_timing_enabled.restype = c_int
+    
+    lib.get_timing_enabled.argtypes = []
+    lib.get_timing_enabled.restype = c_bool
+    
+    lib.set_stats_enabled.argtypes = [c_bool]
+    lib.set_stats_enabled.restype = c_int
+    
+    lib.get_stats_enabled.argtypes = []
+    lib.get_stats_enabled.restype = c_bool
+    
+    lib.get_stats.argtypes = [ctypes.POINTER(EggDropStats)]
+    lib.get_stats.restype = c_int
+    
+    lib.reset_stats.argtypes = []
+    lib.reset_stats.restype = None
+    
+    lib.sweep_breaking_points.argtypes = [
+        c_uint32,                                # min_floors
+        c_uint32,                                # max_floors
+        c_int,                                   # num_threads
+        ctypes.POINTER(EggDropSweepStats),       # stats_out
+        npct.ndpointer(dtype=np.uint64, ndim=1, flags='CONTIGUOUS,WRITEABLE'),  # histogram
+        c_uint32                                 # num_bins
+    ]
+    lib.sweep_breaking_points.restype = c_int
+    
+    lib.get_simd_kernel.argtypes = []
+    lib.get_simd_kernel.restype = c_char_p
+    
+    lib.set_simd_kernel.argtypes = [c_char_p]
+    lib.set_simd_kernel.restype = c_int
+    
+    # 64-bit towers
+    array_1d_uint64 = npct.ndpointer(dtype=np.uint64, ndim=1, flags='CONTIGUOUS')
+    array_1d_result64 = npct.ndpointer(dtype=EGG_DROP_RESULT64_DTYPE, ndim=1, flags='CONTIGUOUS')
+    
+    lib.find_breaking_point64.argtypes = [c_uint64, c_uint64]
+    lib.find_breaking_point64.restype = EggDropResult64
+    
+    lib.find_breaking_points64.argtypes = [
+        array_1d_uint64,       # breaking_floors
+        array_1d_uint64,       # total_floors
+        c_size_t,              # count
+        array_1d_result64      # results_out
+    ]
+    lib.find_breaking_points64.restype = c_int
+    
+    lib.get_optimal_drops64.argtypes = [c_uint64]
+    lib.get_optimal_drops64.restype = c_uint64
+    
+    lib.get_drop_points64.argtypes = [c_uint64, npct.ndpointer(dtype=np.uint64, ndim=1, flags='CONTIGUOUS,WRITEABLE'), c_uint64]
+    lib.get_drop_points64.restype = c_uint64
+    
+    # General k-egg engine
+    
+    lib.get_min_drops_k_eggs.argtypes = [c_uint32, c_uint64]
+    lib.get_min_drops_k_eggs.restype = c_uint64
+    
+    lib.get_min_drops_k_eggs_batch.argtypes = [
+        array_1d_uint32,       # eggs
+        array_1d_uint64,       # total_floors
+        c_size_t,              # count
+        array_1d_uint64        # drops_out
+    ]
+    lib.get_min_drops_k_eggs_batch.restype = c_int
+    
+    lib.create_k_egg_plan.argtypes = [c_uint32, c_uint64]
+    lib.create_k_egg_plan.restype = c_void_p
+    
+    lib.k_egg_plan_next_floor.argtypes = [c_void_p, c_uint64, c_uint64, c_uint64, c_uint32]
+    lib.k_egg_plan_next_floor.restype = c_uint64
+    
+    lib.query_k_egg_plan.argtypes = [c_void_p, c_uint64]
+    lib.query_k_egg_plan.restype = KEggResult
+    
+    lib.destroy_k_egg_plan.argtypes = [c_void_p]
+    lib.destroy_k_egg_plan.restype = None
+    
     return lib
 
+class DropPlan:
+    """Precomputed drop schedule for one building height, backed by the C library"""
+    def __init__(self, lib: ctypes.CDLL, total_floors: int, shared: bool = True):
+        self._lib = lib
+        self.total_floors = total_floors
+        create = lib.acquire_drop_plan if shared else lib.create_drop_plan
+        self._handle = create(total_floors)
+        if not self._handle:
+            raise MemoryError(f"Failed to create drop plan for {total_floors} floors")
+    
+    def query(self, breaking_floor: int) -> Tuple[int, int, int, float]:
+        """Find the breaking point using this plan"""
+        if not self._handle:
+            raise ValueError("Drop plan has been closed")
+        result = self._lib.query_drop_plan(self._handle, breaking_floor)
+        return (
+            result.breaking_floor,
+            result.drops_used,
+            result.optimal_drops,
+            result.execution_time_ns
+        )
+    
+    def close(self) -> None:
+        """Release the plan handle"""
+        if self._handle:
+            self._lib.destroy_drop_plan(self._handle)
+            self._handle = None
+    
+    def __enter__(self) -> "DropPlan":
+        return self
+    
+    def __exit__(self, *exc) -> None:
+        self.close()
+    
+    def __del__(self):
+        self.close()
+
+class KEggPlan:
+    """Executable drop schedule for k eggs and n floors, backed by the C library"""
+    def __init__(self, lib: ctypes.CDLL, eggs: int, total_floors: int):
+        self._lib = lib
+        self.eggs = eggs
+        self.total_floors = total_floors
+        self._handle = lib.create_k_egg_plan(eggs, total_floors)
+        if not self._handle:
+            raise ValueError(f"Cannot build a schedule for {eggs} eggs and {total_floors} floors")
+    
+    def next_floor(self, safe_floor: int, top_floor: int, drops_left: int, eggs_left: int) -> int:
+        """Floor to drop from next, given what is known so far (0 when resolved)"""
+        if not self._handle:
+            raise ValueError("K-egg plan has been closed")
+        return self._lib.k_egg_plan_next_floor(self._handle, safe_floor, top_floor, drops_left, eggs_left)
+    
+    def query(self, breaking_floor: int) -> Tuple[int, int, int, int]:
+        """Run the schedule against a breaking floor (total_floors + 1 for none)"""
+        if not self._handle:
+            raise ValueError("K-egg plan has been closed")
+        result = self._lib.query_k_egg_plan(self._handle, breaking_floor)
+        return (
+            result.breaking_floor,
+            result.drops_used,
+            result.optimal_drops,
+            result.eggs_broken
+        )
+    
+    def close(self) -> None:
+        """Free the schedule"""
+        if self._handle:
+            self._lib.destroy_k_egg_plan(self._handle)
+            self._handle = None
+    
+    def __enter__(self) -> "KEggPlan":
+        return self
+    
+    def __exit__(self, *exc) -> None:
+        self.close()
+    
+    def __del__(self):
+        self.close()
+
 class HybridEggDropSolver:
     """Python wrapper for the C implementation"""
     def __init__(self):
         self.lib = load_egg_drop_lib()
     
-    def find_breaking_point(self, breaking_floor: int, total_floors: int) -> Tuple[int, int, int, float]:
-        """Find the breaking point using the C implementation"""
-        result = self.lib.find_breaking_point(breaking_floor, total_floors)
+    def find_breaking_point(self, breaking_floor: int, total_floors: int,
+                            closed_form: bool = False) -> Tuple[int, int, int, float]:
+        """
+        Find the breaking point using the C implementation.
+        
+        With closed_form=True the interval is found arithmetically instead of
+        searching the drop points; drops_used is identical either way.
+        Threads may call this concurrently; for many queries on one height
+        from several threads, hold a plan from create_plan() instead.
+        """
+        find = self.lib.find_breaking_point_closed_form if closed_form else self.lib.find_breaking_point
+        result = find(breaking_floor, total_floors)
         return (
             result.breaking_floor,
             result.drops_used,
@@ -63,6 +335,201 @@ class HybridEggDropSolver:
             result.execution_time_ns
         )
     
+    def find_breaking_points(self, breaking_floors, total_floors, closed_form: bool = False) -> np.ndarray:
+        """
+        Find many breaking points with a single call into the C library.
+        
+        Args:
+            breaking_floors: Array of breaking floors
+            total_floors: Array of building heights, or a single height for all queries
+            closed_form: Use the arithmetic interval lookup instead of the drop plans
+            
+        Returns:
+            Structured array with EGG_DROP_RESULT_DTYPE fields, one entry per query
+        """
+        breaking = np.ascontiguousarray(breaking_floors, dtype=np.uint32).ravel()
+        total = np.ascontiguousarray(np.broadcast_to(total_floors, breaking.shape), dtype=np.uint32)
+        results = np.empty(len(breaking), dtype=EGG_DROP_RESULT_DTYPE)
+        
+        find = self.lib.find_breaking_points_closed_form if closed_form else self.lib.find_breaking_points
+        if find(breaking, total, len(breaking), results) != 0:
+            raise RuntimeError("Failed to find breaking points")
+        return results
+    
+    def sweep(self, min_floors: int, max_floors: int, num_bins: int = 0,
+              threads: int = 0) -> Tuple[dict, np.ndarray]:
+        """
+        Simulate every breaking floor of every height in [min_floors, max_floors].
+        
+        Runs entirely in C without materializing per-query results.
+        
+        Args:
+            min_floors: Lowest building height
+            max_floors: Highest building height
+            num_bins: Histogram bins for the drop counts; the last bin also
+                counts all larger drop counts
+            threads: Worker threads, 0 for the OpenMP default
+            
+        Returns:
+            (statistics dict, uint64 histogram array of num_bins entries)
+        """
+        stats = EggDropSweepStats()
+        histogram = np.zeros(max(num_bins, 1), dtype=np.uint64)
+        if self.lib.sweep_breaking_points(min_floors, max_floors, threads, ctypes.byref(stats),
+                                          histogram, num_bins) != 0:
+            raise ValueError(f"Invalid sweep range: {min_floors}..{max_floors}")
+        return {name: getattr(stats, name) for name, _ in EggDropSweepStats._fields_}, histogram[:num_bins]
+    
+    def create_plan(self, total_floors: int, shared: bool = True) -> DropPlan:
+        """
+        Create a reusable drop plan for one building height.
+        
+        Shared plans come from the library's LRU plan cache; unshared plans
+        are private to the caller.
+        """
+        return DropPlan(self.lib, total_floors, shared)
+    
+    def set_plan_cache_capacity(self, capacity: int) -> None:
+        """Set how many building heights the C plan cache keeps (0 disables it)"""
+        if self.lib.set_plan_cache_capacity(capacity) != 0:
+            raise ValueError(f"Invalid plan cache capacity: {capacity}")
+    
+    def set_timing_enabled(self, enabled: bool) -> None:
+        """
+        Turn execution time measurement in the C library on or off.
+        
+        Timing is off by default and results report 0 ns. Batched calls
+        report the per-query average of the whole batch.
+        """
+        if self.lib.set_timing_enabled(enabled) != 0:
+            raise RuntimeError("C library was built without timing support")
+    
+    def get_timing_enabled(self) -> bool:
+        """Check whether the C library measures execution times"""
+        return self.lib.get_timing_enabled()
+    
+    def set_stats_enabled(self, enabled: bool) -> None:
+        """
+        Turn the C library's hot-path counters on or off.
+        
+        Stats are off by default; while off, each query pays one branch.
+        """
+        if self.lib.set_stats_enabled(enabled) != 0:
+            raise RuntimeError("C library was built without stats support")
+    
+    def get_stats_enabled(self) -> bool:
+        """Check whether the C library counts hot-path stats"""
+        return self.lib.get_stats_enabled()
+    
+    def get_stats(self) -> dict:
+        """
+        Hot-path counters summed over every thread: calls, queries, plan
+        cache hits and misses, plan allocations, and the cycles spent on
+        plan setup and on simulating drops, also converted to nanoseconds.
+        """
+        stats = EggDropStats()
+        if self.lib.get_stats(ctypes.byref(stats)) != 0:
+            raise RuntimeError("Failed to read egg drop stats")
+        result = {name: getattr(stats, name) for name, _ in EggDropStats._fields_}
+        result["setup_ns"] = stats.setup_cycles * stats.ns_per_cycle
+        result["kernel_ns"] = stats.kernel_cycles * stats.ns_per_cycle
+        return result
+    
+    def reset_stats(self) -> None:
+        """Zero the C library's hot-path counters"""
+        self.lib.reset_stats()
+    
+    def get_simd_kernel(self) -> str:
+        """Name of the vector kernel used by batched closed-form queries"""
+        return self.lib.get_simd_kernel().decode()
+    
+    def set_simd_kernel(self, name: Optional[str] = None) -> None:
+        """
+        Force the batched closed-form kernel ("avx512", "avx2", "neon" or
+        "scalar"); None restores the best kernel for this CPU.
+        """
+        if self.lib.set_simd_kernel(name.encode() if name is not None else None) != 0:
+            raise ValueError(f"SIMD kernel not available on this CPU: {name}")
+    
+    def find_breaking_point64(self, breaking_floor: int, total_floors: int) -> Tuple[int, int, int, float]:
+        """Find the breaking point in towers above 4G floors (64-bit C path)"""
+        result = self.lib.find_breaking_point64(breaking_floor, total_floors)
+        return (
+            result.breaking_floor,
+            result.drops_used,
+            result.optimal_drops,
+            result.execution_time_ns
+        )
+    
+    def find_breaking_points64(self, breaking_floors, total_floors) -> np.ndarray:
+        """Batched find_breaking_point64; returns an EGG_DROP_RESULT64_DTYPE array"""
+        breaking = np.ascontiguousarray(breaking_floors, dtype=np.uint64).ravel()
+        total = np.ascontiguousarray(np.broadcast_to(total_floors, breaking.shape), dtype=np.uint64)
+        results = np.empty(len(breaking), dtype=EGG_DROP_RESULT64_DTYPE)
+        
+        if self.lib.find_breaking_points64(breaking, total, len(breaking), results) != 0:
+            raise RuntimeError("Failed to find breaking points")
+        return results
+    
+    def get_optimal_drops64(self, total_floors: int) -> int:
+        """Get optimal number of drops for towers above 4G floors"""
+        return self.lib.get_optimal_drops64(total_floors)
+    
+    def get_drop_points64(self, total_floors: int, max_points: Optional[int] = None) -> np.ndarray:
+        """
+        First egg drop points without the 1000-point cap of the 32-bit path.
+        
+        A tower of n floors has about sqrt(2n) points, so the full list runs
+        to gigabytes near the 64-bit limit.
+        
+        Args:
+            total_floors: Number of floors in the tower
+            max_points: Return at most this many points. By default all of
+                them are returned, but only up to MAX_DROP_POINTS64; pass
+                max_points explicitly to go beyond that.
+            
+        Raises:
+            ValueError: max_points is None and the tower has more than
+                MAX_DROP_POINTS64 points
+        """
+        num_points = self.lib.get_drop_points64(total_floors, np.empty(0, dtype=np.uint64), 0)
+        if max_points is None:
+            if num_points > MAX_DROP_POINTS64:
+                raise ValueError(f"{total_floors} floors have {num_points} drop points, more than "
+                                 f"MAX_DROP_POINTS64 = {MAX_DROP_POINTS64}; pass max_points to get them")
+        else:
+            num_points = min(num_points, max_points)
+        points = np.empty(num_points, dtype=np.uint64)
+        self.lib.get_drop_points64(total_floors, points, num_points)
+        return points
+    
+    def get_min_drops(self, eggs: int, total_floors: int) -> int:
+        """Minimal worst-case drops for any number of eggs"""
+        return self.lib.get_min_drops_k_eggs(eggs, total_floors)
+    
+    def get_min_drops_batch(self, eggs, total_floors) -> np.ndarray:
+        """
+        Minimal worst-case drops for many (eggs, floors) pairs in one call.
+        
+        Args:
+            eggs: Array of egg counts, or a single count for all queries
+            total_floors: Array of building heights
+            
+        Returns:
+            uint64 array of minimal drops
+        """
+        floors = np.ascontiguousarray(total_floors, dtype=np.uint64).ravel()
+        egg_counts = np.ascontiguousarray(np.broadcast_to(eggs, floors.shape), dtype=np.uint32)
+        drops = np.empty(len(floors), dtype=np.uint64)
+        
+        if self.lib.get_min_drops_k_eggs_batch(egg_counts, floors, len(floors), drops) != 0:
+            raise RuntimeError("Failed to compute minimal drops")
+        return drops
+    
+    def create_k_egg_plan(self, eggs: int, total_floors: int) -> KEggPlan:
+        """Build an executable drop schedule for k eggs"""
+        return KEggPlan(self.lib, eggs=eggs, total_floors=total_floors)
+    
     def get_optimal_drops(self, total_floors: int) -> int:
         """Get optimal number of drops needed"""
         return self.lib.get_optimal_drops(total_floors)
@@ -73,8 +540,10 @@ def benchmark_hybrid():
     print("-" * 40)
     
     solver = HybridEggDropSolver()
+    solver.set_timing_enabled(True)
     buildings = [100, 1000, 10000, 100000, 1000000]
     iterations = 10000
+    batch_size = 100
     
     total_time_ns = 0.0
     total_drops = 0
@@ -82,9 +551,12 @@ def benchmark_hybrid():
     for floors in buildings:
         breaking_floor = floors // 2  # Test middle floor
         
+        # Single calls are dominated by ctypes overhead and timer resolution,
+        # so time batches in C and take the per-query average of each
+        breaking = np.full(batch_size, breaking_floor, dtype=np.uint32)
+        
         # Warm-up runs
-        for _ in range(100):
-            solver.find_breaking_point(breaking_floor, floors)
+        solver.find_breaking_points(breaking, floors)
         
         min_time_ns = float('inf')
         max_time_ns = 0
@@ -92,15 +564,17 @@ def benchmark_hybrid():
         total_iter_drops = 0
         
         # Benchmark runs
-        for _ in range(iterations):
-            _, drops, optimal, time_ns = solver.find_breaking_point(breaking_floor, floors)
-            total_iter_drops += drops
+        for _ in range(iterations // batch_size):
+            results = solver.find_breaking_points(breaking, floors)
+            total_iter_drops += int(results['drops_used'].sum())
+            optimal = int(results['optimal_drops'][0])
+            time_ns = float(results['execution_time_ns'][0])
             
             min_time_ns = min(min_time_ns, time_ns)
             max_time_ns = max(max_time_ns, time_ns)
             avg_time_ns += time_ns
         
-        avg_time_ns /= iterations
+        avg_time_ns /= iterations // batch_size
         total_time_ns += avg_time_ns
         total_drops += total_iter_drops
         
@@ -122,6 +596,7 @@ def demonstrate_hybrid():
     print("-" * 50)
     
     solver = HybridEggDropSolver()
+    solver.set_timing_enabled(True)
     test_cases = [
         (100, 50),     # 100-floor building, breaking at 50
         (1000, 500),   # 1000-floor building, breaking at 500
@@ -1,12 +1,24 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
 #include <time.h>
 #include <stdint.h>
 #include <stdbool.h>
 #ifdef _WIN32
 #include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
 #endif
 
 #ifdef _WIN32
@@ -15,6 +27,32 @@
 #define EXPORT
 #endif
 
+#define MAX_DROP_POINTS 1000           // First egg drop points kept per plan
+#define PLAN_CACHE_MAX_ENTRIES 256     // Upper bound for the plan cache capacity
+#define PLAN_CACHE_DEFAULT_ENTRIES 16  // Plan cache capacity at load time
+#define MAX_FLOORS64 18446744070963499500ULL  // T(MAX_OPTIMAL_DROPS64), last triangular below 2^64
+#define MAX_OPTIMAL_DROPS64 6074000999ULL     // Largest k whose k(k+1)/2 fits in 64 bits
+#define K_EGG_MAX_EGGS 64              // More eggs never help below 2^64 floors
+#define K_EGG_MAX_TABLE_ENTRIES (1u << 24)  // Coverage table cap per k-egg plan (128 MiB)
+#define TIMING_CALIBRATION_NS 2000000  // Cycle counter calibration window at load
+#define SWEEP_CHUNK_HEIGHTS 256        // Heights a sweep thread takes at a time
+#define STATS_MAX_THREADS 256          // Threads with their own stats slot; later ones share the last
+
+// Build with -DEGG_DROP_TIMING=0 to compile all timing out of the library
+#ifndef EGG_DROP_TIMING
+#define EGG_DROP_TIMING 1
+#endif
+
+// Build with -DEGG_DROP_STATS=0 to compile the hot-path counters out
+#ifndef EGG_DROP_STATS
+#define EGG_DROP_STATS 1
+#endif
+
+// Build with -DEGG_DROP_SIMD=0 to use only the portable batch kernel
+#ifndef EGG_DROP_SIMD
+#define EGG_DROP_SIMD 1
+#endif
+
 /**
  * Structure to hold egg drop simulation results
  */
@@ -27,16 +65,186 @@ typedef struct
 } EggDropResult;
 
 /**
- * Get current time in nanoseconds
+ * 64-bit variant of EggDropResult for towers above 4G floors
+ */
+typedef struct
+{
+  uint64_t breaking_floor;    // The floor where egg breaks
+  uint64_t drops_used;        // Number of drops used
+  uint64_t optimal_drops;     // Theoretical optimal drops
+  double execution_time_ns;   // Time taken in nanoseconds
+} EggDropResult64;
+
+/**
+ * Aggregate statistics of a sweep over many (height, floor) queries
+ */
+typedef struct
+{
+  uint64_t queries;               // Queries simulated
+  uint64_t total_drops;           // Sum of drops used
+  uint64_t max_drops;             // Most drops any query used
+  uint64_t worst_total_floors;    // Lowest height where max_drops occurs
+  uint64_t worst_breaking_floor;  // First breaking floor there that needs max_drops
+  uint64_t at_optimal;            // Queries using exactly the optimal drops
+  uint64_t over_optimal;          // Queries using more than the optimal drops
+  double mean_drops;              // Average drops per query
+} EggDropSweepStats;
+
+/**
+ * Hot-path counters summed over every thread, see get_stats()
+ */
+typedef struct
+{
+  uint64_t calls;             // Instrumented calls
+  uint64_t queries;           // Breaking floors simulated
+  uint64_t plan_cache_hits;   // Plan lookups served by the cache
+  uint64_t plan_cache_misses; // Plan lookups that had to build a plan
+  uint64_t allocations;       // Plans allocated
+  uint64_t allocated_bytes;   // Their total size
+  uint64_t setup_cycles;      // Cycles spent finding or building plans
+  uint64_t kernel_cycles;     // Cycles spent simulating drops
+  uint32_t threads;           // Threads that have recorded stats
+  double ns_per_cycle;        // Cycle counter period, to convert the cycle counts
+} EggDropStats;
+
+/**
+ * Precomputed drop schedule for one building height.
+ * Read-only once created, so it can be queried from any number of threads.
+ */
+typedef struct
+{
+  uint32_t total_floors;      // Building height the plan was built for
+  uint32_t optimal_drops;     // Theoretical optimal drops
+  uint32_t num_points;        // Number of first egg drop points
+  uint32_t ref_count;         // Handles held by callers and the plan cache (atomic)
+  uint32_t drop_points[];     // First egg drop points (num_points entries)
+} EggDropPlan;
+
+/**
+ * Structure to hold k-egg simulation results
+ */
+typedef struct
+{
+  uint64_t breaking_floor;    // The floor where egg breaks (total_floors + 1 if none)
+  uint64_t drops_used;        // Number of drops used
+  uint64_t optimal_drops;     // Minimal worst-case drops for the plan
+  uint32_t eggs_broken;       // Eggs broken along the way
+} KEggResult;
+
+/**
+ * Drop schedule for k eggs and n floors.
+ *
+ * coverage holds f(d, e), the floors coverable with d drops and e eggs,
+ * for d < max_drops and 2 <= e < eggs; f(d, 0) = 0 and f(d, 1) = d are
+ * implicit. That is all the schedule ever looks up, so the table is
+ * O(k*d) instead of the O(k*n) textbook DP.
+ */
+typedef struct
+{
+  uint64_t total_floors;      // Building height the plan was built for
+  uint64_t max_drops;         // Minimal worst-case drops
+  uint32_t eggs;              // Eggs the schedule uses (never more than helps)
+  uint32_t table_columns;     // Columns per coverage row (eggs - 2, or 0)
+  uint64_t coverage[];        // Row-major f(d, e), max_drops x table_columns
+} KEggPlan;
+
+/**
+ * Slot of the process-wide plan cache
+ */
+typedef struct
+{
+  EggDropPlan* plan;          // Cached plan, NULL if slot is free
+  uint64_t last_used;         // Cache clock value of the last lookup (atomic)
+} PlanCacheEntry;
+
+static PlanCacheEntry plan_cache[PLAN_CACHE_MAX_ENTRIES];
+static uint32_t plan_cache_capacity = PLAN_CACHE_DEFAULT_ENTRIES;
+static uint64_t plan_cache_clock = 0;
+
+#ifdef _WIN32
+static SRWLOCK plan_cache_lock = SRWLOCK_INIT;
+#else
+static pthread_rwlock_t plan_cache_lock = PTHREAD_RWLOCK_INITIALIZER;
+#endif
+
+// Relaxed 64-bit atomics, and reference counts that publish the plan they guard
+#if defined(_MSC_VER)
+#define atomic_add64(p, v) ((uint64_t)InterlockedExchangeAdd64((volatile LONG64*)(p), (LONG64)(v)))
+#define atomic_load64(p) ((uint64_t)InterlockedOr64((volatile LONG64*)(p), 0))
+#define atomic_store64(p, v) InterlockedExchange64((volatile LONG64*)(p), (LONG64)(v))
+#define ref_acquire(p) ((uint32_t)InterlockedIncrement((volatile LONG*)(p)))
+#define ref_release(p) ((uint32_t)InterlockedDecrement((volatile LONG*)(p)))
+#else
+#define atomic_add64(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define atomic_load64(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define atomic_store64(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define ref_acquire(p) __atomic_add_fetch((p), 1, __ATOMIC_RELAXED)
+#define ref_release(p) __atomic_sub_fetch((p), 1, __ATOMIC_ACQ_REL)
+#endif
+
+/**
+ * Lock the plan cache for changing its slots
+ */
+static inline void lock_plan_cache(void)
+{
+#ifdef _WIN32
+  AcquireSRWLockExclusive(&plan_cache_lock);
+#else
+  pthread_rwlock_wrlock(&plan_cache_lock);
+#endif
+}
+
+/**
+ * Unlock the plan cache after lock_plan_cache()
+ */
+static inline void unlock_plan_cache(void)
+{
+#ifdef _WIN32
+  ReleaseSRWLockExclusive(&plan_cache_lock);
+#else
+  pthread_rwlock_unlock(&plan_cache_lock);
+#endif
+}
+
+/**
+ * Lock the plan cache for lookups, which may run concurrently
+ */
+static inline void lock_plan_cache_shared(void)
+{
+#ifdef _WIN32
+  AcquireSRWLockShared(&plan_cache_lock);
+#else
+  pthread_rwlock_rdlock(&plan_cache_lock);
+#endif
+}
+
+/**
+ * Unlock the plan cache after lock_plan_cache_shared()
+ */
+static inline void unlock_plan_cache_shared(void)
+{
+#ifdef _WIN32
+  ReleaseSRWLockShared(&plan_cache_lock);
+#else
+  pthread_rwlock_unlock(&plan_cache_lock);
+#endif
+}
+
+#if EGG_DROP_TIMING || EGG_DROP_STATS
+
+static double ns_per_cycle = 0.0;
+
+/**
+ * Get current time in nanoseconds (only used to calibrate the cycle counter)
  */
-static inline int64_t get_time_ns(void)
+static int64_t get_time_ns(void)
 {
 #ifdef _WIN32
-  LARGE_INTEGER frequency;
-  LARGE_INTEGER start;
-  QueryPerformanceFrequency(&frequency);
-  QueryPerformanceCounter(&start);
-  return (int64_t)((start.QuadPart * 1000000000) / frequency.QuadPart);
+  static LARGE_INTEGER frequency;
+  LARGE_INTEGER now;
+  if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&now);
+  return (int64_t)((double)now.QuadPart * 1e9 / (double)frequency.QuadPart);
 #else
   struct timespec ts;
   clock_gettime(CLOCK_MONOTONIC, &ts);
@@ -44,12 +252,302 @@ static inline int64_t get_time_ns(void)
 #endif
 }
 
+/**
+ * Read the free-running cycle counter
+ */
+static inline uint64_t read_cycle_counter(void)
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t ticks;
+  __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+  return ticks;
+#else
+  return (uint64_t)get_time_ns();
+#endif
+}
+
+/**
+ * Measure the cycle counter against the monotonic clock, once per process
+ */
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void calibrate_cycle_counter(void)
+{
+  int64_t start_ns = get_time_ns();
+  uint64_t start_ticks = read_cycle_counter();
+  int64_t elapsed_ns;
+  do
+  {
+    elapsed_ns = get_time_ns() - start_ns;
+  } while (elapsed_ns < TIMING_CALIBRATION_NS);
+  uint64_t elapsed_ticks = read_cycle_counter() - start_ticks;
+  
+  ns_per_cycle = elapsed_ticks ? (double)elapsed_ns / (double)elapsed_ticks : 1.0;
+}
+
+#endif
+
+#if EGG_DROP_TIMING
+
+static bool timing_enabled = false;
+
+/**
+ * Start a timed region; returns 0 when timing is disabled
+ */
+static inline uint64_t timing_start(void)
+{
+  return timing_enabled ? read_cycle_counter() : 0;
+}
+
+/**
+ * Nanoseconds since timing_start(), or 0 if timing is disabled
+ */
+static inline double timing_elapsed_ns(uint64_t start)
+{
+  if (!timing_enabled || start == 0) return 0.0;
+  return (double)(read_cycle_counter() - start) * ns_per_cycle;
+}
+
+#else
+
+static inline uint64_t timing_start(void) { return 0; }
+static inline double timing_elapsed_ns(uint64_t start) { (void)start; return 0.0; }
+
+#endif
+
+// Hot-path statistics
+//
+// Opt-in counters for the query entry points. While disabled every
+// instrumented call pays one branch. Each calling thread claims its own
+// cache-line slot on first use and adds to it with relaxed atomics, so
+// counting never contends; the OpenMP workers of a sweep are counted by
+// the thread that called it.
+
+enum
+{
+  STAT_CALLS,
+  STAT_QUERIES,
+  STAT_PLAN_CACHE_HITS,
+  STAT_PLAN_CACHE_MISSES,
+  STAT_ALLOCATIONS,
+  STAT_ALLOCATED_BYTES,
+  STAT_SETUP_CYCLES,
+  STAT_KERNEL_CYCLES,
+  STAT_COUNT
+};
+
+#if EGG_DROP_STATS
+
+#if defined(_MSC_VER)
+#define STATS_THREAD_LOCAL __declspec(thread)
+#define STATS_ALIGN __declspec(align(64))
+#else
+#define STATS_THREAD_LOCAL _Thread_local
+#define STATS_ALIGN __attribute__((aligned(64)))
+#endif
+
+/**
+ * Counters of one thread, padded to a cache line
+ */
+typedef struct STATS_ALIGN
+{
+  uint64_t counters[STAT_COUNT];
+} StatsSlot;
+
+static StatsSlot stats_slots[STATS_MAX_THREADS];
+static uint64_t stats_threads_claimed = 0;
+static STATS_THREAD_LOCAL StatsSlot* stats_slot = NULL;
+static bool stats_enabled = false;
+
+/**
+ * This thread's slot, claimed on first use
+ */
+static inline StatsSlot* stats_thread_slot(void)
+{
+  if (!stats_slot)
+  {
+    uint64_t index = atomic_add64(&stats_threads_claimed, 1);
+    stats_slot = &stats_slots[index < STATS_MAX_THREADS ? index : STATS_MAX_THREADS - 1];
+  }
+  return stats_slot;
+}
+
+/**
+ * Add to one of this thread's counters, if stats are enabled
+ */
+static inline void stats_add(int counter, uint64_t value)
+{
+  if (stats_enabled)
+  {
+    atomic_add64(&stats_thread_slot()->counters[counter], value);
+  }
+}
+
+/**
+ * Open a phase; returns 0 when stats are disabled
+ */
+static inline uint64_t stats_start(void)
+{
+  return stats_enabled ? read_cycle_counter() : 0;
+}
+
+/**
+ * This thread's running total of one counter, 0 when stats are disabled
+ */
+static inline uint64_t stats_thread_total(int counter)
+{
+  return stats_enabled ? atomic_load64(&stats_thread_slot()->counters[counter]) : 0;
+}
+
+/**
+ * Charge the cycles since start to counter and open the next phase
+ */
+static inline uint64_t stats_phase(uint64_t start, int counter)
+{
+  if (start == 0) return 0;
+  uint64_t now = read_cycle_counter();
+  atomic_add64(&stats_thread_slot()->counters[counter], now - start);
+  return now;
+}
+
+#else
+
+static inline void stats_add(int counter, uint64_t value) { (void)counter; (void)value; }
+static inline uint64_t stats_start(void) { return 0; }
+static inline uint64_t stats_thread_total(int counter) { (void)counter; return 0; }
+static inline uint64_t stats_phase(uint64_t start, int counter) { (void)start; (void)counter; return 0; }
+
+#endif
+
+/**
+ * Spread a batch's elapsed time evenly over its results
+ */
+static void record_batch_time(EggDropResult* results, size_t count, double elapsed_ns)
+{
+  if (elapsed_ns <= 0.0) return;
+  
+  double per_query_ns = elapsed_ns / (double)count;
+  for (size_t i = 0; i < count; i++)
+  {
+    results[i].execution_time_ns = per_query_ns;
+  }
+}
+
+/**
+ * 64-bit variant of record_batch_time
+ */
+static void record_batch_time64(EggDropResult64* results, size_t count, double elapsed_ns)
+{
+  if (elapsed_ns <= 0.0) return;
+  
+  double per_query_ns = elapsed_ns / (double)count;
+  for (size_t i = 0; i < count; i++)
+  {
+    results[i].execution_time_ns = per_query_ns;
+  }
+}
+
+/**
+ * Seeds for isqrt64: round(2^15 / sqrt((i + 64.5) / 256)), i.e. 1/sqrt(x)
+ * for the top byte of a normalized input
+ */
+static const uint16_t rsqrt_seed[192] = {
+  65281, 64781, 64292, 63814, 63347, 62889, 62442, 62004, 61575, 61154, 60742, 60339,
+  59943, 59555, 59175, 58801, 58435, 58075, 57722, 57376, 57035, 56700, 56372, 56049,
+  55731, 55419, 55112, 54810, 54513, 54221, 53933, 53650, 53371, 53097, 52826, 52560,
+  52298, 52040, 51785, 51535, 51288, 51044, 50804, 50567, 50333, 50103, 49876, 49652,
+  49430, 49212, 48997, 48784, 48574, 48367, 48163, 47961, 47761, 47564, 47370, 47178,
+  46988, 46800, 46615, 46432, 46251, 46072, 45895, 45720, 45547, 45376, 45207, 45040,
+  44875, 44711, 44550, 44390, 44232, 44075, 43920, 43767, 43615, 43465, 43316, 43169,
+  43024, 42879, 42737, 42595, 42456, 42317, 42180, 42044, 41910, 41776, 41644, 41514,
+  41384, 41256, 41129, 41003, 40878, 40754, 40631, 40510, 40390, 40270, 40152, 40035,
+  39919, 39803, 39689, 39576, 39464, 39352, 39242, 39133, 39024, 38916, 38810, 38704,
+  38599, 38494, 38391, 38289, 38187, 38086, 37986, 37887, 37788, 37690, 37593, 37497,
+  37401, 37307, 37213, 37119, 37027, 36935, 36843, 36753, 36663, 36573, 36485, 36397,
+  36309, 36222, 36136, 36051, 35966, 35882, 35798, 35715, 35632, 35550, 35469, 35388,
+  35307, 35228, 35148, 35070, 34991, 34914, 34837, 34760, 34684, 34608, 34533, 34458,
+  34384, 34310, 34237, 34164, 34092, 34020, 33949, 33878, 33807, 33737, 33668, 33599,
+  33530, 33461, 33393, 33326, 33259, 33192, 33126, 33060, 32994, 32929, 32864, 32800
+};
+
+/**
+ * Exact integer square root (floor), no floating point
+ *
+ * Two multiply-only Newton steps on 1/sqrt(x) from an 8-bit seed give
+ * sqrt to within a few hundred units, one more correction step brings it
+ * to +-1, and the final compare loops make it exact.
+ */
+static inline uint64_t isqrt64(uint64_t n)
+{
+  if (n < 2) return n;
+  
+#if defined(__GNUC__) || defined(__clang__)
+  unsigned shift = (unsigned)__builtin_clzll(n) & ~1u;
+#else
+  unsigned shift = 0;
+  while (!(n << shift >> 62)) shift += 2;
+#endif
+  uint64_t m = n << shift;                 // Normalized to [2^62, 2^64)
+  uint64_t x = m >> 32;                    // Top 32 bits, x / 2^32 in [1/4, 1)
+  
+  // r ~ 2^30 / sqrt(x / 2^32); r' = r * (3 - x * r^2) / 2
+  uint64_t r = (uint64_t)rsqrt_seed[(x >> 24) - 64] << 15;
+  for (int i = 0; i < 2; i++)
+  {
+    uint64_t t = (x * ((r * r) >> 32)) >> 28;
+    r = (r * (((3ULL << 32) - t) >> 2)) >> 31;
+  }
+  
+  // sqrt(m) ~ x * r; step from just below it by (m - s^2) / (2 sqrt(m))
+  uint64_t s = (x * r) >> 30;
+  s = s > 256 ? s - 256 : 0;
+  if (s > 0xFFFFFFFFULL) s = 0xFFFFFFFFULL;
+  s += (((m - s * s) >> 10) * r) >> 53;
+  if (s > 0xFFFFFFFFULL) s = 0xFFFFFFFFULL;
+  while (s * s > m) s--;
+  while (s < 0xFFFFFFFFULL && (s + 1) * (s + 1) <= m) s++;
+  
+  return s >> (shift >> 1);
+}
+
+/**
+ * Triangular number k(k+1)/2; k must not exceed MAX_OPTIMAL_DROPS64
+ */
+static inline uint64_t triangular64(uint64_t k)
+{
+  return (k & 1) ? k * ((k + 1) >> 1) : (k >> 1) * (k + 1);
+}
+
+/**
+ * Calculate optimal number of drops needed for n floors, in exact integers
+ * Smallest k with k(k+1)/2 >= n
+ */
+static inline uint64_t calculate_optimal_drops64(uint64_t total_floors)
+{
+  if (total_floors > MAX_FLOORS64) return MAX_OPTIMAL_DROPS64 + 1;
+  
+  if (total_floors < ((uint64_t)1 << 61))
+  {
+    uint64_t k = (isqrt64(8 * total_floors + 1) - 1) >> 1;  // Largest k with T(k) <= n
+    return k + (triangular64(k) < total_floors);
+  }
+  
+  // 8n+1 would overflow; 2*isqrt(n/2) is within a couple of the answer
+  uint64_t k = isqrt64(total_floors >> 1) << 1;
+  while (k > 0 && triangular64(k - 1) >= total_floors) k--;
+  while (triangular64(k) < total_floors) k++;
+  return k;
+}
+
 /**
  * Calculate optimal number of drops needed for n floors
  */
 static inline uint32_t calculate_optimal_drops(uint32_t total_floors)
 {
-  return (uint32_t)ceil((-1.0 + sqrt(1.0 + 8.0 * total_floors)) / 2.0);
+  return (uint32_t)calculate_optimal_drops64(total_floors);
 }
 
 /**
@@ -72,67 +570,180 @@ static uint32_t calculate_drop_points(uint32_t total_floors, uint32_t* drop_poin
 }
 
 /**
- * Binary search through drop points
+ * Floor reached by the first egg after j drops: T(k) - T(k-j)
  */
-static inline uint32_t binary_search_drops(const uint32_t* drop_points, 
-                                         uint32_t num_points,
-                                         uint32_t breaking_floor,
-                                         uint32_t* drops_used)
+static inline uint64_t drop_point_at(uint64_t step, uint64_t j)
 {
-  uint32_t left = 0;
-  uint32_t right = num_points - 1;
-  uint32_t previous_floor = 0;
+  return triangular64(step) - triangular64(step - j);
+}
+
+/**
+ * Count drop points at or below a floor without building the schedule
+ *
+ * Since the j-th point is T(k) - T(k-j), it lies at or below the floor
+ * exactly when T(k-j) >= T(k) - floor, which is an optimal drops query.
+ *
+ * @param step First egg step size (optimal drops)
+ * @param floor Floor to compare against
+ * @return Number of drop points <= floor (at most step)
+ */
+static inline uint64_t count_drop_points_at_or_below(uint64_t step, uint64_t floor)
+{
+  uint64_t top = triangular64(step);
+  if (floor >= top) return step;
   
+  return step - calculate_optimal_drops64(top - floor);
+}
+
+/**
+ * Replay the first egg binary search on indices only
+ *
+ * The search always ends on interval 'below' (the number of drop points
+ * at or below the breaking floor), so the drops it takes depend on that
+ * interval and on whether the egg lands exactly on a drop point.
+ *
+ * @param below Drop points at or below the breaking floor (<= num_points)
+ * @param hit Whether drop point 'below' is the breaking floor itself
+ * @param num_points Number of first egg drop points (> 0)
+ * @return Drops taken by the first egg
+ */
+static inline uint64_t replay_binary_search(uint64_t below, bool hit, uint64_t num_points)
+{
+  uint64_t left = 0;
+  uint64_t right = num_points - 1;
+  uint64_t drops = 0;
   while (left <= right)
   {
-    uint32_t mid = (left + right) >> 1;
-    uint32_t floor = drop_points[mid];
-    (*drops_used)++;
-    
-    if (floor == breaking_floor)
+    uint64_t mid = (left + right) >> 1;
+    drops++;
+    if (hit && mid + 1 == below)
     {
-      return floor;
+      break;
     }
-    else if (floor > breaking_floor)
+    if (mid >= below)
     {
+      if (mid == 0) break;
       right = mid - 1;
     }
     else
     {
-      previous_floor = floor;
       left = mid + 1;
     }
   }
-  
-  return previous_floor;
+  return drops;
 }
 
 /**
- * Find breaking point using optimal strategy - exported function
+ * Count drops used by the simulated strategy, arithmetically
+ *
+ * Mirrors simulate_breaking_point exactly but never reads a drop-point
+ * array: the interval is found with count_drop_points_at_or_below and the
+ * binary search is replayed on indices only.
+ *
+ * @param breaking_floor Floor where egg breaks
+ * @param step First egg step size (optimal drops)
+ * @param num_points Number of first egg drop points
+ * @return Number of drops used
  */
-EXPORT EggDropResult find_breaking_point(uint32_t breaking_floor, uint32_t total_floors)
+static inline uint64_t closed_form_drops(uint64_t breaking_floor, uint64_t step, uint64_t num_points)
 {
-  int64_t start_time = get_time_ns();
-  EggDropResult result = {0};
-  result.breaking_floor = breaking_floor;
-  result.optimal_drops = calculate_optimal_drops(total_floors);
-  
-  static uint32_t drop_points[1000];
-  uint32_t num_points = calculate_drop_points(total_floors, drop_points, 1000);
+  uint64_t drops;
+  uint64_t previous_floor;
   
-  uint32_t previous_floor;
   if (num_points > 10)
   {
-    previous_floor = binary_search_drops(drop_points, num_points, breaking_floor, &result.drops_used);
-    if (previous_floor == breaking_floor)
+    uint64_t below = count_drop_points_at_or_below(step, breaking_floor);
+    below = below < num_points ? below : num_points;
+    previous_floor = drop_point_at(step, below);
+    bool hit = below > 0 && previous_floor == breaking_floor;
+    
+    drops = replay_binary_search(below, hit, num_points);
+    if (hit)
     {
-      result.execution_time_ns = (double)(get_time_ns() - start_time);
-      return result;
+      return drops;
     }
   }
   else
   {
-    previous_floor = 0;
+    // Linear scan stops at the first drop point >= breaking floor
+    uint64_t below = breaking_floor ? count_drop_points_at_or_below(step, breaking_floor - 1) : 0;
+    below = below < num_points ? below : num_points;
+    drops = below < num_points ? below + 1 : num_points;
+    previous_floor = drop_point_at(step, below);
+  }
+  
+  // Second egg walks up from the last safe floor
+  if (breaking_floor > previous_floor)
+  {
+    drops += breaking_floor - previous_floor;
+  }
+  return drops;
+}
+
+/**
+ * Binary search through drop points
+ */
+static inline uint32_t binary_search_drops(const uint32_t* drop_points, 
+                                         uint32_t num_points,
+                                         uint32_t breaking_floor,
+                                         uint32_t* drops_used)
+{
+  uint32_t left = 0;
+  uint32_t right = num_points - 1;
+  uint32_t previous_floor = 0;
+  
+  while (left <= right)
+  {
+    uint32_t mid = (left + right) >> 1;
+    uint32_t floor = drop_points[mid];
+    (*drops_used)++;
+    
+    if (floor == breaking_floor)
+    {
+      return floor;
+    }
+    else if (floor > breaking_floor)
+    {
+      if (mid == 0)
+      {
+        break;
+      }
+      right = mid - 1;
+    }
+    else
+    {
+      previous_floor = floor;
+      left = mid + 1;
+    }
+  }
+  
+  return previous_floor;
+}
+
+/**
+ * Simulate the optimal strategy against precomputed drop points
+ */
+static EggDropResult simulate_breaking_point(uint32_t breaking_floor,
+                                             uint32_t optimal_drops,
+                                             const uint32_t* drop_points,
+                                             uint32_t num_points)
+{
+  EggDropResult result = {0};
+  result.breaking_floor = breaking_floor;
+  result.optimal_drops = optimal_drops;
+  
+  uint32_t previous_floor;
+  if (num_points > 10)
+  {
+    previous_floor = binary_search_drops(drop_points, num_points, breaking_floor, &result.drops_used);
+    if (previous_floor == breaking_floor)
+    {
+      return result;
+    }
+  }
+  else
+  {
+    previous_floor = 0;
     for (uint32_t i = 0; i < num_points; i++)
     {
       result.drops_used++;
@@ -155,14 +766,1585 @@ EXPORT EggDropResult find_breaking_point(uint32_t breaking_floor, uint32_t total
     }
   }
   
-  result.execution_time_ns = (double)(get_time_ns() - start_time);
   return result;
 }
 
 /**
- * Calculate optimal drops - exported function
+ * Build a drop plan for a building height - exported function
+ *
+ * The returned plan holds one reference and must be released with
+ * destroy_drop_plan().
+ *
+ * @param total_floors Total floors in building
+ * @return New plan, or NULL if allocation failed
  */
-EXPORT uint32_t get_optimal_drops(uint32_t total_floors)
+EXPORT EggDropPlan* create_drop_plan(uint32_t total_floors)
 {
-  return calculate_optimal_drops(total_floors);
+  uint32_t drop_points[MAX_DROP_POINTS];
+  uint32_t num_points = calculate_drop_points(total_floors, drop_points, MAX_DROP_POINTS);
+  
+  size_t size = sizeof(EggDropPlan) + num_points * sizeof(uint32_t);
+  EggDropPlan* plan = (EggDropPlan*)malloc(size);
+  if (!plan) return NULL;
+  stats_add(STAT_ALLOCATIONS, 1);
+  stats_add(STAT_ALLOCATED_BYTES, size);
+  
+  plan->total_floors = total_floors;
+  plan->optimal_drops = calculate_optimal_drops(total_floors);
+  plan->num_points = num_points;
+  plan->ref_count = 1;
+  for (uint32_t i = 0; i < num_points; i++)
+  {
+    plan->drop_points[i] = drop_points[i];
+  }
+  
+  return plan;
+}
+
+/**
+ * Find breaking point using a precomputed plan - exported function
+ *
+ * @param plan Plan created for the building height
+ * @param breaking_floor Floor where egg breaks
+ * @return EggDropResult with simulation results
+ */
+EXPORT EggDropResult query_drop_plan(const EggDropPlan* plan, uint32_t breaking_floor)
+{
+  uint64_t start = timing_start();
+  uint64_t phase = stats_start();
+  EggDropResult result = simulate_breaking_point(breaking_floor, plan->optimal_drops,
+                                                 plan->drop_points, plan->num_points);
+  stats_phase(phase, STAT_KERNEL_CYCLES);
+  stats_add(STAT_CALLS, 1);
+  stats_add(STAT_QUERIES, 1);
+  result.execution_time_ns = timing_elapsed_ns(start);
+  return result;
+}
+
+/**
+ * Release a plan reference - exported function
+ *
+ * The plan is freed once neither callers nor the plan cache hold it.
+ *
+ * @param plan Plan from create_drop_plan() or acquire_drop_plan()
+ */
+EXPORT void destroy_drop_plan(EggDropPlan* plan)
+{
+  if (!plan) return;
+  
+  if (ref_release(&plan->ref_count) == 0)
+  {
+    free(plan);
+  }
+}
+
+/**
+ * Look up a plan in the process-wide LRU cache, building it on a miss
+ *
+ * Hits only take the cache lock in shared mode, so concurrent lookups
+ * never wait for each other. Every lookup, hit or insert, stamps its slot
+ * with a fresh value of the clock (an atomic fetch-add), so the least
+ * recently used slot always holds the smallest stamp.
+ *
+ * @param total_floors Total floors in building
+ * @return Plan holding a new reference, or NULL if caching is disabled
+ *         or allocation failed
+ */
+static EggDropPlan* lookup_cached_plan(uint32_t total_floors)
+{
+  lock_plan_cache_shared();
+  
+  if (plan_cache_capacity == 0)
+  {
+    unlock_plan_cache_shared();
+    return NULL;
+  }
+  
+  uint32_t victim = 0;
+  for (uint32_t i = 0; i < plan_cache_capacity; i++)
+  {
+    EggDropPlan* cached = plan_cache[i].plan;
+    if (cached && cached->total_floors == total_floors)
+    {
+      atomic_store64(&plan_cache[i].last_used, atomic_add64(&plan_cache_clock, 1) + 1);
+      ref_acquire(&cached->ref_count);
+      unlock_plan_cache_shared();
+      stats_add(STAT_PLAN_CACHE_HITS, 1);
+      return cached;
+    }
+    if (!plan_cache[victim].plan)
+    {
+      continue;
+    }
+    if (!cached || atomic_load64(&plan_cache[i].last_used) < atomic_load64(&plan_cache[victim].last_used))
+    {
+      victim = i;
+    }
+  }
+  
+  unlock_plan_cache_shared();
+  stats_add(STAT_PLAN_CACHE_MISSES, 1);
+  
+  // Build outside the lock; another thread may insert the same height
+  // meanwhile, which only costs a duplicate slot until it is evicted.
+  EggDropPlan* plan = create_drop_plan(total_floors);
+  if (!plan) return NULL;
+  
+  lock_plan_cache();
+  EggDropPlan* evicted = NULL;
+  if (victim < plan_cache_capacity)
+  {
+    evicted = plan_cache[victim].plan;
+    if (evicted && ref_release(&evicted->ref_count) != 0)
+    {
+      evicted = NULL;
+    }
+    ref_acquire(&plan->ref_count);
+    plan_cache[victim].plan = plan;
+    atomic_store64(&plan_cache[victim].last_used, atomic_add64(&plan_cache_clock, 1) + 1);
+  }
+  unlock_plan_cache();
+  
+  free(evicted);
+  return plan;
+}
+
+/**
+ * Get a shared plan from the plan cache - exported function
+ *
+ * Falls back to an uncached plan when the cache is disabled. The caller
+ * owns one reference and must release it with destroy_drop_plan().
+ *
+ * @param total_floors Total floors in building
+ * @return Plan, or NULL if allocation failed
+ */
+EXPORT EggDropPlan* acquire_drop_plan(uint32_t total_floors)
+{
+  uint64_t phase = stats_start();
+  EggDropPlan* plan = lookup_cached_plan(total_floors);
+  if (!plan) plan = create_drop_plan(total_floors);
+  stats_phase(phase, STAT_SETUP_CYCLES);
+  return plan;
+}
+
+/**
+ * Resize the plan cache, evicting least recently used plans - exported function
+ *
+ * @param capacity Number of cached heights, 0 disables caching
+ * @return 0 on success, -1 if capacity exceeds PLAN_CACHE_MAX_ENTRIES
+ */
+EXPORT int set_plan_cache_capacity(uint32_t capacity)
+{
+  if (capacity > PLAN_CACHE_MAX_ENTRIES) return -1;
+  
+  EggDropPlan* evicted[PLAN_CACHE_MAX_ENTRIES];
+  uint32_t num_evicted = 0;
+  
+  lock_plan_cache();
+  // Compact live entries to the front, most recently used first
+  for (uint32_t i = 0; i < plan_cache_capacity; i++)
+  {
+    for (uint32_t j = i + 1; j < plan_cache_capacity; j++)
+    {
+      bool swap = plan_cache[j].plan &&
+                  (!plan_cache[i].plan || plan_cache[j].last_used > plan_cache[i].last_used);
+      if (swap)
+      {
+        PlanCacheEntry tmp = plan_cache[i];
+        plan_cache[i] = plan_cache[j];
+        plan_cache[j] = tmp;
+      }
+    }
+  }
+  for (uint32_t i = capacity; i < plan_cache_capacity; i++)
+  {
+    EggDropPlan* plan = plan_cache[i].plan;
+    if (plan && ref_release(&plan->ref_count) == 0)
+    {
+      evicted[num_evicted++] = plan;
+    }
+    plan_cache[i].plan = NULL;
+  }
+  plan_cache_capacity = capacity;
+  unlock_plan_cache();
+  
+  for (uint32_t i = 0; i < num_evicted; i++)
+  {
+    free(evicted[i]);
+  }
+  return 0;
+}
+
+/**
+ * Get the current plan cache capacity - exported function
+ */
+EXPORT uint32_t get_plan_cache_capacity(void)
+{
+  lock_plan_cache_shared();
+  uint32_t capacity = plan_cache_capacity;
+  unlock_plan_cache_shared();
+  return capacity;
+}
+
+/**
+ * Enable or disable execution time measurement - exported function
+ *
+ * Timing is off by default; results then report 0 ns. Single queries
+ * time themselves, batches time the whole call and store the per-query
+ * average. Toggle it before starting queries from other threads.
+ *
+ * @param enabled true to measure execution times
+ * @return 0 on success, -1 if the library was built with EGG_DROP_TIMING=0
+ */
+EXPORT int set_timing_enabled(bool enabled)
+{
+#if EGG_DROP_TIMING
+  if (enabled && ns_per_cycle == 0.0)
+  {
+    calibrate_cycle_counter();
+  }
+  timing_enabled = enabled;
+  return 0;
+#else
+  return enabled ? -1 : 0;
+#endif
+}
+
+/**
+ * Check whether execution time measurement is enabled - exported function
+ */
+EXPORT bool get_timing_enabled(void)
+{
+#if EGG_DROP_TIMING
+  return timing_enabled;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Enable or disable the hot-path counters - exported function
+ *
+ * Stats are off by default. Like timing, toggle them before starting
+ * queries from other threads; counts already made are kept.
+ *
+ * @param enabled true to count
+ * @return 0 on success, -1 if the library was built with EGG_DROP_STATS=0
+ */
+EXPORT int set_stats_enabled(bool enabled)
+{
+#if EGG_DROP_STATS
+  if (enabled && ns_per_cycle == 0.0)
+  {
+    calibrate_cycle_counter();
+  }
+  stats_enabled = enabled;
+  return 0;
+#else
+  return enabled ? -1 : 0;
+#endif
+}
+
+/**
+ * Check whether the hot-path counters are enabled - exported function
+ */
+EXPORT bool get_stats_enabled(void)
+{
+#if EGG_DROP_STATS
+  return stats_enabled;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Sum the hot-path counters of every thread - exported function
+ *
+ * Safe to call while other threads count; the result is then a snapshot
+ * that may include part of a call in flight.
+ *
+ * @param stats_out Output totals
+ * @return 0 on success, -1 on error
+ */
+EXPORT int get_stats(EggDropStats* stats_out)
+{
+  if (!stats_out) return -1;
+  
+  uint64_t totals[STAT_COUNT] = {0};
+  memset(stats_out, 0, sizeof(*stats_out));
+#if EGG_DROP_STATS
+  uint64_t claimed = atomic_load64(&stats_threads_claimed);
+  uint64_t slots = claimed < STATS_MAX_THREADS ? claimed : STATS_MAX_THREADS;
+  for (uint64_t t = 0; t < slots; t++)
+  {
+    for (int c = 0; c < STAT_COUNT; c++)
+    {
+      totals[c] += atomic_load64(&stats_slots[t].counters[c]);
+    }
+  }
+  stats_out->threads = (uint32_t)claimed;
+  stats_out->ns_per_cycle = ns_per_cycle;
+#endif
+  
+  stats_out->calls = totals[STAT_CALLS];
+  stats_out->queries = totals[STAT_QUERIES];
+  stats_out->plan_cache_hits = totals[STAT_PLAN_CACHE_HITS];
+  stats_out->plan_cache_misses = totals[STAT_PLAN_CACHE_MISSES];
+  stats_out->allocations = totals[STAT_ALLOCATIONS];
+  stats_out->allocated_bytes = totals[STAT_ALLOCATED_BYTES];
+  stats_out->setup_cycles = totals[STAT_SETUP_CYCLES];
+  stats_out->kernel_cycles = totals[STAT_KERNEL_CYCLES];
+  return 0;
+}
+
+/**
+ * Zero the hot-path counters of every thread - exported function
+ *
+ * Counts made by calls running concurrently with the reset may survive it.
+ */
+EXPORT void reset_stats(void)
+{
+#if EGG_DROP_STATS
+  for (uint32_t t = 0; t < STATS_MAX_THREADS; t++)
+  {
+    for (int c = 0; c < STAT_COUNT; c++)
+    {
+      atomic_store64(&stats_slots[t].counters[c], 0);
+    }
+  }
+#endif
+}
+
+/**
+ * Find breaking point using optimal strategy - exported function
+ *
+ * Each call looks its plan up in the shared cache. A hit only takes the
+ * cache lock in shared mode and bumps the plan's reference count and the
+ * LRU clock, so threads never wait for each other, but they still share
+ * those cache lines. Threads querying one height in a loop should hold a plan from
+ * acquire_drop_plan() and call query_drop_plan(), which touches no shared
+ * state at all.
+ */
+EXPORT EggDropResult find_breaking_point(uint32_t breaking_floor, uint32_t total_floors)
+{
+  uint64_t start = timing_start();
+  uint64_t phase = stats_start();
+  EggDropResult result;
+  EggDropPlan* plan = lookup_cached_plan(total_floors);
+  if (plan)
+  {
+    phase = stats_phase(phase, STAT_SETUP_CYCLES);
+    result = simulate_breaking_point(breaking_floor, plan->optimal_drops,
+                                     plan->drop_points, plan->num_points);
+    destroy_drop_plan(plan);
+  }
+  else
+  {
+    uint32_t drop_points[MAX_DROP_POINTS];
+    uint32_t num_points = calculate_drop_points(total_floors, drop_points, MAX_DROP_POINTS);
+    phase = stats_phase(phase, STAT_SETUP_CYCLES);
+    result = simulate_breaking_point(breaking_floor, calculate_optimal_drops(total_floors),
+                                     drop_points, num_points);
+  }
+  stats_phase(phase, STAT_KERNEL_CYCLES);
+  stats_add(STAT_CALLS, 1);
+  stats_add(STAT_QUERIES, 1);
+  
+  result.execution_time_ns = timing_elapsed_ns(start);
+  return result;
+}
+
+/**
+ * Find breaking points for a batch of queries - exported function
+ *
+ * Plans are only looked up when the building height changes between
+ * consecutive queries, so sweeps over one tower are cheap.
+ *
+ * @param breaking_floors Array of breaking floors (length count)
+ * @param total_floors Array of building heights (length count)
+ * @param count Number of queries
+ * @param results_out Output array of results (length count)
+ * @return 0 on success, -1 on error
+ */
+EXPORT int find_breaking_points(const uint32_t* breaking_floors,
+                                const uint32_t* total_floors,
+                                size_t count,
+                                EggDropResult* results_out)
+{
+  if (count == 0) return 0;
+  if (!breaking_floors || !total_floors || !results_out) return -1;
+  
+  uint64_t start = timing_start();
+  // acquire_drop_plan() charges its own setup cycles, the rest is kernel
+  uint64_t phase = stats_start();
+  uint64_t setup_before = stats_thread_total(STAT_SETUP_CYCLES);
+  EggDropPlan* plan = NULL;
+  for (size_t i = 0; i < count; i++)
+  {
+    if (!plan || plan->total_floors != total_floors[i])
+    {
+      destroy_drop_plan(plan);
+      plan = acquire_drop_plan(total_floors[i]);
+      if (!plan) return -1;
+    }
+    results_out[i] = simulate_breaking_point(breaking_floors[i], plan->optimal_drops,
+                                             plan->drop_points, plan->num_points);
+  }
+  destroy_drop_plan(plan);
+  stats_phase(phase + (stats_thread_total(STAT_SETUP_CYCLES) - setup_before), STAT_KERNEL_CYCLES);
+  stats_add(STAT_CALLS, 1);
+  stats_add(STAT_QUERIES, count);
+  
+  record_batch_time(results_out, count, timing_elapsed_ns(start));
+  return 0;
+}
+
+/**
+ * Number of first egg drop points for a building height, arithmetically
+ */
+static inline uint32_t closed_form_num_points(uint32_t total_floors, uint32_t step)
+{
+  uint64_t num_points = count_drop_points_at_or_below(step, total_floors);
+  return (uint32_t)(num_points < MAX_DROP_POINTS ? num_points : MAX_DROP_POINTS);
+}
+
+/**
+ * Kernel resolving a run of closed-form queries that share one height
+ *
+ * @param breaking_floors Breaking floors (length count)
+ * @param count Number of queries
+ * @param step First egg step size (optimal drops)
+ * @param num_points Number of first egg drop points
+ * @param results_out Output results (length count)
+ */
+typedef void (*ClosedFormKernel)(const uint32_t* breaking_floors, size_t count,
+                                 uint32_t step, uint32_t num_points,
+                                 EggDropResult* results_out);
+
+/**
+ * Store one query result
+ */
+static inline void store_closed_form_result(EggDropResult* result, uint32_t breaking_floor,
+                                            uint32_t step, uint32_t drops)
+{
+  result->breaking_floor = breaking_floor;
+  result->drops_used = drops;
+  result->optimal_drops = step;
+  result->execution_time_ns = 0.0;
+}
+
+/**
+ * Portable kernel, also used for the tail of the vector kernels
+ */
+static void closed_form_kernel_scalar(const uint32_t* breaking_floors, size_t count,
+                                      uint32_t step, uint32_t num_points,
+                                      EggDropResult* results_out)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    uint32_t drops = (uint32_t)closed_form_drops(breaking_floors[i], step, num_points);
+    store_closed_form_result(&results_out[i], breaking_floors[i], step, drops);
+  }
+}
+
+/**
+ * Iterations the first egg binary search needs at most over num_points
+ */
+static inline uint32_t binary_search_iterations(uint32_t num_points)
+{
+  uint32_t iterations = 0;
+  while (num_points)
+  {
+    iterations++;
+    num_points >>= 1;
+  }
+  return iterations;
+}
+
+/*
+ * The vector kernels run closed_form_drops in double lanes. Every value
+ * involved is below 2^36 on the 32-bit domain, so lane arithmetic and the
+ * square root seed are exact enough for a single +-1 correction; the
+ * binary search is replayed for a fixed number of iterations with a mask
+ * of still-searching lanes instead of branches.
+ */
+
+#if EGG_DROP_SIMD && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+/**
+ * Smallest k with k(k+1)/2 >= x, for x >= 1 (AVX2)
+ */
+__attribute__((target("avx2")))
+static inline __m256d optimal_drops_avx2(__m256d x)
+{
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d half = _mm256_set1_pd(0.5);
+  
+  __m256d root = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(x, _mm256_set1_pd(8.0)), one));
+  __m256d k = _mm256_ceil_pd(_mm256_mul_pd(_mm256_sub_pd(root, one), half));
+  __m256d t = _mm256_mul_pd(_mm256_mul_pd(k, _mm256_add_pd(k, one)), half);
+  
+  // T(k) < x: one more drop; T(k - 1) >= x: one fewer
+  k = _mm256_add_pd(k, _mm256_and_pd(_mm256_cmp_pd(t, x, _CMP_LT_OQ), one));
+  t = _mm256_mul_pd(_mm256_mul_pd(k, _mm256_sub_pd(k, one)), half);
+  k = _mm256_sub_pd(k, _mm256_and_pd(_mm256_cmp_pd(t, x, _CMP_GE_OQ), one));
+  return k;
+}
+
+/**
+ * Drop points at or below each floor (AVX2), see count_drop_points_at_or_below
+ */
+__attribute__((target("avx2")))
+static inline __m256d count_below_avx2(__m256d floor, __m256d step, __m256d top)
+{
+  __m256d count = _mm256_sub_pd(step, optimal_drops_avx2(_mm256_max_pd(_mm256_sub_pd(top, floor),
+                                                                        _mm256_set1_pd(1.0))));
+  return _mm256_blendv_pd(count, step, _mm256_cmp_pd(floor, top, _CMP_GE_OQ));
+}
+
+/**
+ * Triangular numbers of each lane (AVX2)
+ */
+__attribute__((target("avx2")))
+static inline __m256d triangular_avx2(__m256d k)
+{
+  return _mm256_mul_pd(_mm256_mul_pd(k, _mm256_add_pd(k, _mm256_set1_pd(1.0))), _mm256_set1_pd(0.5));
+}
+
+/**
+ * AVX2 kernel: 4 queries per iteration
+ */
+__attribute__((target("avx2")))
+static void closed_form_kernel_avx2(const uint32_t* breaking_floors, size_t count,
+                                    uint32_t step, uint32_t num_points,
+                                    EggDropResult* results_out)
+{
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d half = _mm256_set1_pd(0.5);
+  const __m256d bias = _mm256_set1_pd(2147483648.0);
+  const __m128i sign = _mm_set1_epi32((int)0x80000000u);
+  const __m256d vstep = _mm256_set1_pd((double)step);
+  const __m256d vtop = _mm256_set1_pd((double)triangular64(step));
+  const __m256d vnum = _mm256_set1_pd((double)num_points);
+  const uint32_t iterations = binary_search_iterations(num_points);
+  
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    // Unsigned 32-bit load via the signed conversion and a 2^31 bias
+    __m128i raw = _mm_loadu_si128((const __m128i*)(breaking_floors + i));
+    __m256d floor = _mm256_add_pd(_mm256_cvtepi32_pd(_mm_xor_si128(raw, sign)), bias);
+    __m256d drops;
+    __m256d below;
+    
+    if (num_points > 10)
+    {
+      below = _mm256_min_pd(count_below_avx2(floor, vstep, vtop), vnum);
+      __m256d previous = _mm256_sub_pd(vtop, triangular_avx2(_mm256_sub_pd(vstep, below)));
+      __m256d hit = _mm256_and_pd(_mm256_cmp_pd(below, zero, _CMP_GT_OQ),
+                                  _mm256_cmp_pd(previous, floor, _CMP_EQ_OQ));
+      
+      __m256d left = zero;
+      __m256d right = _mm256_sub_pd(vnum, one);
+      __m256d active = _mm256_cmp_pd(zero, zero, _CMP_EQ_OQ);
+      drops = zero;
+      for (uint32_t it = 0; it < iterations; it++)
+      {
+        active = _mm256_and_pd(active, _mm256_cmp_pd(left, right, _CMP_LE_OQ));
+        __m256d mid = _mm256_floor_pd(_mm256_mul_pd(_mm256_add_pd(left, right), half));
+        drops = _mm256_add_pd(drops, _mm256_and_pd(active, one));
+        
+        __m256d found = _mm256_and_pd(hit, _mm256_cmp_pd(_mm256_add_pd(mid, one), below, _CMP_EQ_OQ));
+        __m256d go_left = _mm256_cmp_pd(mid, below, _CMP_GE_OQ);
+        __m256d at_start = _mm256_and_pd(go_left, _mm256_cmp_pd(mid, zero, _CMP_EQ_OQ));
+        active = _mm256_andnot_pd(_mm256_or_pd(found, at_start), active);
+        
+        right = _mm256_blendv_pd(right, _mm256_sub_pd(mid, one), go_left);
+        left = _mm256_blendv_pd(_mm256_add_pd(mid, one), left, go_left);
+      }
+    }
+    else
+    {
+      // Linear scan stops at the first drop point >= breaking floor
+      __m256d nonzero = _mm256_cmp_pd(floor, zero, _CMP_GT_OQ);
+      below = _mm256_and_pd(count_below_avx2(_mm256_sub_pd(floor, one), vstep, vtop), nonzero);
+      below = _mm256_min_pd(below, vnum);
+      drops = _mm256_min_pd(_mm256_add_pd(below, one), vnum);
+    }
+    
+    // Second egg walks up from the last safe floor
+    __m256d previous = _mm256_sub_pd(vtop, triangular_avx2(_mm256_sub_pd(vstep, below)));
+    drops = _mm256_add_pd(drops, _mm256_max_pd(_mm256_sub_pd(floor, previous), zero));
+    
+    uint32_t lanes[4];
+    __m128i packed = _mm_xor_si128(_mm256_cvttpd_epi32(_mm256_sub_pd(drops, bias)), sign);
+    _mm_storeu_si128((__m128i*)lanes, packed);
+    for (int lane = 0; lane < 4; lane++)
+    {
+      store_closed_form_result(&results_out[i + lane], breaking_floors[i + lane], step, lanes[lane]);
+    }
+  }
+  
+  closed_form_kernel_scalar(breaking_floors + i, count - i, step, num_points, results_out + i);
+}
+
+/**
+ * Smallest k with k(k+1)/2 >= x, for x >= 1 (AVX-512)
+ */
+__attribute__((target("avx512f")))
+static inline __m512d optimal_drops_avx512(__m512d x)
+{
+  const __m512d one = _mm512_set1_pd(1.0);
+  const __m512d half = _mm512_set1_pd(0.5);
+  
+  __m512d root = _mm512_sqrt_pd(_mm512_fmadd_pd(x, _mm512_set1_pd(8.0), one));
+  __m512d k = _mm512_roundscale_pd(_mm512_mul_pd(_mm512_sub_pd(root, one), half),
+                                   _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+  __m512d t = _mm512_mul_pd(_mm512_mul_pd(k, _mm512_add_pd(k, one)), half);
+  
+  k = _mm512_mask_add_pd(k, _mm512_cmp_pd_mask(t, x, _CMP_LT_OQ), k, one);
+  t = _mm512_mul_pd(_mm512_mul_pd(k, _mm512_sub_pd(k, one)), half);
+  k = _mm512_mask_sub_pd(k, _mm512_cmp_pd_mask(t, x, _CMP_GE_OQ), k, one);
+  return k;
+}
+
+/**
+ * Drop points at or below each floor (AVX-512)
+ */
+__attribute__((target("avx512f")))
+static inline __m512d count_below_avx512(__m512d floor, __m512d step, __m512d top)
+{
+  __m512d count = _mm512_sub_pd(step, optimal_drops_avx512(_mm512_max_pd(_mm512_sub_pd(top, floor),
+                                                                          _mm512_set1_pd(1.0))));
+  return _mm512_mask_mov_pd(count, _mm512_cmp_pd_mask(floor, top, _CMP_GE_OQ), step);
+}
+
+/**
+ * Triangular numbers of each lane (AVX-512)
+ */
+__attribute__((target("avx512f")))
+static inline __m512d triangular_avx512(__m512d k)
+{
+  return _mm512_mul_pd(_mm512_mul_pd(k, _mm512_add_pd(k, _mm512_set1_pd(1.0))), _mm512_set1_pd(0.5));
+}
+
+/**
+ * AVX-512 kernel: 8 queries per iteration
+ */
+__attribute__((target("avx512f")))
+static void closed_form_kernel_avx512(const uint32_t* breaking_floors, size_t count,
+                                      uint32_t step, uint32_t num_points,
+                                      EggDropResult* results_out)
+{
+  const __m512d zero = _mm512_setzero_pd();
+  const __m512d one = _mm512_set1_pd(1.0);
+  const __m512d half = _mm512_set1_pd(0.5);
+  const __m512d vstep = _mm512_set1_pd((double)step);
+  const __m512d vtop = _mm512_set1_pd((double)triangular64(step));
+  const __m512d vnum = _mm512_set1_pd((double)num_points);
+  const uint32_t iterations = binary_search_iterations(num_points);
+  
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m512d floor = _mm512_cvtepu32_pd(_mm256_loadu_si256((const __m256i*)(breaking_floors + i)));
+    __m512d drops;
+    __m512d below;
+    
+    if (num_points > 10)
+    {
+      below = _mm512_min_pd(count_below_avx512(floor, vstep, vtop), vnum);
+      __m512d previous = _mm512_sub_pd(vtop, triangular_avx512(_mm512_sub_pd(vstep, below)));
+      __mmask8 hit = _mm512_cmp_pd_mask(below, zero, _CMP_GT_OQ) &
+                     _mm512_cmp_pd_mask(previous, floor, _CMP_EQ_OQ);
+      
+      __m512d left = zero;
+      __m512d right = _mm512_sub_pd(vnum, one);
+      __mmask8 active = 0xFF;
+      drops = zero;
+      for (uint32_t it = 0; it < iterations; it++)
+      {
+        active &= _mm512_cmp_pd_mask(left, right, _CMP_LE_OQ);
+        __m512d mid = _mm512_roundscale_pd(_mm512_mul_pd(_mm512_add_pd(left, right), half),
+                                           _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        drops = _mm512_mask_add_pd(drops, active, drops, one);
+        
+        __mmask8 found = hit & _mm512_cmp_pd_mask(_mm512_add_pd(mid, one), below, _CMP_EQ_OQ);
+        __mmask8 go_left = _mm512_cmp_pd_mask(mid, below, _CMP_GE_OQ);
+        __mmask8 at_start = go_left & _mm512_cmp_pd_mask(mid, zero, _CMP_EQ_OQ);
+        active &= (__mmask8)~(found | at_start);
+        
+        right = _mm512_mask_sub_pd(right, go_left, mid, one);
+        left = _mm512_mask_add_pd(left, (__mmask8)~go_left, mid, one);
+      }
+    }
+    else
+    {
+      __mmask8 nonzero = _mm512_cmp_pd_mask(floor, zero, _CMP_GT_OQ);
+      below = _mm512_maskz_mov_pd(nonzero, count_below_avx512(_mm512_sub_pd(floor, one), vstep, vtop));
+      below = _mm512_min_pd(below, vnum);
+      drops = _mm512_min_pd(_mm512_add_pd(below, one), vnum);
+    }
+    
+    __m512d previous = _mm512_sub_pd(vtop, triangular_avx512(_mm512_sub_pd(vstep, below)));
+    drops = _mm512_add_pd(drops, _mm512_max_pd(_mm512_sub_pd(floor, previous), zero));
+    
+    uint32_t lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, _mm512_cvttpd_epu32(drops));
+    for (int lane = 0; lane < 8; lane++)
+    {
+      store_closed_form_result(&results_out[i + lane], breaking_floors[i + lane], step, lanes[lane]);
+    }
+  }
+  
+  closed_form_kernel_scalar(breaking_floors + i, count - i, step, num_points, results_out + i);
+}
+
+#endif
+
+#if EGG_DROP_SIMD && defined(__aarch64__)
+
+/**
+ * Smallest k with k(k+1)/2 >= x, for x >= 1 (NEON)
+ */
+static inline float64x2_t optimal_drops_neon(float64x2_t x)
+{
+  const float64x2_t one = vdupq_n_f64(1.0);
+  const float64x2_t half = vdupq_n_f64(0.5);
+  
+  float64x2_t root = vsqrtq_f64(vfmaq_f64(one, x, vdupq_n_f64(8.0)));
+  float64x2_t k = vrndpq_f64(vmulq_f64(vsubq_f64(root, one), half));
+  float64x2_t t = vmulq_f64(vmulq_f64(k, vaddq_f64(k, one)), half);
+  
+  k = vbslq_f64(vcltq_f64(t, x), vaddq_f64(k, one), k);
+  t = vmulq_f64(vmulq_f64(k, vsubq_f64(k, one)), half);
+  k = vbslq_f64(vcgeq_f64(t, x), vsubq_f64(k, one), k);
+  return k;
+}
+
+/**
+ * Drop points at or below each floor (NEON)
+ */
+static inline float64x2_t count_below_neon(float64x2_t floor, float64x2_t step, float64x2_t top)
+{
+  float64x2_t count = vsubq_f64(step, optimal_drops_neon(vmaxq_f64(vsubq_f64(top, floor),
+                                                                   vdupq_n_f64(1.0))));
+  return vbslq_f64(vcgeq_f64(floor, top), step, count);
+}
+
+/**
+ * Triangular numbers of each lane (NEON)
+ */
+static inline float64x2_t triangular_neon(float64x2_t k)
+{
+  return vmulq_f64(vmulq_f64(k, vaddq_f64(k, vdupq_n_f64(1.0))), vdupq_n_f64(0.5));
+}
+
+/**
+ * NEON kernel: 2 queries per iteration
+ */
+static void closed_form_kernel_neon(const uint32_t* breaking_floors, size_t count,
+                                    uint32_t step, uint32_t num_points,
+                                    EggDropResult* results_out)
+{
+  const float64x2_t zero = vdupq_n_f64(0.0);
+  const float64x2_t one = vdupq_n_f64(1.0);
+  const float64x2_t half = vdupq_n_f64(0.5);
+  const float64x2_t vstep = vdupq_n_f64((double)step);
+  const float64x2_t vtop = vdupq_n_f64((double)triangular64(step));
+  const float64x2_t vnum = vdupq_n_f64((double)num_points);
+  const uint32_t iterations = binary_search_iterations(num_points);
+  
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2)
+  {
+    float64x2_t floor = vcvtq_f64_u64(vmovl_u32(vld1_u32(breaking_floors + i)));
+    float64x2_t drops;
+    float64x2_t below;
+    
+    if (num_points > 10)
+    {
+      below = vminq_f64(count_below_neon(floor, vstep, vtop), vnum);
+      float64x2_t previous = vsubq_f64(vtop, triangular_neon(vsubq_f64(vstep, below)));
+      uint64x2_t hit = vandq_u64(vcgtq_f64(below, zero), vceqq_f64(previous, floor));
+      
+      float64x2_t left = zero;
+      float64x2_t right = vsubq_f64(vnum, one);
+      uint64x2_t active = vdupq_n_u64(~0ULL);
+      drops = zero;
+      for (uint32_t it = 0; it < iterations; it++)
+      {
+        active = vandq_u64(active, vcleq_f64(left, right));
+        float64x2_t mid = vrndmq_f64(vmulq_f64(vaddq_f64(left, right), half));
+        drops = vbslq_f64(active, vaddq_f64(drops, one), drops);
+        
+        uint64x2_t found = vandq_u64(hit, vceqq_f64(vaddq_f64(mid, one), below));
+        uint64x2_t go_left = vcgeq_f64(mid, below);
+        uint64x2_t at_start = vandq_u64(go_left, vceqq_f64(mid, zero));
+        active = vbicq_u64(active, vorrq_u64(found, at_start));
+        
+        right = vbslq_f64(go_left, vsubq_f64(mid, one), right);
+        left = vbslq_f64(go_left, left, vaddq_f64(mid, one));
+      }
+    }
+    else
+    {
+      uint64x2_t nonzero = vcgtq_f64(floor, zero);
+      below = vbslq_f64(nonzero, count_below_neon(vsubq_f64(floor, one), vstep, vtop), zero);
+      below = vminq_f64(below, vnum);
+      drops = vminq_f64(vaddq_f64(below, one), vnum);
+    }
+    
+    float64x2_t previous = vsubq_f64(vtop, triangular_neon(vsubq_f64(vstep, below)));
+    drops = vaddq_f64(drops, vmaxq_f64(vsubq_f64(floor, previous), zero));
+    
+    uint32_t lanes[2];
+    vst1_u32(lanes, vmovn_u64(vcvtq_u64_f64(drops)));
+    for (int lane = 0; lane < 2; lane++)
+    {
+      store_closed_form_result(&results_out[i + lane], breaking_floors[i + lane], step, lanes[lane]);
+    }
+  }
+  
+  closed_form_kernel_scalar(breaking_floors + i, count - i, step, num_points, results_out + i);
+}
+
+#endif
+
+/**
+ * Kernels in order of preference
+ */
+typedef struct
+{
+  const char* name;
+  ClosedFormKernel kernel;
+} SimdKernelInfo;
+
+static const SimdKernelInfo simd_kernels[] = {
+#if EGG_DROP_SIMD && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  {"avx512", closed_form_kernel_avx512},
+  {"avx2", closed_form_kernel_avx2},
+#endif
+#if EGG_DROP_SIMD && defined(__aarch64__)
+  {"neon", closed_form_kernel_neon},
+#endif
+  {"scalar", closed_form_kernel_scalar}
+};
+
+#define NUM_SIMD_KERNELS (sizeof(simd_kernels) / sizeof(simd_kernels[0]))
+
+static const SimdKernelInfo* active_simd_kernel = &simd_kernels[NUM_SIMD_KERNELS - 1];
+
+/**
+ * Check whether this CPU can run a kernel
+ */
+static bool simd_kernel_supported(const SimdKernelInfo* info)
+{
+#if EGG_DROP_SIMD && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  if (info->kernel == closed_form_kernel_avx512) return __builtin_cpu_supports("avx512f");
+  if (info->kernel == closed_form_kernel_avx2) return __builtin_cpu_supports("avx2");
+#endif
+  (void)info;
+  return true;
+}
+
+/**
+ * Pick the best kernel for this CPU, once at load
+ */
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void select_simd_kernel(void)
+{
+  for (size_t i = 0; i < NUM_SIMD_KERNELS; i++)
+  {
+    if (simd_kernel_supported(&simd_kernels[i]))
+    {
+      active_simd_kernel = &simd_kernels[i];
+      return;
+    }
+  }
+}
+
+/**
+ * Get the name of the kernel used by batched closed-form queries - exported function
+ *
+ * @return "avx512", "avx2", "neon" or "scalar"
+ */
+EXPORT const char* get_simd_kernel(void)
+{
+  return active_simd_kernel->name;
+}
+
+/**
+ * Force the kernel used by batched closed-form queries - exported function
+ *
+ * Meant for benchmarks and tests; call it before starting queries from
+ * other threads.
+ *
+ * @param name Kernel name as returned by get_simd_kernel(), or NULL for the best one
+ * @return 0 on success, -1 if the kernel is unknown or unsupported on this CPU
+ */
+EXPORT int set_simd_kernel(const char* name)
+{
+  if (!name)
+  {
+    select_simd_kernel();
+    return 0;
+  }
+  
+  for (size_t i = 0; i < NUM_SIMD_KERNELS; i++)
+  {
+    if (strcmp(simd_kernels[i].name, name) == 0 && simd_kernel_supported(&simd_kernels[i]))
+    {
+      active_simd_kernel = &simd_kernels[i];
+      return 0;
+    }
+  }
+  return -1;
+}
+
+/**
+ * Find breaking point without a drop-point array - exported function
+ *
+ * Reports the same drops_used as find_breaking_point.
+ *
+ * @param breaking_floor Floor where egg breaks
+ * @param total_floors Total floors in building
+ * @return EggDropResult with simulation results
+ */
+EXPORT EggDropResult find_breaking_point_closed_form(uint32_t breaking_floor, uint32_t total_floors)
+{
+  uint64_t start = timing_start();
+  EggDropResult result = {0};
+  result.breaking_floor = breaking_floor;
+  result.optimal_drops = calculate_optimal_drops(total_floors);
+  
+  uint64_t phase = stats_start();
+  uint32_t num_points = closed_form_num_points(total_floors, result.optimal_drops);
+  result.drops_used = (uint32_t)closed_form_drops(breaking_floor, result.optimal_drops, num_points);
+  stats_phase(phase, STAT_KERNEL_CYCLES);
+  stats_add(STAT_CALLS, 1);
+  stats_add(STAT_QUERIES, 1);
+  
+  result.execution_time_ns = timing_elapsed_ns(start);
+  return result;
+}
+
+/**
+ * Batched version of find_breaking_point_closed_form - exported function
+ *
+ * @param breaking_floors Array of breaking floors (length count)
+ * @param total_floors Array of building heights (length count)
+ * @param count Number of queries
+ * @param results_out Output array of results (length count)
+ * @return 0 on success, -1 on error
+ */
+EXPORT int find_breaking_points_closed_form(const uint32_t* breaking_floors,
+                                            const uint32_t* total_floors,
+                                            size_t count,
+                                            EggDropResult* results_out)
+{
+  if (count == 0) return 0;
+  if (!breaking_floors || !total_floors || !results_out) return -1;
+  
+  uint64_t start = timing_start();
+  uint64_t phase = stats_start();
+  ClosedFormKernel kernel = active_simd_kernel->kernel;
+  
+  // The step and point count only change with the height, so hand each
+  // run of equal heights to the kernel in one piece
+  size_t run_start = 0;
+  while (run_start < count)
+  {
+    uint32_t floors = total_floors[run_start];
+    size_t run_end = run_start + 1;
+    while (run_end < count && total_floors[run_end] == floors)
+    {
+      run_end++;
+    }
+    
+    uint32_t step = calculate_optimal_drops(floors);
+    kernel(breaking_floors + run_start, run_end - run_start, step,
+           closed_form_num_points(floors, step), results_out + run_start);
+    run_start = run_end;
+  }
+  stats_phase(phase, STAT_KERNEL_CYCLES);
+  stats_add(STAT_CALLS, 1);
+  stats_add(STAT_QUERIES, count);
+  
+  record_batch_time(results_out, count, timing_elapsed_ns(start));
+  return 0;
+}
+
+/**
+ * Calculate optimal drops - exported function
+ */
+EXPORT uint32_t get_optimal_drops(uint32_t total_floors)
+{
+  return calculate_optimal_drops(total_floors);
+}
+
+/**
+ * Per-thread accumulator for sweep_breaking_points
+ */
+typedef struct
+{
+  EggDropSweepStats stats;
+  uint64_t* bin_deltas;       // Difference array over histogram bins (num_bins entries)
+  uint64_t last_bin;          // Queries in the open-ended last bin
+  uint32_t num_bins;
+  uint64_t search_points;     // num_points the tables below were built for (0 = none)
+  uint32_t miss_drops[MAX_DROP_POINTS + 1];  // First egg drops ending on interval m
+  uint32_t hit_drops[MAX_DROP_POINTS + 1];   // First egg drops landing on drop point m
+} SweepAccumulator;
+
+/**
+ * Account for the floors first_floor .. first_floor + length - 1 of one
+ * building, which use base_drops + 1 .. base_drops + length drops
+ */
+static inline void sweep_add_run(SweepAccumulator* acc, uint64_t base_drops, uint64_t length,
+                                 uint64_t optimal_drops, uint32_t total_floors, uint64_t first_floor)
+{
+  if (length == 0) return;
+  
+  EggDropSweepStats* stats = &acc->stats;
+  uint64_t lo = base_drops + 1;
+  uint64_t hi = base_drops + length;
+  
+  stats->queries += length;
+  stats->total_drops += length * base_drops + length * (length + 1) / 2;
+  if (hi > stats->max_drops || (hi == stats->max_drops && total_floors < stats->worst_total_floors))
+  {
+    stats->max_drops = hi;
+    stats->worst_total_floors = total_floors;
+    stats->worst_breaking_floor = first_floor + length - 1;
+  }
+  if (lo <= optimal_drops && optimal_drops <= hi) stats->at_optimal++;
+  if (hi > optimal_drops) stats->over_optimal += hi - (lo > optimal_drops ? lo : optimal_drops + 1) + 1;
+  
+  if (acc->num_bins == 0) return;
+  
+  // Bins below the last one get a range update; the rest is open-ended
+  uint64_t last = acc->num_bins - 1;
+  if (lo < last)
+  {
+    uint64_t end = hi < last ? hi + 1 : last;
+    acc->bin_deltas[lo]++;
+    if (end < last) acc->bin_deltas[end]--;
+  }
+  if (hi >= last)
+  {
+    acc->last_bin += hi - (lo > last ? lo : last) + 1;
+  }
+}
+
+/**
+ * Account for every breaking floor of one building height
+ *
+ * Within an interval between drop points the first egg always takes the
+ * same drops, so each interval is one arithmetic run of drop counts; only
+ * the drop points themselves (a binary search hit) are single values.
+ */
+static void sweep_building(SweepAccumulator* acc, uint32_t total_floors)
+{
+  if (total_floors == 0) return;
+  
+  uint64_t step = calculate_optimal_drops(total_floors);
+  uint64_t num_points = closed_form_num_points(total_floors, (uint32_t)step);
+  uint64_t previous = 0;
+  
+  if (num_points > 10 && acc->search_points != num_points)
+  {
+    for (uint64_t m = 0; m <= num_points; m++)
+    {
+      acc->miss_drops[m] = (uint32_t)replay_binary_search(m, false, num_points);
+      acc->hit_drops[m] = m > 0 ? (uint32_t)replay_binary_search(m, true, num_points) : 0;
+    }
+    acc->search_points = num_points;
+  }
+  
+  for (uint64_t m = 0; m <= num_points; m++)
+  {
+    uint64_t top = m < num_points ? drop_point_at(step, m + 1) : total_floors;
+    
+    if (num_points > 10)
+    {
+      // Floors strictly inside the interval, then the drop point itself
+      uint64_t inner = m < num_points ? top - previous - 1 : top - previous;
+      sweep_add_run(acc, acc->miss_drops[m], inner, step, total_floors, previous + 1);
+      if (m < num_points)
+      {
+        sweep_add_run(acc, acc->hit_drops[m + 1] - 1, 1, step, total_floors, top);
+      }
+    }
+    else
+    {
+      // The linear scan takes m + 1 drops to reach interval m (all of them past the last point)
+      uint64_t first_egg = m < num_points ? m + 1 : num_points;
+      sweep_add_run(acc, first_egg, top - previous, step, total_floors, previous + 1);
+    }
+    previous = top;
+  }
+}
+
+/**
+ * Simulate every breaking floor of a range of building heights - exported function
+ *
+ * Covers all (height, floor) pairs with min_floors <= height <= max_floors
+ * and 1 <= floor <= height, with the same drop counts find_breaking_point
+ * reports. Heights are split across OpenMP threads and each height costs
+ * O(drop points) instead of O(floors), so no per-query results exist.
+ *
+ * @param min_floors Lowest building height
+ * @param max_floors Highest building height
+ * @param num_threads Worker threads, 0 for the OpenMP default
+ * @param stats_out Aggregate statistics
+ * @param histogram Output counts of queries per drop count (num_bins entries,
+ *                  the last bin also counts everything above it); may be NULL
+ *                  if num_bins is 0
+ * @param num_bins Number of histogram bins
+ * @return 0 on success, -1 on error
+ */
+EXPORT int sweep_breaking_points(uint32_t min_floors,
+                                 uint32_t max_floors,
+                                 int num_threads,
+                                 EggDropSweepStats* stats_out,
+                                 uint64_t* histogram,
+                                 uint32_t num_bins)
+{
+  if (!stats_out || (num_bins > 0 && !histogram) || min_floors > max_floors || num_threads < 0)
+  {
+    return -1;
+  }
+  
+  memset(stats_out, 0, sizeof(*stats_out));
+  if (num_bins > 0) memset(histogram, 0, num_bins * sizeof(uint64_t));
+  bool failed = false;
+  uint64_t phase = stats_start();
+  int64_t first = (int64_t)min_floors;
+  int64_t last = (int64_t)max_floors;
+  
+  #pragma omp parallel num_threads(num_threads > 0 ? num_threads : omp_get_max_threads())
+  {
+    SweepAccumulator* acc = (SweepAccumulator*)calloc(1, sizeof(SweepAccumulator));
+    uint64_t* deltas = num_bins > 0 ? (uint64_t*)calloc(num_bins, sizeof(uint64_t)) : NULL;
+    bool ok = acc && (num_bins == 0 || deltas);
+    if (ok)
+    {
+      acc->bin_deltas = deltas;
+      acc->num_bins = num_bins;
+    }
+    
+    // Contiguous chunks keep the search tables valid across neighbouring heights
+    #pragma omp for schedule(dynamic, SWEEP_CHUNK_HEIGHTS)
+    for (int64_t h = first; h <= last; h++)
+    {
+      if (ok) sweep_building(acc, (uint32_t)h);
+    }
+    
+    #pragma omp critical
+    {
+      if (!ok)
+      {
+        failed = true;
+      }
+      else
+      {
+        EggDropSweepStats* part = &acc->stats;
+        stats_out->queries += part->queries;
+        stats_out->total_drops += part->total_drops;
+        stats_out->at_optimal += part->at_optimal;
+        stats_out->over_optimal += part->over_optimal;
+        bool worse = part->max_drops > stats_out->max_drops ||
+                     (part->max_drops == stats_out->max_drops && part->max_drops > 0 &&
+                      part->worst_total_floors < stats_out->worst_total_floors);
+        if (worse)
+        {
+          stats_out->max_drops = part->max_drops;
+          stats_out->worst_total_floors = part->worst_total_floors;
+          stats_out->worst_breaking_floor = part->worst_breaking_floor;
+        }
+        
+        uint64_t running = 0;
+        for (uint32_t d = 0; d + 1 < num_bins; d++)
+        {
+          running += deltas[d];
+          histogram[d] += running;
+        }
+        if (num_bins > 0) histogram[num_bins - 1] += acc->last_bin;
+      }
+    }
+    
+    free(deltas);
+    free(acc);
+  }
+  
+  if (failed) return -1;
+  stats_phase(phase, STAT_KERNEL_CYCLES);
+  stats_add(STAT_CALLS, 1);
+  stats_add(STAT_QUERIES, stats_out->queries);
+  stats_out->mean_drops = stats_out->queries ? (double)stats_out->total_drops / (double)stats_out->queries : 0.0;
+  return 0;
+}
+
+/**
+ * Find breaking point in a tower of up to MAX_FLOORS64 floors - exported function
+ *
+ * Uses the closed-form lookup over the full, uncapped schedule; taller
+ * requests are clamped to MAX_FLOORS64.
+ *
+ * @param breaking_floor Floor where egg breaks
+ * @param total_floors Total floors in building
+ * @return EggDropResult64 with simulation results
+ */
+EXPORT EggDropResult64 find_breaking_point64(uint64_t breaking_floor, uint64_t total_floors)
+{
+  uint64_t start = timing_start();
+  EggDropResult64 result = {0};
+  result.breaking_floor = breaking_floor;
+  
+  if (total_floors > MAX_FLOORS64) total_floors = MAX_FLOORS64;
+  result.optimal_drops = calculate_optimal_drops64(total_floors);
+  
+  uint64_t phase = stats_start();
+  uint64_t num_points = count_drop_points_at_or_below(result.optimal_drops, total_floors);
+  result.drops_used = closed_form_drops(breaking_floor, result.optimal_drops, num_points);
+  stats_phase(phase, STAT_KERNEL_CYCLES);
+  stats_add(STAT_CALLS, 1);
+  stats_add(STAT_QUERIES, 1);
+  
+  result.execution_time_ns = timing_elapsed_ns(start);
+  return result;
+}
+
+/**
+ * Batched version of find_breaking_point64 - exported function
+ *
+ * @param breaking_floors Array of breaking floors (length count)
+ * @param total_floors Array of building heights (length count)
+ * @param count Number of queries
+ * @param results_out Output array of results (length count)
+ * @return 0 on success, -1 on error
+ */
+EXPORT int find_breaking_points64(const uint64_t* breaking_floors,
+                                  const uint64_t* total_floors,
+                                  size_t count,
+                                  EggDropResult64* results_out)
+{
+  if (count == 0) return 0;
+  if (!breaking_floors || !total_floors || !results_out) return -1;
+  
+  // The step and point count only change with the height
+  uint64_t current_floors = 0;
+  uint64_t step = 0;
+  uint64_t num_points = 0;
+  
+  uint64_t start = timing_start();
+  uint64_t phase = stats_start();
+  for (size_t i = 0; i < count; i++)
+  {
+    uint64_t floors = total_floors[i] > MAX_FLOORS64 ? MAX_FLOORS64 : total_floors[i];
+    if (i == 0 || floors != current_floors)
+    {
+      current_floors = floors;
+      step = calculate_optimal_drops64(current_floors);
+      num_points = count_drop_points_at_or_below(step, current_floors);
+    }
+    
+    EggDropResult64* result = &results_out[i];
+    result->breaking_floor = breaking_floors[i];
+    result->drops_used = closed_form_drops(breaking_floors[i], step, num_points);
+    result->optimal_drops = step;
+    result->execution_time_ns = 0.0;
+  }
+  stats_phase(phase, STAT_KERNEL_CYCLES);
+  stats_add(STAT_CALLS, 1);
+  stats_add(STAT_QUERIES, count);
+  
+  record_batch_time64(results_out, count, timing_elapsed_ns(start));
+  return 0;
+}
+
+/**
+ * Calculate optimal drops for up to MAX_FLOORS64 floors - exported function
+ */
+EXPORT uint64_t get_optimal_drops64(uint64_t total_floors)
+{
+  return calculate_optimal_drops64(total_floors);
+}
+
+/**
+ * Calculate first egg drop points without a fixed cap - exported function
+ *
+ * @param total_floors Total floors in building
+ * @param drop_points Output buffer for drop points (may be NULL if max_points is 0)
+ * @param max_points Size of drop_points
+ * @return Total number of drop points in the schedule; only the first
+ *         max_points are written
+ */
+EXPORT uint64_t get_drop_points64(uint64_t total_floors, uint64_t* drop_points, uint64_t max_points)
+{
+  if (total_floors > MAX_FLOORS64) total_floors = MAX_FLOORS64;
+  uint64_t step = calculate_optimal_drops64(total_floors);
+  uint64_t num_points = count_drop_points_at_or_below(step, total_floors);
+  
+  uint64_t current_floor = 0;
+  for (uint64_t i = 0; i < num_points && i < max_points; i++)
+  {
+    current_floor += step - i;
+    drop_points[i] = current_floor;
+  }
+  
+  return num_points;
+}
+
+/**
+ * Saturating a + b
+ */
+static inline uint64_t add_sat64(uint64_t a, uint64_t b)
+{
+  uint64_t sum = a + b;
+  return sum < a ? UINT64_MAX : sum;
+}
+
+/**
+ * Floors coverable with the given drops and eggs, saturating at UINT64_MAX
+ *
+ * Uses f(d, e) = sum_{i=1..e} C(d, i), so one evaluation is O(e).
+ */
+static uint64_t coverable_floors(uint64_t drops, uint32_t eggs)
+{
+  uint64_t total = 0;
+  uint64_t term = 1;  // C(drops, i - 1)
+  
+  for (uint64_t i = 1; i <= eggs && i <= drops; i++)
+  {
+    // C(d, i) = C(d, i-1) * (d-i+1) / i; split term by i to keep it exact
+    uint64_t factor = drops - i + 1;
+    uint64_t quot = term / i;
+    uint64_t rem = term % i;
+    if (quot != 0 && factor > UINT64_MAX / quot)
+    {
+      return UINT64_MAX;
+    }
+    term = add_sat64(quot * factor, (rem * factor) / i);
+    total = add_sat64(total, term);
+    if (total == UINT64_MAX) break;
+  }
+  
+  return total;
+}
+
+/**
+ * Minimal worst-case drops for k eggs and n floors
+ *
+ * Binary searches d with coverable_floors(d, k) >= n, so a query costs
+ * O(k log n) with no table at all.
+ *
+ * @param eggs Number of eggs
+ * @param total_floors Number of floors
+ * @return Minimal drops, 0 for an empty building, UINT64_MAX with no eggs
+ */
+static uint64_t calculate_min_drops_k_eggs(uint32_t eggs, uint64_t total_floors)
+{
+  if (total_floors == 0) return 0;
+  if (eggs == 0) return UINT64_MAX;
+  if (eggs == 1) return total_floors;
+  if (eggs > K_EGG_MAX_EGGS) eggs = K_EGG_MAX_EGGS;
+  
+  // Two eggs cover d(d+1)/2 floors, so this bound holds for any eggs >= 2
+  uint64_t low = 1;
+  uint64_t high = 2 * isqrt64(total_floors) + 2;
+  while (low < high)
+  {
+    uint64_t mid = low + ((high - low) >> 1);
+    if (coverable_floors(mid, eggs) >= total_floors)
+    {
+      high = mid;
+    }
+    else
+    {
+      low = mid + 1;
+    }
+  }
+  
+  return low;
+}
+
+/**
+ * Coverage lookup for a k-egg plan
+ */
+static inline uint64_t plan_coverage(const KEggPlan* plan, uint64_t drops, uint32_t eggs)
+{
+  if (eggs == 0) return 0;
+  if (eggs == 1) return drops;
+  return plan->coverage[drops * plan->table_columns + (eggs - 2)];
+}
+
+/**
+ * Minimal drops for k eggs and n floors - exported function
+ */
+EXPORT uint64_t get_min_drops_k_eggs(uint32_t eggs, uint64_t total_floors)
+{
+  return calculate_min_drops_k_eggs(eggs, total_floors);
+}
+
+/**
+ * Minimal drops for many (eggs, floors) pairs - exported function
+ *
+ * @param eggs Array of egg counts (length count)
+ * @param total_floors Array of building heights (length count)
+ * @param count Number of queries
+ * @param drops_out Output array of minimal drops (length count)
+ * @return 0 on success, -1 on error
+ */
+EXPORT int get_min_drops_k_eggs_batch(const uint32_t* eggs,
+                                      const uint64_t* total_floors,
+                                      size_t count,
+                                      uint64_t* drops_out)
+{
+  if (count == 0) return 0;
+  if (!eggs || !total_floors || !drops_out) return -1;
+  
+  for (size_t i = 0; i < count; i++)
+  {
+    drops_out[i] = calculate_min_drops_k_eggs(eggs[i], total_floors[i]);
+  }
+  
+  return 0;
+}
+
+/**
+ * Build an executable k-egg drop schedule - exported function
+ *
+ * @param eggs Number of eggs
+ * @param total_floors Number of floors
+ * @return New plan (free with destroy_k_egg_plan), or NULL if there are no
+ *         eggs, the table would exceed K_EGG_MAX_TABLE_ENTRIES, or
+ *         allocation failed
+ */
+EXPORT KEggPlan* create_k_egg_plan(uint32_t eggs, uint64_t total_floors)
+{
+  if (eggs == 0 && total_floors > 0) return NULL;
+  
+  uint64_t max_drops = calculate_min_drops_k_eggs(eggs, total_floors);
+  
+  // With e >= d every drop can afford to break, so extra eggs are unused
+  uint32_t used_eggs = eggs;
+  if (used_eggs > max_drops) used_eggs = (uint32_t)max_drops;
+  
+  uint32_t columns = used_eggs > 2 ? used_eggs - 2 : 0;
+  if (columns != 0 && max_drops > K_EGG_MAX_TABLE_ENTRIES / columns) return NULL;
+  
+  size_t entries = (size_t)(max_drops * columns);
+  size_t size = sizeof(KEggPlan) + entries * sizeof(uint64_t);
+  KEggPlan* plan = (KEggPlan*)malloc(size);
+  if (!plan) return NULL;
+  stats_add(STAT_ALLOCATIONS, 1);
+  stats_add(STAT_ALLOCATED_BYTES, size);
+  
+  plan->total_floors = total_floors;
+  plan->max_drops = max_drops;
+  plan->eggs = used_eggs;
+  plan->table_columns = columns;
+  
+  // f(d, e) = f(d-1, e-1) + f(d-1, e) + 1, one row per drop count
+  if (columns != 0)
+  {
+    for (uint32_t e = 0; e < columns; e++)
+    {
+      plan->coverage[e] = 0;
+    }
+    for (uint64_t d = 1; d < max_drops; d++)
+    {
+      const uint64_t* prev = &plan->coverage[(d - 1) * columns];
+      uint64_t* row = &plan->coverage[d * columns];
+      for (uint32_t e = 0; e < columns; e++)
+      {
+        uint64_t fewer_eggs = e == 0 ? d - 1 : prev[e - 1];
+        row[e] = add_sat64(add_sat64(fewer_eggs, prev[e]), 1);
+      }
+    }
+  }
+  
+  return plan;
+}
+
+/**
+ * Next floor to drop from in a k-egg schedule - exported function
+ *
+ * The unknown range is (safe_floor, top_floor]; the answer is either a
+ * floor in that range or "never breaks" above it.
+ *
+ * @param plan Plan for the building
+ * @param safe_floor Highest floor known not to break the egg
+ * @param top_floor Highest floor still in question
+ * @param drops_left Drops remaining in the budget
+ * @param eggs_left Unbroken eggs
+ * @return Floor to drop from, or 0 if the range is already resolved
+ */
+EXPORT uint64_t k_egg_plan_next_floor(const KEggPlan* plan,
+                                      uint64_t safe_floor,
+                                      uint64_t top_floor,
+                                      uint64_t drops_left,
+                                      uint32_t eggs_left)
+{
+  if (safe_floor >= top_floor || drops_left == 0 || eggs_left == 0) return 0;
+  if (eggs_left > plan->eggs) eggs_left = plan->eggs;
+  if (drops_left > plan->max_drops) drops_left = plan->max_drops;
+  
+  // Leave exactly what the remaining eggs can cover below the drop
+  uint64_t below = plan_coverage(plan, drops_left - 1, eggs_left - 1);
+  uint64_t span = top_floor - safe_floor;
+  return below < span ? safe_floor + below + 1 : top_floor;
+}
+
+/**
+ * Run a k-egg schedule against a breaking floor - exported function
+ *
+ * @param plan Plan for the building
+ * @param breaking_floor Lowest floor that breaks an egg, or any value
+ *        above total_floors if no floor does
+ * @return KEggResult with simulation results
+ */
+EXPORT KEggResult query_k_egg_plan(const KEggPlan* plan, uint64_t breaking_floor)
+{
+  KEggResult result = {0};
+  result.optimal_drops = plan->max_drops;
+  
+  uint64_t safe_floor = 0;
+  uint64_t top_floor = plan->total_floors;
+  uint64_t drops_left = plan->max_drops;
+  uint32_t eggs_left = plan->eggs;
+  
+  while (safe_floor < top_floor)
+  {
+    uint64_t floor = k_egg_plan_next_floor(plan, safe_floor, top_floor, drops_left, eggs_left);
+    if (floor == 0) break;  // Budget exhausted; cannot happen for a valid plan
+    result.drops_used++;
+    drops_left--;
+    if (floor >= breaking_floor)
+    {
+      top_floor = floor - 1;
+      eggs_left--;
+      result.eggs_broken++;
+    }
+    else
+    {
+      safe_floor = floor;
+    }
+  }
+  
+  result.breaking_floor = safe_floor + 1;
+  return result;
+}
+
+/**
+ * Free a plan created by create_k_egg_plan - exported function
+ */
+EXPORT void destroy_k_egg_plan(KEggPlan* plan)
+{
+  free(plan);
 }
\ No newline at end of file
@@ -1,29 +1,62 @@
 #define _CRT_SECURE_NO_WARNINGS
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  // sched_setaffinity
+#endif
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <time.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <inttypes.h>
 #ifdef _WIN32
 #include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
 #endif
 
 #ifndef TIME_UTC
 #define TIME_UTC 1
 #endif
 
+#define MAX_DROP_POINTS 1000           // First egg drop points kept per plan
+#define TIMING_CALIBRATION_NS 2000000  // Cycle counter calibration window
+#define BENCH_BATCH_SIZE 256           // Default queries timed together in the benchmark
+#define BENCH_BATCHES 2000             // Default timed batches per benchmark run
+#define BENCH_POOL_SIZE 65536          // Breaking floors generated per benchmark run
+#define BENCH_MAX_SIZES 32             // Building heights per benchmark invocation
+#define BENCH_WARMUP_WINDOW 16         // Batches the warm-up stability check looks at
+#define BENCH_MAX_WARMUP_BATCHES 2000  // Default warm-up limit
+#define BENCH_WARMUP_CV 0.05           // Default warm-up coefficient of variation target
+#define BENCH_MAX_SECONDS 2.0          // Default time budget per benchmark run
+#define BENCH_STATS_QUERIES 4096       // Pool floors sampled for the drop statistics
+#define VERIFY_MAX_REPORTED 10         // Violations listed by --verify
+#define VERIFY_CROSS_CHECK_FLOORS 1000 // --verify also brute-forces heights up to this
+
+// Build with -DEGG_DROP_TIMING=0 to stop find_breaking_point timing itself
+#ifndef EGG_DROP_TIMING
+#define EGG_DROP_TIMING 1
+#endif
+
+static double ns_per_cycle = 1.0;
+
 /**
  * Get current time in nanoseconds
  */
-static inline int64_t get_time_ns(void)
+static int64_t get_time_ns(void)
 {
 #ifdef _WIN32
-  LARGE_INTEGER frequency;
-  LARGE_INTEGER start;
-  QueryPerformanceFrequency(&frequency);
-  QueryPerformanceCounter(&start);
-  return (int64_t)((start.QuadPart * 1000000000) / frequency.QuadPart);
+  static LARGE_INTEGER frequency;
+  LARGE_INTEGER now;
+  if (frequency.QuadPart == 0) QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&now);
+  return (int64_t)((double)now.QuadPart * 1e9 / (double)frequency.QuadPart);
 #else
   struct timespec ts;
   clock_gettime(CLOCK_MONOTONIC, &ts);
@@ -31,6 +64,47 @@ static inline int64_t get_time_ns(void)
 #endif
 }
 
+/**
+ * Read the free-running cycle counter
+ */
+static inline uint64_t read_cycle_counter(void)
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t ticks;
+  __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+  return ticks;
+#else
+  return (uint64_t)get_time_ns();
+#endif
+}
+
+/**
+ * Measure the cycle counter against the monotonic clock; call once at startup
+ */
+static void calibrate_cycle_counter(void)
+{
+  int64_t start_ns = get_time_ns();
+  uint64_t start_ticks = read_cycle_counter();
+  int64_t elapsed_ns;
+  do
+  {
+    elapsed_ns = get_time_ns() - start_ns;
+  } while (elapsed_ns < TIMING_CALIBRATION_NS);
+  uint64_t elapsed_ticks = read_cycle_counter() - start_ticks;
+  
+  ns_per_cycle = elapsed_ticks ? (double)elapsed_ns / (double)elapsed_ticks : 1.0;
+}
+
+/**
+ * Convert a cycle counter interval to nanoseconds
+ */
+static inline double cycles_to_ns(uint64_t cycles)
+{
+  return (double)cycles * ns_per_cycle;
+}
+
 /**
  * Structure to hold egg drop simulation results
  */
@@ -42,6 +116,18 @@ typedef struct
   double execution_time_ns;   // Time taken in nanoseconds
 } EggDropResult;
 
+/**
+ * Precomputed drop schedule for one building height.
+ * Read-only once created, so it can be shared between threads.
+ */
+typedef struct
+{
+  uint32_t total_floors;      // Building height the plan was built for
+  uint32_t optimal_drops;     // Theoretical optimal drops
+  uint32_t num_points;        // Number of first egg drop points
+  uint32_t drop_points[];     // First egg drop points (num_points entries)
+} EggDropPlan;
+
 /**
  * Calculate optimal number of drops needed for n floors
  * Uses formula: k(k+1)/2 ≥ n where k is drops needed
@@ -109,6 +195,10 @@ static inline uint32_t binary_search_drops(const uint32_t* drop_points,
     }
     else if (floor > breaking_floor)
     {
+      if (mid == 0)  // Nothing left below the first drop point
+      {
+        break;
+      }
       right = mid - 1;
     }
     else
@@ -122,23 +212,22 @@ static inline uint32_t binary_search_drops(const uint32_t* drop_points,
 }
 
 /**
- * Find breaking point using optimal strategy
+ * Simulate the optimal strategy against precomputed drop points
  * 
  * @param breaking_floor Floor where egg breaks
- * @param total_floors Total floors in building
+ * @param optimal_drops Theoretical optimal drops for the building
+ * @param drop_points First egg drop points
+ * @param num_points Number of drop points
  * @return EggDropResult with simulation results
  */
-EggDropResult find_breaking_point(uint32_t breaking_floor, uint32_t total_floors)
+static EggDropResult simulate_breaking_point(uint32_t breaking_floor,
+                                             uint32_t optimal_drops,
+                                             const uint32_t* drop_points,
+                                             uint32_t num_points)
 {
-  int64_t start_time = get_time_ns();
   EggDropResult result = {0};
   result.breaking_floor = breaking_floor;
-  result.optimal_drops = calculate_optimal_drops(total_floors);
-  
-  // Static allocation for better performance
-  // Max possible drops is sqrt(2*MAX_UINT32) which is much less than 1000
-  static uint32_t drop_points[1000];
-  uint32_t num_points = calculate_drop_points(total_floors, drop_points, 1000);
+  result.optimal_drops = optimal_drops;
   
   // First egg - Binary search for larger buildings
   uint32_t previous_floor;
@@ -147,7 +236,6 @@ EggDropResult find_breaking_point(uint32_t breaking_floor, uint32_t total_floors
     previous_floor = binary_search_drops(drop_points, num_points, breaking_floor, &result.drops_used);
     if (previous_floor == breaking_floor)
     {
-      result.execution_time_ns = (double)(get_time_ns() - start_time);
       return result;
     }
   }
@@ -178,69 +266,708 @@ EggDropResult find_breaking_point(uint32_t breaking_floor, uint32_t total_floors
     }
   }
   
-  result.execution_time_ns = (double)(get_time_ns() - start_time);
   return result;
 }
 
 /**
- * Benchmark the solution with various building sizes
+ * Build the drop plan for a building height
+ * 
+ * @param total_floors Number of floors in building
+ * @return New plan (free with destroy_drop_plan), or NULL on allocation failure
  */
-void benchmark_solution(void)
+EggDropPlan* create_drop_plan(uint32_t total_floors)
 {
-  printf("\nPerformance Benchmark\n");
-  printf("--------------------\n");
+  uint32_t drop_points[MAX_DROP_POINTS];
+  uint32_t num_points = calculate_drop_points(total_floors, drop_points, MAX_DROP_POINTS);
   
-  const uint32_t buildings[] = {100, 1000, 10000, 100000, 1000000};
-  const size_t num_buildings = sizeof(buildings) / sizeof(buildings[0]);
-  const int iterations = 10000;  // Increased for better statistics
+  EggDropPlan* plan = (EggDropPlan*)malloc(sizeof(EggDropPlan) + num_points * sizeof(uint32_t));
+  if (!plan) return NULL;
   
-  double total_time_ns = 0.0;
-  uint64_t total_drops = 0;
+  plan->total_floors = total_floors;
+  plan->optimal_drops = calculate_optimal_drops(total_floors);
+  plan->num_points = num_points;
+  for (uint32_t i = 0; i < num_points; i++)
+  {
+    plan->drop_points[i] = drop_points[i];
+  }
+  
+  return plan;
+}
+
+/**
+ * Find breaking point using a precomputed plan (untimed, for benchmarks)
+ * 
+ * @param plan Plan for the building height
+ * @param breaking_floor Floor where egg breaks
+ * @return EggDropResult with simulation results
+ */
+EggDropResult query_drop_plan(const EggDropPlan* plan, uint32_t breaking_floor)
+{
+  return simulate_breaking_point(breaking_floor, plan->optimal_drops, plan->drop_points, plan->num_points);
+}
+
+/**
+ * Free a plan created by create_drop_plan
+ * 
+ * @param plan Plan to free (may be NULL)
+ */
+void destroy_drop_plan(EggDropPlan* plan)
+{
+  free(plan);
+}
+
+/**
+ * Find breaking point using optimal strategy
+ * 
+ * @param breaking_floor Floor where egg breaks
+ * @param total_floors Total floors in building
+ * @return EggDropResult with simulation results
+ */
+EggDropResult find_breaking_point(uint32_t breaking_floor, uint32_t total_floors)
+{
+#if EGG_DROP_TIMING
+  uint64_t start = read_cycle_counter();
+#endif
+  // Stack buffer keeps this reentrant; use a plan to skip the setup
+  uint32_t drop_points[MAX_DROP_POINTS];
+  uint32_t num_points = calculate_drop_points(total_floors, drop_points, MAX_DROP_POINTS);
   
-  for (size_t i = 0; i < num_buildings; i++)
+  EggDropResult result = simulate_breaking_point(breaking_floor, calculate_optimal_drops(total_floors),
+                                                 drop_points, num_points);
+#if EGG_DROP_TIMING
+  result.execution_time_ns = cycles_to_ns(read_cycle_counter() - start);
+#endif
+  return result;
+}
+
+/**
+ * Breaking floor distributions for the benchmark
+ */
+typedef enum
+{
+  DIST_UNIFORM,      // Uniformly random floors in [1, n]
+  DIST_WORST,        // Only floors that need the most drops
+  DIST_ADVERSARIAL   // Random interval boundaries, defeating branch prediction
+} FloorDistribution;
+
+static const char* const distribution_names[] = {"uniform", "worst", "adversarial"};
+
+/**
+ * Benchmark output formats
+ */
+typedef enum
+{
+  FORMAT_TEXT,
+  FORMAT_JSON,
+  FORMAT_CSV
+} OutputFormat;
+
+/**
+ * Benchmark configuration, filled from the command line
+ */
+typedef struct
+{
+  uint32_t sizes[BENCH_MAX_SIZES];      // Building heights to test
+  uint32_t num_sizes;
+  FloorDistribution dists[3];           // Breaking floor distributions to test
+  uint32_t num_dists;
+  uint32_t batch_size;                  // Queries per timed batch
+  uint32_t batches;                     // Timed batches per run
+  uint32_t max_warmup_batches;          // Warm-up gives up after this many batches
+  double warmup_cv;                     // Warm-up ends once the batch CV drops below this
+  double max_seconds;                   // Time budget per run; cuts warm-up and batches short
+  int cpu;                              // CPU to pin to, -1 to leave unpinned
+  uint64_t seed;                        // Seed for the floor generators
+  OutputFormat format;
+} BenchConfig;
+
+/**
+ * Statistics of one benchmark run (one height and distribution)
+ */
+typedef struct
+{
+  uint32_t floors;
+  FloorDistribution dist;
+  uint32_t optimal_drops;
+  double avg_drops;
+  uint32_t max_drops;
+  uint32_t warmup_batches;      // Warm-up batches actually run
+  bool warmup_converged;        // False if the warm-up limit or time budget was hit
+  uint32_t batches;             // Timed batches actually run
+  double mean_ns;               // Per-query statistics over batches
+  double stddev_ns;
+  double min_ns;
+  double p50_ns;
+  double p99_ns;
+  double p999_ns;
+  double max_ns;
+} BenchStats;
+
+/**
+ * splitmix64 step, used to generate breaking floors
+ */
+static inline uint64_t bench_next_random(uint64_t* state)
+{
+  uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/**
+ * Uniform random number in [0, bound)
+ */
+static inline uint32_t bench_random_below(uint64_t* state, uint32_t bound)
+{
+  return (uint32_t)(((bench_next_random(state) >> 32) * bound) >> 32);
+}
+
+/**
+ * Fill the query pool for one building height
+ * 
+ * Worst case floors are taken from the top two floors of every interval,
+ * filtered to those reaching the maximum drop count. Adversarial
+ * floors sit on or next to random drop points, so consecutive queries take
+ * unrelated search paths.
+ * 
+ * @param plan Plan for the building height
+ * @param dist Distribution to draw from
+ * @param seed Generator seed
+ * @param pool Output pool of breaking floors
+ * @param pool_size Number of floors to generate
+ * @return 0 on success, -1 on allocation failure
+ */
+static int fill_floor_pool(const EggDropPlan* plan, FloorDistribution dist, uint64_t seed,
+                           uint32_t* pool, uint32_t pool_size)
+{
+  uint64_t state = seed ^ ((uint64_t)plan->total_floors << 32) ^ (uint64_t)dist;
+  uint32_t floors = plan->total_floors;
+  
+  if (dist == DIST_UNIFORM)
+  {
+    for (uint32_t i = 0; i < pool_size; i++)
+    {
+      pool[i] = 1 + bench_random_below(&state, floors);
+    }
+    return 0;
+  }
+  
+  if (dist == DIST_ADVERSARIAL)
   {
-    uint32_t floors = buildings[i];
-    uint32_t breaking_floor = floors / 2;  // Test middle floor for worst case
+    for (uint32_t i = 0; i < pool_size; i++)
+    {
+      uint32_t floor = floors;
+      if (plan->num_points > 0)
+      {
+        floor = plan->drop_points[bench_random_below(&state, plan->num_points)];
+        floor += bench_random_below(&state, 3);
+        floor = floor > 1 ? floor - 1 : 1;
+        if (floor > floors) floor = floors;
+      }
+      pool[i] = floor;
+    }
+    return 0;
+  }
+  
+  // The worst floor of each interval is its top or the floor below it
+  uint32_t* candidates = (uint32_t*)malloc(2 * (plan->num_points + 1) * sizeof(uint32_t));
+  if (!candidates) return -1;
+  
+  uint32_t num_candidates = 0;
+  uint32_t max_drops = 0;
+  for (uint32_t i = 0; i <= plan->num_points; i++)
+  {
+    uint32_t top = (i < plan->num_points) ? plan->drop_points[i] : floors;
+    for (uint32_t floor = (top > 1 ? top - 1 : 1); floor <= top; floor++)
+    {
+      uint32_t drops = query_drop_plan(plan, floor).drops_used;
+      if (drops > max_drops)
+      {
+        max_drops = drops;
+        num_candidates = 0;
+      }
+      if (drops == max_drops)
+      {
+        candidates[num_candidates++] = floor;
+      }
+    }
+  }
+  
+  for (uint32_t i = 0; i < pool_size; i++)
+  {
+    pool[i] = candidates[bench_random_below(&state, num_candidates)];
+  }
+  free(candidates);
+  return 0;
+}
+
+/**
+ * Time one batch of queries, returning nanoseconds per query
+ */
+static double time_batch(const EggDropPlan* plan, const uint32_t* floors, uint32_t count,
+                         uint64_t* drops_sink)
+{
+  uint64_t drops = 0;
+  uint64_t start = read_cycle_counter();
+  for (uint32_t i = 0; i < count; i++)
+  {
+    drops += query_drop_plan(plan, floors[i]).drops_used;
+  }
+  uint64_t elapsed = read_cycle_counter() - start;
+  
+  *drops_sink += drops;
+  return cycles_to_ns(elapsed) / count;
+}
+
+/**
+ * Coefficient of variation of a sample
+ */
+static double coefficient_of_variation(const double* samples, uint32_t count)
+{
+  double mean = 0.0;
+  for (uint32_t i = 0; i < count; i++) mean += samples[i];
+  mean /= count;
+  
+  double variance = 0.0;
+  for (uint32_t i = 0; i < count; i++) variance += (samples[i] - mean) * (samples[i] - mean);
+  variance /= count;
+  
+  return mean > 0.0 ? sqrt(variance) / mean : 0.0;
+}
+
+static int compare_doubles(const void* a, const void* b)
+{
+  double x = *(const double*)a;
+  double y = *(const double*)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * Nearest-rank percentile of a sorted sample
+ */
+static double percentile(const double* sorted, uint32_t count, double p)
+{
+  uint32_t rank = (uint32_t)ceil(p * count);
+  if (rank < 1) rank = 1;
+  if (rank > count) rank = count;
+  return sorted[rank - 1];
+}
+
+/**
+ * Benchmark one building height against one floor distribution
+ * 
+ * @param config Benchmark configuration
+ * @param floors Building height
+ * @param dist Breaking floor distribution
+ * @param stats Output statistics
+ * @return 0 on success, -1 on allocation failure
+ */
+static int run_benchmark(const BenchConfig* config, uint32_t floors, FloorDistribution dist,
+                         BenchStats* stats)
+{
+  EggDropPlan* plan = create_drop_plan(floors);
+  uint32_t* pool = (uint32_t*)malloc(BENCH_POOL_SIZE * sizeof(uint32_t));
+  double* samples = (double*)malloc(config->batches * sizeof(double));
+  if (!plan || !pool || !samples || fill_floor_pool(plan, dist, config->seed, pool, BENCH_POOL_SIZE) != 0)
+  {
+    destroy_drop_plan(plan);
+    free(pool);
+    free(samples);
+    return -1;
+  }
+  
+  memset(stats, 0, sizeof(*stats));
+  stats->floors = floors;
+  stats->dist = dist;
+  stats->optimal_drops = plan->optimal_drops;
+  
+  // Drop counts are a property of the pool, so gather them untimed
+  uint64_t pool_drops = 0;
+  for (uint32_t i = 0; i < BENCH_STATS_QUERIES; i++)
+  {
+    uint32_t drops = query_drop_plan(plan, pool[i]).drops_used;
+    pool_drops += drops;
+    if (drops > stats->max_drops) stats->max_drops = drops;
+  }
+  stats->avg_drops = (double)pool_drops / BENCH_STATS_QUERIES;
+  
+  // The pool holds a whole number of batches; batches cycle through it
+  uint32_t batch_size = config->batch_size;
+  uint32_t pool_batches = BENCH_POOL_SIZE / batch_size;
+  uint64_t drops_sink = 0;
+  int64_t deadline_ns = get_time_ns() + (int64_t)(config->max_seconds * 1e9);
+  
+  // Warm up until a window of batch timings is stable
+  double window[BENCH_WARMUP_WINDOW];
+  stats->warmup_converged = false;
+  while (stats->warmup_batches < config->max_warmup_batches && get_time_ns() < deadline_ns)
+  {
+    const uint32_t* batch = pool + (stats->warmup_batches % pool_batches) * batch_size;
+    window[stats->warmup_batches % BENCH_WARMUP_WINDOW] = time_batch(plan, batch, batch_size, &drops_sink);
+    stats->warmup_batches++;
     
-    // Run multiple iterations for more accurate timing
-    const int iterations = 10000;  // Increased for better statistics
-    double min_time_ns = INFINITY;
-    double max_time_ns = 0;
-    double avg_time_ns = 0;
-    uint32_t total_iter_drops = 0;
+    if (stats->warmup_batches >= BENCH_WARMUP_WINDOW &&
+        coefficient_of_variation(window, BENCH_WARMUP_WINDOW) < config->warmup_cv)
+    {
+      stats->warmup_converged = true;
+      break;
+    }
+  }
+  
+  // Always time at least one batch, even if the warm-up used the budget
+  deadline_ns = get_time_ns() + (int64_t)(config->max_seconds * 1e9);
+  uint32_t batches = 0;
+  do
+  {
+    const uint32_t* batch = pool + (batches % pool_batches) * batch_size;
+    samples[batches++] = time_batch(plan, batch, batch_size, &drops_sink);
+  } while (batches < config->batches && get_time_ns() < deadline_ns);
+  stats->batches = batches;
+  
+  double sum = 0.0;
+  for (uint32_t j = 0; j < batches; j++) sum += samples[j];
+  stats->mean_ns = sum / batches;
+  stats->stddev_ns = stats->mean_ns * coefficient_of_variation(samples, batches);
+  
+  qsort(samples, batches, sizeof(double), compare_doubles);
+  stats->min_ns = samples[0];
+  stats->p50_ns = percentile(samples, batches, 0.50);
+  stats->p99_ns = percentile(samples, batches, 0.99);
+  stats->p999_ns = percentile(samples, batches, 0.999);
+  stats->max_ns = samples[batches - 1];
+  
+  // Keep the timed queries observable so they cannot be optimized away
+  if (drops_sink == UINT64_MAX) printf("%" PRIu64 "\n", drops_sink);
+  
+  destroy_drop_plan(plan);
+  free(pool);
+  free(samples);
+  return 0;
+}
+
+/**
+ * Pin the calling thread to one CPU
+ * 
+ * @param cpu CPU index
+ * @return 0 on success, -1 if pinning failed or is unsupported
+ */
+static int pin_to_cpu(int cpu)
+{
+#if defined(_WIN32)
+  if (cpu >= (int)(sizeof(DWORD_PTR) * 8)) return -1;
+  return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) ? 0 : -1;
+#elif defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0 ? 0 : -1;
+#else
+  (void)cpu;
+  return -1;
+#endif
+}
+
+/**
+ * Print one result in the configured format
+ */
+static void print_bench_stats(const BenchConfig* config, const BenchStats* stats, bool first)
+{
+  const char* dist = distribution_names[stats->dist];
+  
+  if (config->format == FORMAT_JSON)
+  {
+    printf("%s\n    {\"floors\": %u, \"distribution\": \"%s\", \"optimal_drops\": %u, "
+           "\"avg_drops\": %.3f, \"max_drops\": %u, \"warmup_batches\": %u, "
+           "\"warmup_converged\": %s, \"batches\": %u, \"mean_ns\": %.3f, \"stddev_ns\": %.3f, "
+           "\"min_ns\": %.3f, \"p50_ns\": %.3f, \"p99_ns\": %.3f, \"p999_ns\": %.3f, "
+           "\"max_ns\": %.3f, \"mops\": %.3f}",
+           first ? "" : ",", stats->floors, dist, stats->optimal_drops, stats->avg_drops,
+           stats->max_drops, stats->warmup_batches, stats->warmup_converged ? "true" : "false",
+           stats->batches, stats->mean_ns, stats->stddev_ns, stats->min_ns, stats->p50_ns, stats->p99_ns,
+           stats->p999_ns, stats->max_ns, 1000.0 / stats->mean_ns);
+  }
+  else if (config->format == FORMAT_CSV)
+  {
+    printf("%u,%s,%u,%.3f,%u,%u,%d,%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+           stats->floors, dist, stats->optimal_drops, stats->avg_drops, stats->max_drops,
+           stats->warmup_batches, stats->warmup_converged ? 1 : 0, stats->batches, stats->mean_ns,
+           stats->stddev_ns, stats->min_ns, stats->p50_ns, stats->p99_ns, stats->p999_ns,
+           stats->max_ns, 1000.0 / stats->mean_ns);
+  }
+  else
+  {
+    printf("\n%u-story building, %s floors:\n", stats->floors, dist);
+    printf("  Optimal drops: %u\n", stats->optimal_drops);
+    printf("  Drops used: %.2f avg, %u max\n", stats->avg_drops, stats->max_drops);
+    printf("  Warm-up: %u batches%s\n", stats->warmup_batches,
+           stats->warmup_converged ? "" : " (did not stabilize)");
+    printf("  Timed batches: %u\n", stats->batches);
+    printf("  Time per query: %.3f ns mean, %.3f ns stddev\n", stats->mean_ns, stats->stddev_ns);
+    printf("  Percentiles: p50 %.3f ns, p99 %.3f ns, p99.9 %.3f ns\n",
+           stats->p50_ns, stats->p99_ns, stats->p999_ns);
+    printf("  Range: %.3f - %.3f ns\n", stats->min_ns, stats->max_ns);
+    printf("  Throughput: %.2f M ops/sec\n", 1000.0 / stats->mean_ns);
+  }
+}
+
+/**
+ * Benchmark the solution over the configured heights and distributions
+ * 
+ * @param config Benchmark configuration
+ * @return 0 on success, -1 on failure
+ */
+int benchmark_solution(const BenchConfig* config)
+{
+  bool pinned = config->cpu >= 0 && pin_to_cpu(config->cpu) == 0;
+  if (config->cpu >= 0 && !pinned)
+  {
+    fprintf(stderr, "Warning: could not pin to CPU %d\n", config->cpu);
+  }
+  
+  if (config->format == FORMAT_JSON)
+  {
+    printf("{\n  \"benchmark\": \"egg_drop_solver\",\n  \"ns_per_cycle\": %.6f,\n"
+           "  \"cpu\": %d,\n  \"batch_size\": %u,\n  \"max_batches\": %u,\n"
+           "  \"seed\": %" PRIu64 ",\n  \"results\": [",
+           ns_per_cycle, pinned ? config->cpu : -1, config->batch_size, config->batches,
+           config->seed);
+  }
+  else if (config->format == FORMAT_CSV)
+  {
+    printf("floors,distribution,optimal_drops,avg_drops,max_drops,warmup_batches,"
+           "warmup_converged,batches,mean_ns,stddev_ns,min_ns,p50_ns,p99_ns,p999_ns,max_ns,mops\n");
+  }
+  else
+  {
+    printf("\nPerformance Benchmark\n");
+    printf("--------------------\n");
+    printf("Batches: up to %u x %u queries, timer: %.4f ns/cycle, CPU: %s\n",
+           config->batches, config->batch_size, ns_per_cycle, pinned ? "pinned" : "unpinned");
+  }
+  
+  bool first = true;
+  for (uint32_t i = 0; i < config->num_sizes; i++)
+  {
+    for (uint32_t d = 0; d < config->num_dists; d++)
+    {
+      BenchStats stats;
+      if (run_benchmark(config, config->sizes[i], config->dists[d], &stats) != 0)
+      {
+        fprintf(stderr, "Failed to allocate benchmark buffers for %u floors\n", config->sizes[i]);
+        return -1;
+      }
+      print_bench_stats(config, &stats, first);
+      first = false;
+    }
+  }
+  
+  if (config->format == FORMAT_JSON)
+  {
+    printf("\n  ]\n}\n");
+  }
+  return 0;
+}
+
+/**
+ * One tower height whose worst case exceeds the optimal drops
+ */
+typedef struct
+{
+  uint32_t total_floors;
+  uint32_t breaking_floor;    // First floor reaching the worst case
+  uint32_t drops_used;
+  uint32_t optimal_drops;
+} VerifyViolation;
+
+/**
+ * Worst case of the current schedule, excluding the tail above the last point
+ */
+typedef struct
+{
+  uint32_t interior_drops;    // Most drops for any floor up to the last drop point
+  uint32_t interior_floor;    // First floor needing them
+  uint32_t tail_first_drops;  // First egg drops for floors above the last point
+} ScheduleWorstCase;
+
+/**
+ * Find the worst case of a drop schedule per interval instead of per floor
+ * 
+ * Between two drop points the first egg always takes the same path, so
+ * only the floor just below each point (longest second egg walk) and the
+ * point itself (first egg lands on it) can be the worst of an interval.
+ * Each is run through simulate_breaking_point, so the real search code is
+ * what gets verified.
+ */
+static ScheduleWorstCase schedule_worst_case(uint32_t optimal_drops, const uint32_t* drop_points,
+                                             uint32_t num_points)
+{
+  ScheduleWorstCase worst = {0};
+  uint32_t previous = 0;
+  
+  for (uint32_t m = 0; m < num_points; m++)
+  {
+    uint32_t top = drop_points[m];
+    if (top - previous > 1)
+    {
+      // Every floor in between costs one second egg drop more than the first
+      uint32_t first = simulate_breaking_point(previous + 1, optimal_drops, drop_points, num_points).drops_used;
+      uint32_t drops = first + (top - 2 - previous);
+      if (drops > worst.interior_drops)
+      {
+        worst.interior_drops = drops;
+        worst.interior_floor = top - 1;
+      }
+    }
     
-    // Warm-up runs to ensure CPU is at full speed
-    for (int w = 0; w < 100; w++)
+    uint32_t drops = simulate_breaking_point(top, optimal_drops, drop_points, num_points).drops_used;
+    if (drops > worst.interior_drops)
+    {
+      worst.interior_drops = drops;
+      worst.interior_floor = top;
+    }
+    previous = top;
+  }
+  
+  // Floors above the last point share its first egg path
+  worst.tail_first_drops = simulate_breaking_point(previous + 1, optimal_drops, drop_points, num_points).drops_used - 1;
+  return worst;
+}
+
+/**
+ * Most drops over every breaking floor of one height, by brute force
+ */
+static uint32_t brute_force_worst_case(uint32_t total_floors, uint32_t* worst_floor)
+{
+  EggDropPlan* plan = create_drop_plan(total_floors);
+  if (!plan) return 0;
+  
+  uint32_t worst = 0;
+  for (uint32_t b = 1; b <= total_floors; b++)
+  {
+    uint32_t drops = query_drop_plan(plan, b).drops_used;
+    if (drops > worst)
     {
-      find_breaking_point(breaking_floor, floors);
+      worst = drops;
+      *worst_floor = b;
+    }
+  }
+  destroy_drop_plan(plan);
+  return worst;
+}
+
+/**
+ * Check that no breaking floor of any height up to max_floors needs more
+ * than the optimal drops
+ * 
+ * Heights are visited in order. The drop points depend only on the step k,
+ * so they are rebuilt once per k-block, and the per-interval worst case only
+ * changes when another drop point fits below the height. In between, only
+ * the tail above the last point grows, so each height is checked in O(1).
+ * Heights up to VERIFY_CROSS_CHECK_FLOORS are also checked floor by floor.
+ * 
+ * @param max_floors Highest tower height to check
+ * @return 0 if every height is within the bound, 1 if not, -1 on internal error
+ */
+int verify_solution(uint32_t max_floors)
+{
+  printf("\nOptimality Verification\n");
+  printf("-----------------------\n");
+  
+  int64_t start_ns = get_time_ns();
+  uint32_t drop_points[MAX_DROP_POINTS];
+  uint32_t block_points = 0;
+  uint32_t num_points = 0;
+  uint32_t step = 0;
+  ScheduleWorstCase schedule = {0};
+  bool schedule_valid = false;
+  
+  VerifyViolation reported[VERIFY_MAX_REPORTED];
+  VerifyViolation largest = {0};
+  uint64_t violations = 0;
+  uint64_t tail_violations = 0;
+  uint32_t cross_checked = 0;
+  
+  for (uint64_t h = 1; h <= max_floors; h++)
+  {
+    uint32_t floors = (uint32_t)h;
+    uint32_t k = calculate_optimal_drops(floors);
+    if (k != step)
+    {
+      // All points of the k-block: P(j) <= T(k), clamped to the 32-bit range
+      uint64_t block_top = (uint64_t)k * (k + 1) / 2;
+      block_points = calculate_drop_points(block_top < UINT32_MAX ? (uint32_t)block_top : UINT32_MAX,
+                                           drop_points, MAX_DROP_POINTS);
+      step = k;
+      num_points = 0;
+      schedule_valid = false;
+    }
+    while (num_points < block_points && drop_points[num_points] <= floors)
+    {
+      num_points++;
+      schedule_valid = false;
+    }
+    if (!schedule_valid)
+    {
+      schedule = schedule_worst_case(step, drop_points, num_points);
+      schedule_valid = true;
     }
     
-    for (int j = 0; j < iterations; j++)
+    uint32_t last_point = num_points ? drop_points[num_points - 1] : 0;
+    uint32_t worst = schedule.interior_drops;
+    uint32_t worst_floor = schedule.interior_floor;
+    if (floors > last_point && schedule.tail_first_drops + (floors - last_point) > worst)
     {
-      EggDropResult result = find_breaking_point(breaking_floor, floors);
-      total_iter_drops += result.drops_used;
-      
-      if (result.execution_time_ns < min_time_ns) min_time_ns = result.execution_time_ns;
-      if (result.execution_time_ns > max_time_ns) max_time_ns = result.execution_time_ns;
-      avg_time_ns += result.execution_time_ns;
+      worst = schedule.tail_first_drops + (floors - last_point);
+      worst_floor = floors;
     }
     
-    avg_time_ns /= iterations;
-    total_time_ns += avg_time_ns;
-    total_drops += total_iter_drops;
+    if (floors <= VERIFY_CROSS_CHECK_FLOORS)
+    {
+      uint32_t brute_floor = 0;
+      uint32_t brute = brute_force_worst_case(floors, &brute_floor);
+      if (brute != worst || brute_floor != worst_floor)
+      {
+        fprintf(stderr, "Internal error at %u floors: interval check found %u drops (floor %u), "
+                "brute force %u drops (floor %u)\n", floors, worst, worst_floor, brute, brute_floor);
+        return -1;
+      }
+      cross_checked = floors;
+    }
     
-    printf("\n%u-story building:\n", floors);
-    printf("  Optimal drops: %u\n", calculate_optimal_drops(floors));
-    printf("  Avg drops used: %.2f\n", (double)total_iter_drops / iterations);
-    printf("  Min time: %.3f ns (%.6f ms)\n", min_time_ns, min_time_ns / 1000000.0);
-    printf("  Max time: %.3f ns (%.6f ms)\n", max_time_ns, max_time_ns / 1000000.0);
-    printf("  Avg time: %.3f ns (%.6f ms)\n", avg_time_ns, avg_time_ns / 1000000.0);
-    printf("  Throughput: %.2f M ops/sec\n", 1000.0 / avg_time_ns);
+    if (worst > step)
+    {
+      VerifyViolation v = {floors, worst_floor, worst, step};
+      if (violations < VERIFY_MAX_REPORTED) reported[violations] = v;
+      if (worst - step > largest.drops_used - largest.optimal_drops) largest = v;
+      if (worst_floor > last_point) tail_violations++;
+      violations++;
+    }
   }
   
-  printf("\nOverall Statistics:\n");
-  printf("  Total time: %.3f ns (%.6f ms)\n", total_time_ns, total_time_ns / 1000000.0);
-  printf("  Average drops per test: %.2f\n", (double)total_drops / (num_buildings * iterations));
+  double elapsed_s = (double)(get_time_ns() - start_ns) / 1e9;
+  printf("Heights checked: 1 - %u (%.3f s)\n", max_floors, elapsed_s);
+  printf("Cross-checked floor by floor: 1 - %u\n", cross_checked);
+  printf("Heights exceeding the optimal drops: %" PRIu64 " (%.2f%%)\n",
+         violations, max_floors ? 100.0 * (double)violations / max_floors : 0.0);
+  
+  if (violations == 0)
+  {
+    printf("Every breaking floor is found within the optimal drops.\n");
+    return 0;
+  }
+  
+  printf("  with the worst floor above the last drop point: %" PRIu64 "\n", tail_violations);
+  printf("  with the worst floor at or below it: %" PRIu64 "\n", violations - tail_violations);
+  printf("Largest excess: %u drops over the bound at %u floors (floor %u: %u/%u)\n",
+         largest.drops_used - largest.optimal_drops, largest.total_floors,
+         largest.breaking_floor, largest.drops_used, largest.optimal_drops);
+  printf("First violations:\n");
+  for (uint64_t i = 0; i < violations && i < VERIFY_MAX_REPORTED; i++)
+  {
+    printf("  %u floors: floor %u takes %u drops, optimal %u\n", reported[i].total_floors,
+           reported[i].breaking_floor, reported[i].drops_used, reported[i].optimal_drops);
+  }
+  return 1;
 }
 
 /**
@@ -278,9 +1005,197 @@ void demonstrate_solution(void)
   }
 }
 
-int main(void)
+/**
+ * Print command line usage
+ */
+static void print_usage(const char* program)
 {
-  demonstrate_solution();
-  benchmark_solution();
+  printf("Usage: %s [--bench] [options]\n", program);
+  printf("       %s --verify N\n\n", program);
+  printf("Without --bench the demo runs, followed by a default benchmark.\n");
+  printf("--verify checks every breaking floor of every height up to N\n");
+  printf("against the optimal drops and exits with 1 if any exceeds it.\n\n");
+  printf("Benchmark options:\n");
+  printf("  --sizes N[,N...]      Building heights (default 100,1000,10000,100000,1000000)\n");
+  printf("  --dist D[,D...]       uniform, worst, adversarial or all (default all)\n");
+  printf("  --batch-size N        Queries per timed batch (default %d, max %d)\n", BENCH_BATCH_SIZE, BENCH_POOL_SIZE);
+  printf("  --batches N           Timed batches per run (default %d)\n", BENCH_BATCHES);
+  printf("  --warmup-batches N    Warm-up limit in batches (default %d)\n", BENCH_MAX_WARMUP_BATCHES);
+  printf("  --warmup-cv X         Warm-up stability target (default %.2f)\n", BENCH_WARMUP_CV);
+  printf("  --max-seconds X       Time budget per run (default %.1f)\n", BENCH_MAX_SECONDS);
+  printf("  --cpu N               Pin the benchmark to CPU N\n");
+  printf("  --seed N              Seed for the breaking floor generator (default 1)\n");
+  printf("  --format F            text, json or csv (default text)\n");
+}
+
+/**
+ * Parse a comma-separated list of building heights
+ */
+static int parse_sizes(const char* arg, BenchConfig* config)
+{
+  config->num_sizes = 0;
+  while (*arg)
+  {
+    char* end;
+    unsigned long long value = strtoull(arg, &end, 10);
+    if (end == arg || value == 0 || value > UINT32_MAX || config->num_sizes == BENCH_MAX_SIZES)
+    {
+      return -1;
+    }
+    config->sizes[config->num_sizes++] = (uint32_t)value;
+    if (*end == ',') end++;
+    else if (*end) return -1;
+    arg = end;
+  }
+  return config->num_sizes > 0 ? 0 : -1;
+}
+
+/**
+ * Parse a comma-separated list of distribution names
+ */
+static int parse_distributions(const char* arg, BenchConfig* config)
+{
+  config->num_dists = 0;
+  while (*arg)
+  {
+    size_t len = strcspn(arg, ",");
+    if (len == 3 && strncmp(arg, "all", 3) == 0)
+    {
+      config->num_dists = 0;
+      for (uint32_t d = 0; d < 3; d++) config->dists[config->num_dists++] = (FloorDistribution)d;
+    }
+    else
+    {
+      uint32_t d = 0;
+      while (d < 3 && !(strlen(distribution_names[d]) == len && strncmp(arg, distribution_names[d], len) == 0))
+      {
+        d++;
+      }
+      if (d == 3 || config->num_dists == 3) return -1;
+      config->dists[config->num_dists++] = (FloorDistribution)d;
+    }
+    arg += len;
+    if (*arg == ',') arg++;
+  }
+  return config->num_dists > 0 ? 0 : -1;
+}
+
+/**
+ * Parse a positive 32-bit count
+ */
+static int parse_count(const char* arg, uint32_t max_value, uint32_t* out)
+{
+  char* end;
+  unsigned long long value = strtoull(arg, &end, 10);
+  if (end == arg || *end || value == 0 || value > max_value) return -1;
+  *out = (uint32_t)value;
   return 0;
-}
\ No newline at end of file
+}
+
+int main(int argc, char** argv)
+{
+  BenchConfig config = {
+    .sizes = {100, 1000, 10000, 100000, 1000000},
+    .num_sizes = 5,
+    .dists = {DIST_UNIFORM, DIST_WORST, DIST_ADVERSARIAL},
+    .num_dists = 3,
+    .batch_size = BENCH_BATCH_SIZE,
+    .batches = BENCH_BATCHES,
+    .max_warmup_batches = BENCH_MAX_WARMUP_BATCHES,
+    .warmup_cv = BENCH_WARMUP_CV,
+    .max_seconds = BENCH_MAX_SECONDS,
+    .cpu = -1,
+    .seed = 1,
+    .format = FORMAT_TEXT
+  };
+  bool bench_only = false;
+  uint32_t verify_floors = 0;
+  
+  for (int i = 1; i < argc; i++)
+  {
+    const char* opt = argv[i];
+    const char* arg = (i + 1 < argc) ? argv[i + 1] : NULL;
+    int status = 0;
+    
+    if (strcmp(opt, "--bench") == 0)
+    {
+      bench_only = true;
+      continue;
+    }
+    if (strcmp(opt, "--help") == 0 || strcmp(opt, "-h") == 0)
+    {
+      print_usage(argv[0]);
+      return 0;
+    }
+    if (!arg)
+    {
+      fprintf(stderr, "Missing value for %s\n", opt);
+      return 1;
+    }
+    
+    if (strcmp(opt, "--verify") == 0) status = parse_count(arg, UINT32_MAX, &verify_floors);
+    else if (strcmp(opt, "--sizes") == 0) status = parse_sizes(arg, &config);
+    else if (strcmp(opt, "--dist") == 0) status = parse_distributions(arg, &config);
+    else if (strcmp(opt, "--batch-size") == 0) status = parse_count(arg, BENCH_POOL_SIZE, &config.batch_size);
+    else if (strcmp(opt, "--batches") == 0) status = parse_count(arg, UINT32_MAX / sizeof(double), &config.batches);
+    else if (strcmp(opt, "--warmup-batches") == 0) status = parse_count(arg, UINT32_MAX, &config.max_warmup_batches);
+    else if (strcmp(opt, "--warmup-cv") == 0)
+    {
+      char* end;
+      config.warmup_cv = strtod(arg, &end);
+      status = (end == arg || *end || !(config.warmup_cv > 0.0)) ? -1 : 0;
+    }
+    else if (strcmp(opt, "--max-seconds") == 0)
+    {
+      char* end;
+      config.max_seconds = strtod(arg, &end);
+      status = (end == arg || *end || !(config.max_seconds > 0.0)) ? -1 : 0;
+    }
+    else if (strcmp(opt, "--cpu") == 0)
+    {
+      char* end;
+      long cpu = strtol(arg, &end, 10);
+      status = (end == arg || *end || cpu < 0 || cpu > 4095) ? -1 : 0;
+      config.cpu = (int)cpu;
+    }
+    else if (strcmp(opt, "--seed") == 0)
+    {
+      char* end;
+      config.seed = strtoull(arg, &end, 10);
+      status = (end == arg || *end) ? -1 : 0;
+    }
+    else if (strcmp(opt, "--format") == 0)
+    {
+      if (strcmp(arg, "text") == 0) config.format = FORMAT_TEXT;
+      else if (strcmp(arg, "json") == 0) config.format = FORMAT_JSON;
+      else if (strcmp(arg, "csv") == 0) config.format = FORMAT_CSV;
+      else status = -1;
+    }
+    else
+    {
+      fprintf(stderr, "Unknown option: %s\n", opt);
+      print_usage(argv[0]);
+      return 1;
+    }
+    
+    if (status != 0)
+    {
+      fprintf(stderr, "Invalid value for %s: %s\n", opt, arg);
+      return 1;
+    }
+    i++;
+  }
+  
+  if (verify_floors > 0)
+  {
+    int status = verify_solution(verify_floors);
+    return status < 0 ? 2 : status;
+  }
+  
+  calibrate_cycle_counter();
+  if (!bench_only)
+  {
+    demonstrate_solution();
+  }
+  return benchmark_solution(&config) == 0 ? 0 : 1;
+}
@@ -153,22 +153,19 @@ class GameOfLifeDemo:
         self.ax_main.set_yticks([])
         self.ax_main.set_facecolor('#000000')
         
-        if self.game.grid.live:
-            rows, cols = zip(*self.game.grid.live)
-            min_r, max_r = min(rows) - 1, max(rows) + 1
-            min_c, max_c = min(cols) - 1, max(cols) + 1
+        bounds = self.game.grid.bounds
+        if bounds:
+            min_r, max_r = bounds[0] - 1, bounds[1] + 1
+            min_c, max_c = bounds[2] - 1, bounds[3] + 1
         else:
             min_r = min_c = -10
             max_r = max_c = 10
             
-        grid_array = np.zeros((max_r - min_r + 1, max_c - min_c + 1))
-        
-        # Update live cells with rainbow colors
-        for r, c in self.game.grid.live:
-            rainbow_val = ((r - min_r) / (max_r - min_r + 1) + 
-                         (c - min_c) / (max_c - min_c + 1) + 
-                         self.generation / 50) % 1
-            grid_array[r - min_r, c - min_c] = rainbow_val * 0.8 + 0.2
+        # Live cells get rainbow colors, computed for the whole viewport at once
+        alive = self.game.to_numpy((min_r, max_r, min_c, max_c))
+        rows, cols = np.indices(alive.shape)
+        rainbow_val = (rows / alive.shape[0] + cols / alive.shape[1] + self.generation / 50) % 1
+        grid_array = np.where(alive, rainbow_val * 0.8 + 0.2, 0.0)
             
         img = self.ax_main.imshow(grid_array, cmap=self.cmap, interpolation='nearest')
         self.ax_main.set_title(f'Generation {self.generation} - Population: {len(self.game.grid.live)}',
@@ -170,10 +170,10 @@ class GameOfLifeDemo:
         # Restore grid state
         self.ax_main.grid(self.check_grid.get_status()[0], color='gray', alpha=0.3)
         
-        if self.game.grid.live:
-            rows, cols = zip(*self.game.grid.live)
-            min_r, max_r = min(rows) - 1, max(rows) + 1
-            min_c, max_c = min(cols) - 1, max(cols) + 1
+        bounds = self.game.grid.bounds
+        if bounds:
+            min_r, max_r = bounds[0] - 1, bounds[1] + 1
+            min_c, max_c = bounds[2] - 1, bounds[3] + 1
         else:
             min_r = min_c = -10
             max_r = max_c = 10
@@ -1,33 +1,81 @@
-from typing import Iterable, Set, Tuple, List, FrozenSet
+import os
+from itertools import chain
+from typing import Iterable, Tuple, List, FrozenSet, Optional
+
+from .life_hybrid import HashLifeBoard, NativeBoard, TiledBoard, get_life_lib
 
 Cell = Tuple[int, int]
 
 
+def parse_rule(rule: str) -> Tuple[FrozenSet[int], FrozenSet[int]]:
+    """Parse a Life-like rule such as 'B36/S23', 'S23/B36' or the older '23/36' (survive/birth).
+
+    Returns:
+        (birth, survive): neighbour counts at which a dead cell is born and a live cell survives
+    """
+    parts = ''.join(rule.split()).upper().split('/')
+    marks = [part[:1] for part in parts]
+    if len(parts) == 2 and sorted(marks) == ['B', 'S']:
+        birth, survive = (part[1:] for part in sorted(parts))
+    elif len(parts) == 2 and not {'B', 'S'} & set(marks):
+        survive, birth = parts
+    else:
+        raise ValueError(f"Invalid rule {rule!r}, expected B/S notation such as 'B3/S23'")
+    if any(ch not in '012345678' for ch in birth + survive):
+        raise ValueError(f"Invalid rule {rule!r}: neighbour counts are 0-8")
+    if '0' in birth:
+        raise ValueError(f"Unsupported rule {rule!r}: B0 would fill the infinite plane")
+    return frozenset(map(int, birth)), frozenset(map(int, survive))
+
+
+def format_rule(birth: Iterable[int], survive: Iterable[int]) -> str:
+    """Canonical B/S string, e.g. 'B36/S23'."""
+    return 'B' + ''.join(map(str, sorted(birth))) + '/S' + ''.join(map(str, sorted(survive)))
+
+
+def _rule_masks(birth: Iterable[int], survive: Iterable[int]) -> Tuple[int, int]:
+    """Neighbour-count bit masks, as taken by the C engines."""
+    return sum(1 << k for k in birth), sum(1 << k for k in survive)
+
+
+def _pattern_writer(path) -> str:
+    """TiledBoard/HashLifeBoard method that writes the format named by path's extension."""
+    return 'write_macrocell' if os.fsdecode(path).lower().endswith('.mc') else 'write_rle'
+
+
 class Grid:
     """Sparse representation of an infinite grid using a set of live cell coordinates.
 
     Stores only live cells as tuples (row, col). Provides helpers to
-    construct from 2D lists and to export a bounded 2D list.
+    construct from 2D lists and to export a bounded 2D list or numpy array.
+    A Grid is immutable: the live cells are frozen once at construction, so
+    reading them never copies.
     """
     
-    __slots__ = ('_live',)
+    __slots__ = ('_live', '_bounds')
 
     def __init__(self, live: Iterable[Cell] = ()):  # pragma: no cover - trivial
-        self._live: Set[Cell] = set(live)
+        # frozenset() of a frozenset returns it as is, so Grids share cell sets
+        self._live: FrozenSet[Cell] = frozenset(live)
+        self._bounds: Optional[Tuple[int, int, int, int]] = None
 
     @property
     def live(self) -> FrozenSet[Cell]:
-        """Get the immutable set of live cells."""
-        return frozenset(self._live)
+        """Get the immutable set of live cells (no copy is made)."""
+        return self._live
+
+    @property
+    def bounds(self) -> Optional[Tuple[int, int, int, int]]:
+        """Tight (min_r, max_r, min_c, max_c) around the live cells, None if empty."""
+        if self._bounds is None and self._live:
+            rows = [r for r, _ in self._live]
+            cols = [c for _, c in self._live]
+            self._bounds = (min(rows), max(rows), min(cols), max(cols))
+        return self._bounds
 
     @classmethod
     def from_2d_list(cls, data: List[List[int]]) -> "Grid":
-        live = set()
-        for r, row in enumerate(data):
-            for c, v in enumerate(row):
-                if v:
-                    live.add((r, c))
-        return cls(live)
+        return cls((r, c) for r, row in enumerate(data) for c, v in enumerate(row) if v)
 
     def to_2d_list(self, bounds: Tuple[int, int, int, int] = None) -> List[List[int]]:
         """Return a 2D list representation.
@@ -38,68 +86,277 @@ class Grid:
         Returns:
             List[List[int]]: 2D grid with 1 for live cells, 0 for dead cells
         """
-        live_cells: FrozenSet[Cell] = self.live
-        
-        if not live_cells:
+        if bounds is None:
+            bounds = self.bounds
             if bounds is None:
                 return []
-            width: int = bounds[3] - bounds[2] + 1
-            height: int = bounds[1] - bounds[0] + 1
-            return [[0] * width for _ in range(height)]
+        min_r, max_r, min_c, max_c = bounds
+
+        out = [[0] * (max_c - min_c + 1) for _ in range(max_r - min_r + 1)]
+        for r, c in self._live:
+            if min_r <= r <= max_r and min_c <= c <= max_c:
+                out[r - min_r][c - min_c] = 1
+        return out
+
+    def to_numpy(self, bounds: Tuple[int, int, int, int] = None):
+        """Return a numpy uint8 array with 1 for live cells.
+
+        Args:
+            bounds: (min_r, max_r, min_c, max_c). If None, compute tight bounds around live cells.
+        """
+        import numpy as np
 
         if bounds is None:
-            rows: List[int] = [r for r, _ in live_cells]
-            cols: List[int] = [c for _, c in live_cells]
-            min_r, max_r = min(rows), max(rows)
-            min_c, max_c = min(cols), max(cols)
-        else:
-            min_r, max_r, min_c, max_c = bounds
-
-        out = []
-        for r in range(min_r, max_r + 1):
-            row = []
-            for c in range(min_c, max_c + 1):
-                row.append(1 if (r, c) in self.live else 0)
-            out.append(row)
+            bounds = self.bounds
+            if bounds is None:
+                return np.zeros((0, 0), dtype=np.uint8)
+        min_r, max_r, min_c, max_c = bounds
+
+        out = np.zeros((max(max_r - min_r + 1, 0), max(max_c - min_c + 1, 0)), dtype=np.uint8)
+        if self._live:
+            cells = np.fromiter(chain.from_iterable(self._live), dtype=np.int64,
+                                count=2 * len(self._live)).reshape(-1, 2)
+            rows = cells[:, 0] - min_r
+            cols = cells[:, 1] - min_c
+            inside = (rows >= 0) & (rows < out.shape[0]) & (cols >= 0) & (cols < out.shape[1])
+            out[rows[inside], cols[inside]] = 1
         return out
 
+    @classmethod
+    def from_file(cls, path) -> "Grid":
+        """Read an RLE or Macrocell file, keeping any position it records."""
+        board = TiledBoard()
+        try:
+            board.read_pattern(path)
+            return cls(board.cells())
+        finally:
+            board.close()
+
+    def save(self, path) -> None:
+        """Write the cells as Macrocell if path ends in .mc, else as extended RLE."""
+        board = TiledBoard(self._live)
+        try:
+            getattr(board, _pattern_writer(path))(path)
+        finally:
+            board.close()
+
     def __contains__(self, cell: Cell) -> bool:
-        return cell in self.live
+        return cell in self._live
 
     def copy(self) -> "Grid":
-        return Grid(set(self.live))
+        # Immutable, so a copy can share the cell set
+        return Grid(self._live)
 
 
 class Game:
     """Encapsulates Game of Life rules and iteration.
 
-    Uses Conway's rules:
-      - Any live cell with 2 or 3 live neighbours survives.
-      - Any dead cell with exactly 3 live neighbours becomes a live cell.
+    Runs any Life-like rule given in B/S notation, Conway's B3/S23 by default:
+      - B3: any dead cell with exactly 3 live neighbours becomes a live cell.
+      - S23: any live cell with 2 or 3 live neighbours survives.
       - All other live cells die in the next generation. Similarly, all other dead cells stay dead.
+    Other examples are HighLife 'B36/S23', Seeds 'B2/S' and Day & Night
+    'B3678/S34678'. The C engines step common rules with kernels compiled
+    for them and any other rule with a generic bit-sliced kernel; B0 rules
+    are not supported.
+
+    Backends:
+      - 'python': sparse set-based stepping in pure Python (the default).
+      - 'native': bit-packed C engine (life_lib.c), 64 cells per word.
+      - 'tiled': the same kernel on 64x64 tiles in a hash map; tiles whose
+        neighbourhood is still or period-2 are skipped, so a generation costs
+        in proportion to activity rather than population.
+      - 'hashlife': memoized quadtree in C; run(steps) takes O(log steps)
+        jumps, best for periodic or glider-heavy patterns over long horizons.
+      - 'auto': 'tiled' when the C library can be loaded, else 'python'.
+
+    The C engines are opt-in, so a Game never needs a compiler unless one
+    of them is asked for.
+
+    The 'native' engine steps row bands in parallel and 'tiled' shares the
+    active tiles out by work stealing; pass threads= to size the pool.
+
+    Patterns load from RLE or Macrocell files with from_file and save with
+    save; long runs can checkpoint periodically and resume with
+    from_checkpoint. The C engines read and write files in place, the
+    others go through a temporary tiled board.
     """
     
-    __slots__ = ('_grid', '_bounds_cache')
+    __slots__ = ('_grid', '_bounds_cache', '_backend', '_board', '_memory_limit', '_threads',
+                 '_generation', '_birth', '_survive')
+
+    BACKENDS: Tuple[str, ...] = ('auto', 'python', 'native', 'tiled', 'hashlife')
 
-    SURVIVE_MIN: int = 2
-    SURVIVE_MAX: int = 3
-    BIRTH_COUNT: int = 3
-    
     NEIGHBORS: FrozenSet[Cell] = frozenset([
         (-1, -1), (-1, 0), (-1, 1),
         (0, -1),           (0, 1),
         (1, -1),  (1, 0),  (1, 1),
     ])
 
-    def __init__(self, grid: Grid = None):
-        self._grid = grid or Grid()
+    def __init__(self, grid: Grid = None, backend: str = 'python', memory_limit: Optional[int] = None,
+                 threads: Optional[int] = None, rule: str = 'B3/S23'):
+        """
+        Args:
+            grid: Initial state
+            backend: One of BACKENDS
+            memory_limit: HashLife node cache limit in bytes (None for the 1 GiB
+                default); at least HashLifeBoard.min_memory_limit(), about 4.7 MB
+            threads: Worker threads for the 'native' and 'tiled' backends
+                (None for the OpenMP default, 1 for serial stepping)
+            rule: Life-like rule in B/S notation, see parse_rule
+        """
+        if threads is not None and threads < 1:
+            raise ValueError("threads must be a positive integer or None")
+        self._birth, self._survive = parse_rule(rule)
+        self._grid: Optional[Grid] = grid or Grid()
         self._bounds_cache: Tuple[int, int, int, int] | None = None
+        self._backend: str = 'python'
+        self._board: Optional[NativeBoard | TiledBoard | HashLifeBoard] = None
+        self._memory_limit = memory_limit
+        self._threads = threads
+        self._generation = 0
+        self.set_backend(backend)
+
+    @classmethod
+    def from_file(cls, path, backend: str = 'python', **kwargs) -> "Game":
+        """Start a game from an RLE or Macrocell file, at the generation it records.
+
+        Keyword arguments are passed to Game().
+        """
+        game = cls(backend=backend, **kwargs)
+        game._load('read_pattern', path)
+        return game
+
+    @classmethod
+    def from_checkpoint(cls, path, backend: str = 'python', **kwargs) -> "Game":
+        """Resume a game saved by save_checkpoint or a checkpointed run."""
+        game = cls(backend=backend, **kwargs)
+        game._load('load_checkpoint', path)
+        return game
+
+    def _load(self, method: str, path) -> None:
+        # The file's rule replaces the game's
+        if isinstance(self._board, (TiledBoard, HashLifeBoard)):
+            self._generation = getattr(self._board, method)(path)
+            birth, survive = self._board.rule
+            self._grid = None
+        else:
+            board = TiledBoard()
+            try:
+                self._generation = getattr(board, method)(path)
+                birth, survive = board.rule
+                self._grid = Grid(board.cells())
+            finally:
+                board.close()
+            if self._board is not None:
+                self._board.set_cells(self._grid.live)
+                self._board.set_rule(birth, survive)
+        self._birth = frozenset(k for k in range(9) if birth >> k & 1)
+        self._survive = frozenset(k for k in range(9) if survive >> k & 1)
+        self._bounds_cache = None
+
+    def _store(self, method: str, path) -> None:
+        if isinstance(self._board, (TiledBoard, HashLifeBoard)):
+            getattr(self._board, method)(path, self._generation)
+            return
+        board = TiledBoard(self.grid.live)
+        try:
+            board.set_rule(*_rule_masks(self._birth, self._survive))
+            getattr(board, method)(path, self._generation)
+        finally:
+            board.close()
+
+    def save(self, path) -> None:
+        """Write the current generation as Macrocell if path ends in .mc, else as extended RLE."""
+        self._store(_pattern_writer(path), path)
+
+    def save_checkpoint(self, path) -> None:
+        """Write a binary checkpoint, replacing path atomically."""
+        tmp_path = os.fsdecode(path) + '.tmp'
+        self._store('save_checkpoint', tmp_path)
+        os.replace(tmp_path, path)
 
     @property
     def grid(self) -> Grid:
         """Get the current grid state."""
+        if self._grid is None:
+            # Native state is only converted to a Grid when it is looked at
+            self._grid = Grid(self._board.cells())
         return self._grid
 
+    @property
+    def generation(self) -> int:
+        """Generations advanced, counting from the generation a file was loaded at."""
+        return self._generation
+
+    @property
+    def rule(self) -> str:
+        """Current rule in canonical B/S notation, e.g. 'B3/S23'."""
+        return format_rule(self._birth, self._survive)
+
+    @rule.setter
+    def rule(self, rule: str) -> None:
+        self._birth, self._survive = parse_rule(rule)
+        if self._board is not None:
+            self._board.set_rule(*_rule_masks(self._birth, self._survive))
+
+    @property
+    def backend(self) -> str:
+        """Name of the active backend: 'python', 'native', 'tiled' or 'hashlife'."""
+        return self._backend
+
+    @property
+    def threads(self) -> Optional[int]:
+        """Worker threads requested for the C backends (None for the OpenMP default)."""
+        return self._threads
+
+    @threads.setter
+    def threads(self, threads: Optional[int]) -> None:
+        if threads is not None and threads < 1:
+            raise ValueError("threads must be a positive integer or None")
+        self._threads = threads
+        if self._board is not None:
+            self._board.set_threads(threads)
+
+    def set_backend(self, backend: str) -> None:
+        """Switch backends, carrying the current generation over."""
+        if backend not in Game.BACKENDS:
+            raise ValueError(f"Unknown backend {backend!r}, expected one of {Game.BACKENDS}")
+        if backend == 'auto':
+            try:
+                get_life_lib()
+                backend = 'tiled'
+            except RuntimeError:
+                backend = 'python'
+
+        if backend == self._backend:
+            return
+
+        grid = self.grid
+        if self._board is not None:
+            self._board.close()
+            self._board = None
+        if backend == 'native':
+            self._board = NativeBoard(grid.live)
+        elif backend == 'tiled':
+            self._board = TiledBoard(grid.live)
+        elif backend == 'hashlife':
+            self._board = HashLifeBoard(grid.live, self._memory_limit)
+        if self._board is not None:
+            self._board.set_threads(self._threads)
+            self._board.set_rule(*_rule_masks(self._birth, self._survive))
+        self._backend = backend
+
+    def to_numpy(self, bounds: Tuple[int, int, int, int] = None):
+        """Return the current generation as a numpy uint8 array, see Grid.to_numpy.
+
+        With explicit bounds the C backends render the viewport directly,
+        without building a Grid.
+        """
+        if bounds is not None and self._board is not None:
+            return self._board.render(bounds)
+        return self.grid.to_numpy(bounds)
+
     def count_neighbors(self, live_cells: FrozenSet[Cell]) -> dict[Cell, int]:
         """Count neighbors for all cells adjacent to live cells."""
         neighbor_counts: dict[Cell, int] = {}
@@ -114,27 +371,60 @@ class Game:
         return neighbor_counts
 
     def apply_rules(self, cell: Cell, count: int, is_alive: bool) -> bool:
-        """Apply Conway's rules to determine if a cell lives or dies."""
-        if is_alive:
-            return Game.SURVIVE_MIN <= count <= Game.SURVIVE_MAX
-        return count == Game.BIRTH_COUNT
+        """Apply the rule to determine if a cell lives or dies."""
+        return count in (self._survive if is_alive else self._birth)
 
     def step(self) -> Grid:
         """Advance the game by one generation and return the new Grid."""
+        self._generation += 1
+        if self._board is not None:
+            self._board.step(1)
+            self._grid = None
+            self._bounds_cache = None
+            return self.grid
+
         live_cells = self.grid.live
         neighbor_counts = self.count_neighbors(live_cells)
 
-        new_live = {
+        new_live = frozenset(
             cell for cell, count in neighbor_counts.items()
             if self.apply_rules(cell, count, cell in live_cells)
-        }
+        )
 
         self._grid = Grid(new_live)
         self._bounds_cache = None  # Invalidate bounds cache
         return self.grid
 
-    def run(self, steps: int) -> Grid:
-        """Run the game for given number of steps and return final Grid."""
+    def run(self, steps: int, checkpoint_path=None, checkpoint_interval: Optional[int] = None) -> Grid:
+        """Run the game for given number of steps and return final Grid.
+
+        Args:
+            steps: Generations to advance
+            checkpoint_path: If given, save_checkpoint here every
+                checkpoint_interval generations and at the end
+            checkpoint_interval: Generations between checkpoints (None for
+                only the final one)
+        """
+        if checkpoint_path is not None:
+            if checkpoint_interval is not None and checkpoint_interval < 1:
+                raise ValueError("checkpoint_interval must be a positive integer or None")
+            remaining = steps
+            while remaining > 0:
+                chunk = min(remaining, checkpoint_interval or remaining)
+                self.run(chunk)
+                self.save_checkpoint(checkpoint_path)
+                remaining -= chunk
+            return self.grid
+
+        if self._board is not None:
+            # All generations run in C; the Grid is built once at the end
+            if steps > 0:
+                self._board.step(steps)
+                self._generation += steps
+                self._grid = None
+                self._bounds_cache = None
+            return self.grid
+
         for _ in range(steps):
             self.step()
         return self.grid
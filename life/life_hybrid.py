@@ -0,0 +1,437 @@
+"""ctypes bindings for the C engines in life_lib.c"""
+
+import ctypes
+import os
+import sys
+from typing import Iterable, List, Optional, Tuple
+
+try:
+    import native_build
+except ImportError:
+    # Running from a checkout: the build helper sits at the repository root
+    sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+    import native_build
+
+
+Cell = Tuple[int, int]
+
+# Load the C library
+def load_life_lib() -> ctypes.CDLL:
+    """Load the compiled C library, building it on first use"""
+    script_dir = os.path.dirname(os.path.abspath(__file__))
+
+    lib_path = native_build.native_lib_path(script_dir, 'life_lib')
+
+    try:
+        lib = ctypes.CDLL(lib_path)
+    except Exception as e:
+        raise RuntimeError(f"Failed to load C library: {e}")
+
+    # Set up function signatures
+    lib.life_board_create.argtypes = []
+    lib.life_board_create.restype = ctypes.c_void_p
+
+    lib.life_board_destroy.argtypes = [ctypes.c_void_p]
+    lib.life_board_destroy.restype = None
+
+    lib.life_board_set_cells.argtypes = [
+        ctypes.c_void_p,                  # board
+        ctypes.POINTER(ctypes.c_int64),   # cells, (row, col) pairs
+        ctypes.c_size_t                   # n_cells
+    ]
+    lib.life_board_set_cells.restype = ctypes.c_int
+
+    lib.life_board_step.argtypes = [ctypes.c_void_p, ctypes.c_uint64]
+    lib.life_board_step.restype = ctypes.c_int
+
+    lib.life_board_set_threads.argtypes = [ctypes.c_void_p, ctypes.c_int]
+    lib.life_board_set_threads.restype = ctypes.c_int
+
+    lib.life_board_population.argtypes = [ctypes.c_void_p]
+    lib.life_board_population.restype = ctypes.c_uint64
+
+    lib.life_board_generation.argtypes = [ctypes.c_void_p]
+    lib.life_board_generation.restype = ctypes.c_uint64
+
+    lib.life_board_get_cells.argtypes = [
+        ctypes.c_void_p,                  # board
+        ctypes.POINTER(ctypes.c_int64),   # cells_out
+        ctypes.c_uint64                   # capacity
+    ]
+    lib.life_board_get_cells.restype = ctypes.c_uint64
+
+    lib.life_board_render.argtypes = [
+        ctypes.c_void_p,                  # board
+        ctypes.c_int64,                   # row0
+        ctypes.c_int64,                   # col0
+        ctypes.c_int64,                   # height
+        ctypes.c_int64,                   # width
+        ctypes.c_void_p                   # out, height * width uint8
+    ]
+    lib.life_board_render.restype = ctypes.c_int
+
+    # Tiled sparse board
+    lib.life_tiled_create.argtypes = []
+    lib.life_tiled_create.restype = ctypes.c_void_p
+
+    lib.life_tiled_destroy.argtypes = [ctypes.c_void_p]
+    lib.life_tiled_destroy.restype = None
+
+    lib.life_tiled_set_cells.argtypes = [
+        ctypes.c_void_p,                  # board
+        ctypes.POINTER(ctypes.c_int64),   # cells, (row, col) pairs
+        ctypes.c_size_t                   # n_cells
+    ]
+    lib.life_tiled_set_cells.restype = ctypes.c_int
+
+    lib.life_tiled_step.argtypes = [ctypes.c_void_p, ctypes.c_uint64]
+    lib.life_tiled_step.restype = ctypes.c_int
+
+    lib.life_tiled_set_threads.argtypes = [ctypes.c_void_p, ctypes.c_int]
+    lib.life_tiled_set_threads.restype = ctypes.c_int
+
+    lib.life_tiled_population.argtypes = [ctypes.c_void_p]
+    lib.life_tiled_population.restype = ctypes.c_uint64
+
+    lib.life_tiled_generation.argtypes = [ctypes.c_void_p]
+    lib.life_tiled_generation.restype = ctypes.c_uint64
+
+    lib.life_tiled_get_cells.argtypes = [
+        ctypes.c_void_p,                  # board
+        ctypes.POINTER(ctypes.c_int64),   # cells_out
+        ctypes.c_uint64                   # capacity
+    ]
+    lib.life_tiled_get_cells.restype = ctypes.c_uint64
+
+    lib.life_tiled_render.argtypes = [
+        ctypes.c_void_p,                  # board
+        ctypes.c_int64,                   # row0
+        ctypes.c_int64,                   # col0
+        ctypes.c_int64,                   # height
+        ctypes.c_int64,                   # width
+        ctypes.c_void_p                   # out, height * width uint8
+    ]
+    lib.life_tiled_render.restype = ctypes.c_int
+
+    lib.life_tiled_stats.argtypes = [
+        ctypes.c_void_p,                  # board
+        ctypes.POINTER(ctypes.c_uint64),  # tiles_out
+        ctypes.POINTER(ctypes.c_uint64),  # active_out
+        ctypes.POINTER(ctypes.c_uint64)   # flipped_out
+    ]
+    lib.life_tiled_stats.restype = None
+
+    # HashLife universe
+    lib.hashlife_create.argtypes = [ctypes.c_uint64]  # memory_bytes
+    lib.hashlife_create.restype = ctypes.c_void_p
+
+    lib.hashlife_destroy.argtypes = [ctypes.c_void_p]
+    lib.hashlife_destroy.restype = None
+
+    lib.hashlife_set_memory_limit.argtypes = [ctypes.c_void_p, ctypes.c_uint64]
+    lib.hashlife_set_memory_limit.restype = None
+
+    lib.hashlife_min_memory_limit.argtypes = []
+    lib.hashlife_min_memory_limit.restype = ctypes.c_uint64
+
+    lib.hashlife_set_cells.argtypes = [
+        ctypes.c_void_p,                  # universe
+        ctypes.POINTER(ctypes.c_int64),   # cells, (row, col) pairs
+        ctypes.c_size_t                   # n_cells
+    ]
+    lib.hashlife_set_cells.restype = ctypes.c_int
+
+    lib.hashlife_step.argtypes = [ctypes.c_void_p, ctypes.c_uint64]
+    lib.hashlife_step.restype = ctypes.c_int
+
+    lib.hashlife_population.argtypes = [ctypes.c_void_p]
+    lib.hashlife_population.restype = ctypes.c_uint64
+
+    lib.hashlife_generation.argtypes = [ctypes.c_void_p]
+    lib.hashlife_generation.restype = ctypes.c_uint64
+
+    lib.hashlife_get_cells.argtypes = [
+        ctypes.c_void_p,                  # universe
+        ctypes.POINTER(ctypes.c_int64),   # cells_out
+        ctypes.c_uint64                   # capacity
+    ]
+    lib.hashlife_get_cells.restype = ctypes.c_uint64
+
+    lib.hashlife_render.argtypes = [
+        ctypes.c_void_p,                  # universe
+        ctypes.c_int64,                   # row0
+        ctypes.c_int64,                   # col0
+        ctypes.c_int64,                   # height
+        ctypes.c_int64,                   # width
+        ctypes.c_void_p                   # out, height * width uint8
+    ]
+    lib.hashlife_render.restype = ctypes.c_int
+
+    lib.hashlife_memory_stats.argtypes = [
+        ctypes.c_void_p,                  # universe
+        ctypes.POINTER(ctypes.c_uint64),  # nodes_out
+        ctypes.POINTER(ctypes.c_uint64),  # bytes_out
+        ctypes.POINTER(ctypes.c_uint64)   # gc_runs_out
+    ]
+    lib.hashlife_memory_stats.restype = None
+
+    # Rules
+    for prefix in ('life_board', 'life_tiled', 'hashlife'):
+        func = getattr(lib, f'{prefix}_set_rule')
+        func.argtypes = [
+            ctypes.c_void_p,                  # board or universe
+            ctypes.c_uint16,                  # birth mask
+            ctypes.c_uint16                   # survive mask
+        ]
+        func.restype = ctypes.c_int
+
+        func = getattr(lib, f'{prefix}_get_rule')
+        func.argtypes = [
+            ctypes.c_void_p,                  # board or universe
+            ctypes.POINTER(ctypes.c_uint16),  # birth_out
+            ctypes.POINTER(ctypes.c_uint16)   # survive_out
+        ]
+        func.restype = None
+
+    # Pattern files and checkpoints
+    for prefix in ('life_tiled', 'hashlife'):
+        for name in ('read_pattern', 'load_checkpoint'):
+            func = getattr(lib, f'{prefix}_{name}')
+            func.argtypes = [
+                ctypes.c_void_p,                  # board or universe
+                ctypes.c_char_p,                  # path
+                ctypes.POINTER(ctypes.c_uint64)   # generation_out
+            ]
+            func.restype = ctypes.c_int
+        for name in ('write_rle', 'write_macrocell', 'save_checkpoint'):
+            func = getattr(lib, f'{prefix}_{name}')
+            func.argtypes = [
+                ctypes.c_void_p,                  # board or universe
+                ctypes.c_char_p,                  # path
+                ctypes.c_uint64                   # generation
+            ]
+            func.restype = ctypes.c_int
+
+    return lib
+
+_lib: Optional[ctypes.CDLL] = None
+
+def get_life_lib() -> ctypes.CDLL:
+    """Return the shared library, loading it on the first call"""
+    global _lib
+    if _lib is None:
+        _lib = load_life_lib()
+    return _lib
+
+
+class _CBoard:
+    """Shared wrapper for the C engines; subclasses name the function prefix"""
+
+    __slots__ = ('_lib', '_handle')
+
+    _PREFIX = ''
+
+    def _call(self, name: str, *args):
+        return getattr(self._lib, f'{self._PREFIX}_{name}')(self._handle, *args)
+
+    def set_cells(self, live: Iterable[Cell]) -> None:
+        """Replace the board contents with the given live cells."""
+        flat: List[int] = []
+        for r, c in live:
+            flat.append(r)
+            flat.append(c)
+        n_cells = len(flat) // 2
+        buffer = (ctypes.c_int64 * max(len(flat), 1))(*flat)
+        if self._call('set_cells', buffer, n_cells) != 0:
+            raise MemoryError("Failed to store live cells")
+
+    def step(self, generations: int = 1) -> None:
+        """Advance the board by the given number of generations."""
+        if generations < 0:
+            raise ValueError("generations must be non-negative")
+        if self._call('step', generations) != 0:
+            raise MemoryError("Failed to advance the board")
+
+    def set_threads(self, threads: Optional[int]) -> None:
+        """Set the worker threads for stepping (None for the OpenMP default, 1 for serial)."""
+        threads = threads or 0
+        if threads < 0 or self._call('set_threads', threads) != 0:
+            raise ValueError("threads must be a positive integer or None")
+
+    def set_rule(self, birth: int, survive: int) -> None:
+        """Set the rule as neighbour-count masks (bit k for k neighbours); the cells are kept."""
+        if not (0 <= birth <= 0x1ff and 0 <= survive <= 0x1ff) or self._call('set_rule', birth, survive) != 0:
+            raise ValueError("Unsupported rule: masks must be 9 bits and B0 is not allowed")
+
+    @property
+    def rule(self) -> Tuple[int, int]:
+        """(birth, survive) neighbour-count masks of the current rule."""
+        birth, survive = ctypes.c_uint16(), ctypes.c_uint16()
+        self._call('get_rule', ctypes.byref(birth), ctypes.byref(survive))
+        return birth.value, survive.value
+
+    @property
+    def population(self) -> int:
+        return self._call('population')
+
+    @property
+    def generation(self) -> int:
+        return self._call('generation')
+
+    def cells(self) -> List[Cell]:
+        """Return the live cells."""
+        count = self._call('population')
+        buffer = (ctypes.c_int64 * max(2 * count, 1))()
+        self._call('get_cells', buffer, count)
+        values = buffer[:2 * count]
+        return list(zip(values[0::2], values[1::2]))
+
+    def render(self, bounds: Tuple[int, int, int, int]):
+        """Return the cells in bounds (min_r, max_r, min_c, max_c) as a numpy uint8 array."""
+        import numpy as np
+
+        min_r, max_r, min_c, max_c = bounds
+        out = np.zeros((max(max_r - min_r + 1, 0), max(max_c - min_c + 1, 0)), dtype=np.uint8)
+        if self._call('render', min_r, min_c, out.shape[0], out.shape[1], out.ctypes.data) != 0:
+            raise ValueError("Invalid render bounds")
+        return out
+
+    def close(self) -> None:
+        """Release the C object; further use raises."""
+        if self._handle:
+            self._call('destroy')
+            self._handle = None
+
+    def __del__(self):
+        if getattr(self, '_handle', None):
+            self.close()
+
+
+class _FileBoard(_CBoard):
+    """C engine that reads and writes pattern files and checkpoints in place
+
+    Paths may be str or bytes. Loading replaces the contents and rule and
+    returns the generation recorded in the file; saving records the given
+    generation and the current rule.
+    """
+
+    __slots__ = ()
+
+    def _load(self, name: str, path) -> int:
+        generation = ctypes.c_uint64()
+        if self._call(name, os.fsencode(path), ctypes.byref(generation)) != 0:
+            raise ValueError(f"Failed to read {os.fsdecode(path)!r}")
+        return generation.value
+
+    def _store(self, name: str, path, generation: int) -> None:
+        if self._call(name, os.fsencode(path), generation) != 0:
+            raise OSError(f"Failed to write {os.fsdecode(path)!r}")
+
+    def read_pattern(self, path) -> int:
+        """Load an RLE or Macrocell file (detected by its [M2] header)."""
+        return self._load('read_pattern', path)
+
+    def write_rle(self, path, generation: int = 0) -> None:
+        """Write extended RLE, keeping the pattern's position."""
+        self._store('write_rle', path, generation)
+
+    def write_macrocell(self, path, generation: int = 0) -> None:
+        """Write a Macrocell file, each distinct quadtree node once."""
+        self._store('write_macrocell', path, generation)
+
+    def save_checkpoint(self, path, generation: int = 0) -> None:
+        """Write a binary checkpoint; either engine can load it."""
+        self._store('save_checkpoint', path, generation)
+
+    def load_checkpoint(self, path) -> int:
+        """Load a checkpoint saved by either engine."""
+        return self._load('load_checkpoint', path)
+
+
+class NativeBoard(_CBoard):
+    """Owner of a C LifeBoard: 64 cells per machine word on an unbounded plane"""
+
+    __slots__ = ()
+
+    _PREFIX = 'life_board'
+
+    def __init__(self, live: Iterable[Cell] = ()):
+        self._lib = get_life_lib()
+        self._handle = self._lib.life_board_create()
+        if not self._handle:
+            raise MemoryError("Failed to allocate life board")
+        self.set_cells(live)
+
+
+class TiledBoard(_FileBoard):
+    """Owner of a C tiled board: 64x64 tiles, only tiles near changes are stepped"""
+
+    __slots__ = ()
+
+    _PREFIX = 'life_tiled'
+
+    def __init__(self, live: Iterable[Cell] = ()):
+        self._lib = get_life_lib()
+        self._handle = self._lib.life_tiled_create()
+        if not self._handle:
+            raise MemoryError("Failed to allocate tiled board")
+        self.set_cells(live)
+
+    def tile_stats(self) -> dict:
+        """Return 'tiles' stored, plus 'active' tiles stepped and period-2 tiles
+        'flipped' in the last generation."""
+        tiles, active, flipped = ctypes.c_uint64(), ctypes.c_uint64(), ctypes.c_uint64()
+        self._lib.life_tiled_stats(self._handle, ctypes.byref(tiles), ctypes.byref(active),
+                                   ctypes.byref(flipped))
+        return {'tiles': tiles.value, 'active': active.value, 'flipped': flipped.value}
+
+
+class HashLifeBoard(_FileBoard):
+    """Owner of a C HashLife universe for jumps of exponentially many generations
+
+    Args:
+        live: Initial live cells
+        memory_limit: Node cache limit in bytes (None for the 1 GiB default).
+            When exceeded, nodes the current pattern cannot reuse are
+            collected between jumps. Nodes are allocated in blocks, so the
+            limit must be at least min_memory_limit() (about 4.7 MB).
+    """
+
+    __slots__ = ()
+
+    _PREFIX = 'hashlife'
+
+    def __init__(self, live: Iterable[Cell] = (), memory_limit: Optional[int] = None):
+        self._lib = get_life_lib()
+        self._check_memory_limit(memory_limit)
+        self._handle = self._lib.hashlife_create(memory_limit or 0)
+        if not self._handle:
+            raise MemoryError("Failed to allocate HashLife universe")
+        self.set_cells(live)
+
+    def set_threads(self, threads: Optional[int]) -> None:
+        """HashLife steps on one thread; accepted for a uniform interface."""
+        if threads is not None and threads < 0:
+            raise ValueError("threads must be a positive integer or None")
+
+    @staticmethod
+    def min_memory_limit() -> int:
+        """Smallest accepted memory_limit in bytes: one block of nodes."""
+        return get_life_lib().hashlife_min_memory_limit()
+
+    def _check_memory_limit(self, memory_limit: Optional[int]) -> None:
+        if memory_limit is not None and memory_limit < self.min_memory_limit():
+            raise ValueError(f"memory_limit must be at least {self.min_memory_limit()} bytes "
+                             f"(one block of HashLife nodes), got {memory_limit}")
+
+    def set_memory_limit(self, memory_limit: Optional[int]) -> None:
+        """Change the node cache limit in bytes (None for the default)."""
+        self._check_memory_limit(memory_limit)
+        self._lib.hashlife_set_memory_limit(self._handle, memory_limit or 0)
+
+    def memory_stats(self) -> dict:
+        """Return 'nodes', 'bytes' and 'gc_runs' of the node cache."""
+        nodes, size, gc_runs = ctypes.c_uint64(), ctypes.c_uint64(), ctypes.c_uint64()
+        self._lib.hashlife_memory_stats(self._handle, ctypes.byref(nodes), ctypes.byref(size),
+                                        ctypes.byref(gc_runs))
+        return {'nodes': nodes.value, 'bytes': size.value, 'gc_runs': gc_runs.value}
@@ -0,0 +1,3160 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT
+#endif
+
+#define LIFE_WORD_BITS 64
+#define LIFE_MIN_ROWS 64     // Smallest board height allocated
+#define LIFE_MIN_WORDS 2     // Smallest board width allocated, in words
+#define LIFE_GROW_MARGIN 32  // Extra rows (and words / 2) kept free on each side when growing
+#define LIFE_PARALLEL_MIN_ROWS 256   // Fewer rows per generation are stepped serially
+#define LIFE_PARALLEL_MIN_TILES 32   // Fewer active tiles per generation are stepped serially
+#define LIFE_STEAL_CHUNK 4           // Tiles a worker claims from its own range at a time
+#define LIFE_RULE_MASK 0x1ffu        // Neighbour counts 0..8
+#define LIFE_CONWAY_BIRTH 0x008u     // B3
+#define LIFE_CONWAY_SURVIVE 0x00cu   // S23
+
+#define LIFE_INLINE static inline __attribute__((always_inline))
+
+// Life-like rule in B/S notation: bit k of birth (survive) is set if a
+// dead (live) cell with k live neighbours is alive next generation.
+// Every engine relies on empty space staying empty, so B0 is rejected.
+typedef struct {
+    uint16_t birth;
+    uint16_t survive;
+} LifeRule;
+
+static inline bool life_rule_valid(LifeRule rule) {
+    return !(rule.birth & 1) && rule.birth <= LIFE_RULE_MASK && rule.survive <= LIFE_RULE_MASK;
+}
+
+static inline LifeRule life_conway_rule(void) {
+    const LifeRule rule = {LIFE_CONWAY_BIRTH, LIFE_CONWAY_SURVIVE};
+    return rule;
+}
+
+typedef struct TileNeighbourhood TileNeighbourhood;
+
+// Step kernels for one board row or one tile, see "Rule kernels"
+typedef struct {
+    uint16_t birth;       // Rule the kernels are specialized for
+    uint16_t survive;
+    bool (*step_row)(const LifeRule* rule, const uint64_t* above, const uint64_t* row,
+                     const uint64_t* below, uint64_t* out, int words);
+    void (*step_tile)(const LifeRule* rule, const TileNeighbourhood* area, const uint64_t* prev,
+                      uint64_t* next, uint64_t* changed_out, uint64_t* unstable_out);
+} LifeKernels;
+
+static const LifeKernels* life_rule_kernels(LifeRule rule);
+
+// Bit-packed board
+//
+// Cell (row0 + r, col0 + 64 * w + b) is bit b of word w in row r. The
+// outermost row and column on every side are kept dead between
+// generations, so a step never needs to look outside the allocation and
+// the board can grow to follow the pattern across the infinite plane.
+typedef struct {
+    int64_t row0;
+    int64_t col0;
+    int rows;
+    int words;            // 64-bit words per row
+    int live_min_row;     // Rows outside [live_min_row, live_max_row] are empty
+    int live_max_row;
+    uint64_t* cells;      // rows * words
+    uint64_t* next;       // Scratch buffer of the same size
+    uint64_t* zero_row;   // words zeros, stands in for rows outside the board
+    uint64_t generation;
+    int threads;          // Worker threads, 0 for the OpenMP default
+    LifeRule rule;
+    const LifeKernels* kernels;  // Selected for rule
+} LifeBoard;
+
+// Worker count for a parallel step, 1 when built without OpenMP
+static inline int life_thread_count(int threads) {
+#ifdef _OPENMP
+    return threads > 0 ? threads : omp_get_max_threads();
+#else
+    (void)threads;
+    return 1;
+#endif
+}
+
+static void life_board_free_buffers(LifeBoard* board) {
+    free(board->cells);
+    free(board->next);
+    free(board->zero_row);
+    board->cells = NULL;
+    board->next = NULL;
+    board->zero_row = NULL;
+}
+
+// Allocate an empty rows x words board; the caller restores row0/col0
+static int life_board_allocate(LifeBoard* board, int rows, int words) {
+    const size_t total = (size_t)rows * (size_t)words;
+    uint64_t* cells = (uint64_t*)calloc(total, sizeof(uint64_t));
+    uint64_t* next = (uint64_t*)calloc(total, sizeof(uint64_t));
+    uint64_t* zero_row = (uint64_t*)calloc((size_t)words, sizeof(uint64_t));
+    if (!cells || !next || !zero_row) {
+        free(cells);
+        free(next);
+        free(zero_row);
+        return -1;
+    }
+
+    life_board_free_buffers(board);
+    board->cells = cells;
+    board->next = next;
+    board->zero_row = zero_row;
+    board->rows = rows;
+    board->words = words;
+    board->live_min_row = rows;
+    board->live_max_row = -1;
+    return 0;
+}
+
+// Floor division by the word size, for negative columns as well
+static inline int64_t floor_div64(int64_t value) {
+    const int64_t q = value / LIFE_WORD_BITS;
+    return (value % LIFE_WORD_BITS < 0) ? q - 1 : q;
+}
+
+/**
+ * Check whether a live cell touches the dead border
+ */
+static bool life_board_touches_border(const LifeBoard* board) {
+    if (board->live_max_row < 0) return false;
+    if (board->live_min_row == 0 || board->live_max_row == board->rows - 1) return true;
+
+    const uint64_t low_bit = 1ULL;
+    const uint64_t high_bit = 1ULL << (LIFE_WORD_BITS - 1);
+    for (int r = board->live_min_row; r <= board->live_max_row; r++) {
+        const uint64_t* row = board->cells + (size_t)r * board->words;
+        if ((row[0] & low_bit) || (row[board->words - 1] & high_bit)) return true;
+    }
+    return false;
+}
+
+/**
+ * Bounding box of the live cells in board coordinates
+ *
+ * @return false for an empty board
+ */
+static bool life_board_live_box(const LifeBoard* board, int* min_r, int* max_r, int* min_w, int* max_w) {
+    if (board->live_max_row < 0) return false;
+    *min_r = board->live_min_row;
+    *max_r = board->live_max_row;
+    *min_w = board->words;
+    *max_w = -1;
+    for (int r = *min_r; r <= *max_r; r++) {
+        const uint64_t* row = board->cells + (size_t)r * board->words;
+        for (int w = 0; w < board->words; w++) {
+            if (row[w]) {
+                if (w < *min_w) *min_w = w;
+                if (w > *max_w) *max_w = w;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Re-allocate the board around its live cells with a fresh dead margin
+ *
+ * Keeps col0 a multiple of 64 relative to the old origin so that rows are
+ * copied as whole words.
+ */
+static int life_board_recentre(LifeBoard* board) {
+    int min_r, max_r, min_w, max_w;
+    if (!life_board_live_box(board, &min_r, &max_r, &min_w, &max_w)) return 0;
+
+    const int live_rows = max_r - min_r + 1;
+    const int live_words = max_w - min_w + 1;
+    const int row_margin = LIFE_GROW_MARGIN + live_rows / 2;
+    const int word_margin = 1 + (LIFE_GROW_MARGIN / LIFE_WORD_BITS) + live_words / 4;
+
+    int rows = live_rows + 2 * row_margin;
+    int words = live_words + 2 * word_margin;
+    if (rows < LIFE_MIN_ROWS) rows = LIFE_MIN_ROWS;
+    if (words < LIFE_MIN_WORDS) words = LIFE_MIN_WORDS;
+    const int top = (rows - live_rows) / 2;
+    const int left = (words - live_words) / 2;
+
+    LifeBoard grown = *board;
+    grown.cells = NULL;
+    grown.next = NULL;
+    grown.zero_row = NULL;
+    if (life_board_allocate(&grown, rows, words) != 0) return -1;
+
+    for (int r = 0; r < live_rows; r++) {
+        memcpy(grown.cells + (size_t)(top + r) * words + left,
+               board->cells + (size_t)(min_r + r) * board->words + min_w,
+               (size_t)live_words * sizeof(uint64_t));
+    }
+
+    grown.row0 = board->row0 + min_r - top;
+    grown.col0 = board->col0 + (int64_t)(min_w - left) * LIFE_WORD_BITS;
+    grown.live_min_row = top;
+    grown.live_max_row = top + live_rows - 1;
+
+    life_board_free_buffers(board);
+    *board = grown;
+    return 0;
+}
+
+/**
+ * Next state of 64 cells from their word and the words around it
+ *
+ * The eight neighbour bit-planes are summed with full adders so every
+ * word advances 64 cells at once. With ones the low bit of the total and
+ * T the number of weight-2 carries, a cell is alive next generation iff
+ * T == 1 and (ones or the cell is alive), i.e. a total of 3, or 2 with a
+ * live cell. The *_prev words hold lower columns (bit 63 is the west
+ * neighbour of bit 0) and *_next words higher ones.
+ */
+static inline uint64_t life_next_word(uint64_t a_prev, uint64_t a, uint64_t a_next,
+                                      uint64_t c_prev, uint64_t c, uint64_t c_next,
+                                      uint64_t b_prev, uint64_t b, uint64_t b_next) {
+    // West and east neighbours, shifted into each cell's bit position
+    const uint64_t aw = (a << 1) | (a_prev >> 63), ae = (a >> 1) | (a_next << 63);
+    const uint64_t cw = (c << 1) | (c_prev >> 63), ce = (c >> 1) | (c_next << 63);
+    const uint64_t bw = (b << 1) | (b_prev >> 63), be = (b >> 1) | (b_next << 63);
+
+    // Row sums: above and below are 0..3, the middle row 0..2
+    const uint64_t sa = aw ^ a ^ ae, ka = (aw & a) | (ae & (aw ^ a));
+    const uint64_t sb = bw ^ b ^ be, kb = (bw & b) | (be & (bw ^ b));
+    const uint64_t sc = cw ^ ce, kc = cw & ce;
+
+    // Ones column and its carry
+    const uint64_t ones = sa ^ sb ^ sc;
+    const uint64_t carry = (sa & sb) | (sc & (sa ^ sb));
+
+    // Twos column: T = ka + kb + kc + carry, need T == 1
+    const uint64_t s2 = ka ^ kb ^ kc;
+    const uint64_t k2 = (ka & kb) | (kc & (ka ^ kb));
+    return ~k2 & (s2 ^ carry) & (ones | c);
+}
+
+/**
+ * Advance the board by one generation
+ */
+static int life_board_step_once(LifeBoard* board) {
+    if (board->live_max_row < 0) {
+        board->generation++;
+        return 0;
+    }
+    if (life_board_touches_border(board) && life_board_recentre(board) != 0) return -1;
+
+    const int words = board->words;
+    const int first = board->live_min_row - 1;
+    const int last = board->live_max_row + 1;
+    const int threads = life_thread_count(board->threads);
+    (void)threads;  // Only read by the OpenMP pragma
+    int new_min = board->rows, new_max = -1;
+
+    // Only rows next to live rows can change; the rest of next is already dead.
+    // Rows read the current buffer and write their own row of next, so bands
+    // of rows can run on separate threads.
+    #pragma omp parallel for num_threads(threads) schedule(static) reduction(min:new_min) reduction(max:new_max) \
+        if(threads > 1 && last - first >= LIFE_PARALLEL_MIN_ROWS)
+    for (int r = first; r <= last; r++) {
+        const uint64_t* above = r > 0 ? board->cells + (size_t)(r - 1) * words : board->zero_row;
+        const uint64_t* below = r + 1 < board->rows ? board->cells + (size_t)(r + 1) * words : board->zero_row;
+        if (board->kernels->step_row(&board->rule, above, board->cells + (size_t)r * words, below,
+                                     board->next + (size_t)r * words, words)) {
+            if (r < new_min) new_min = r;
+            new_max = r;
+        }
+    }
+
+    // Clear the old live rows in the buffer that becomes next
+    uint64_t* old = board->cells;
+    board->cells = board->next;
+    board->next = old;
+    for (int r = first; r <= last; r++) {
+        memset(board->next + (size_t)r * words, 0, (size_t)words * sizeof(uint64_t));
+    }
+
+    board->live_min_row = new_min;
+    board->live_max_row = new_max;
+    board->generation++;
+    return 0;
+}
+
+/**
+ * Create an empty board
+ *
+ * @return New board, or NULL on allocation failure
+ */
+EXPORT LifeBoard* life_board_create(void) {
+    LifeBoard* board = (LifeBoard*)calloc(1, sizeof(LifeBoard));
+    if (!board) return NULL;
+    if (life_board_allocate(board, LIFE_MIN_ROWS, LIFE_MIN_WORDS) != 0) {
+        free(board);
+        return NULL;
+    }
+    board->row0 = -LIFE_MIN_ROWS / 2;
+    board->col0 = -(int64_t)LIFE_MIN_WORDS * LIFE_WORD_BITS / 2;
+    board->rule.birth = LIFE_CONWAY_BIRTH;
+    board->rule.survive = LIFE_CONWAY_SURVIVE;
+    board->kernels = life_rule_kernels(board->rule);
+    return board;
+}
+
+/**
+ * Release a board created by life_board_create
+ */
+EXPORT void life_board_destroy(LifeBoard* board) {
+    if (!board) return;
+    life_board_free_buffers(board);
+    free(board);
+}
+
+/**
+ * Replace the board contents with the given live cells
+ *
+ * The board is sized to the bounding box of the cells plus a dead margin.
+ * Duplicate cells are allowed.
+ *
+ * @param cells Row-major (row, col) pairs, 2 * n_cells values
+ * @param n_cells Number of live cells
+ * @return 0 on success, -1 on error
+ */
+EXPORT int life_board_set_cells(LifeBoard* board, const int64_t* cells, size_t n_cells) {
+    if (!board || (n_cells > 0 && !cells)) return -1;
+
+    int64_t min_r = 0, max_r = 0, min_c = 0, max_c = 0;
+    for (size_t i = 0; i < n_cells; i++) {
+        const int64_t r = cells[2 * i], c = cells[2 * i + 1];
+        if (i == 0 || r < min_r) min_r = r;
+        if (i == 0 || r > max_r) max_r = r;
+        if (i == 0 || c < min_c) min_c = c;
+        if (i == 0 || c > max_c) max_c = c;
+    }
+
+    // Word-aligned column range, relative to an origin that is a multiple of 64
+    const int64_t first_word = floor_div64(min_c);
+    const int64_t last_word = floor_div64(max_c);
+    const int64_t live_rows = max_r - min_r + 1;
+    const int64_t live_words = last_word - first_word + 1;
+    const int64_t rows = live_rows + 2 * (LIFE_GROW_MARGIN + live_rows / 2);
+    const int64_t words = live_words + 2 * (1 + LIFE_GROW_MARGIN / LIFE_WORD_BITS + live_words / 4);
+    if (rows > INT32_MAX / 2 || words > INT32_MAX / 2 || rows * words > (int64_t)(SIZE_MAX / 16)) return -1;
+
+    const int alloc_rows = rows < LIFE_MIN_ROWS ? LIFE_MIN_ROWS : (int)rows;
+    const int alloc_words = words < LIFE_MIN_WORDS ? LIFE_MIN_WORDS : (int)words;
+    if (life_board_allocate(board, alloc_rows, alloc_words) != 0) return -1;
+
+    const int top = (alloc_rows - (int)live_rows) / 2;
+    const int left = (alloc_words - (int)live_words) / 2;
+    board->row0 = min_r - top;
+    board->col0 = (first_word - left) * LIFE_WORD_BITS;
+    board->generation = 0;
+
+    for (size_t i = 0; i < n_cells; i++) {
+        const int r = (int)(cells[2 * i] - board->row0);
+        const int64_t c = cells[2 * i + 1] - board->col0;
+        board->cells[(size_t)r * board->words + (size_t)(c / LIFE_WORD_BITS)] |= 1ULL << (c % LIFE_WORD_BITS);
+    }
+    if (n_cells == 0) {
+        board->live_min_row = board->rows;
+        board->live_max_row = -1;
+    } else {
+        board->live_min_row = top;
+        board->live_max_row = top + (int)live_rows - 1;
+    }
+    return 0;
+}
+
+/**
+ * Advance the board by several generations
+ *
+ * @param generations Number of generations to run
+ * @return 0 on success, -1 on allocation failure
+ */
+EXPORT int life_board_step(LifeBoard* board, uint64_t generations) {
+    if (!board) return -1;
+    for (uint64_t g = 0; g < generations; g++) {
+        if (life_board_step_once(board) != 0) return -1;
+    }
+    return 0;
+}
+
+/**
+ * Set the worker threads used by life_board_step
+ *
+ * @param threads Thread count, 0 for the OpenMP default, 1 for serial stepping
+ * @return 0 on success, -1 on error
+ */
+EXPORT int life_board_set_threads(LifeBoard* board, int threads) {
+    if (!board || threads < 0) return -1;
+    board->threads = threads;
+    return 0;
+}
+
+/**
+ * Set the Life-like rule used by later steps; the cells are kept
+ *
+ * @param birth, survive Bit k set if a dead / live cell with k live neighbours is alive next
+ * @return 0 on success, -1 on error or for a B0 rule
+ */
+EXPORT int life_board_set_rule(LifeBoard* board, uint16_t birth, uint16_t survive) {
+    const LifeRule rule = {birth, survive};
+    if (!board || !life_rule_valid(rule)) return -1;
+    board->rule = rule;
+    board->kernels = life_rule_kernels(rule);
+    return 0;
+}
+
+/**
+ * Current rule masks, see life_board_set_rule
+ */
+EXPORT void life_board_get_rule(const LifeBoard* board, uint16_t* birth_out, uint16_t* survive_out) {
+    if (!board) return;
+    if (birth_out) *birth_out = board->rule.birth;
+    if (survive_out) *survive_out = board->rule.survive;
+}
+
+/**
+ * Number of live cells
+ */
+EXPORT uint64_t life_board_population(const LifeBoard* board) {
+    if (!board) return 0;
+    uint64_t population = 0;
+    for (int r = board->live_min_row; r <= board->live_max_row; r++) {
+        const uint64_t* row = board->cells + (size_t)r * board->words;
+        for (int w = 0; w < board->words; w++) {
+            population += (uint64_t)__builtin_popcountll(row[w]);
+        }
+    }
+    return population;
+}
+
+/**
+ * Generations advanced since the last life_board_set_cells
+ */
+EXPORT uint64_t life_board_generation(const LifeBoard* board) {
+    return board ? board->generation : 0;
+}
+
+/**
+ * Export the live cells in row-major order
+ *
+ * @param cells_out Receives (row, col) pairs, 2 * capacity values (may be NULL if capacity is 0)
+ * @param capacity Maximum number of cells written
+ * @return Total number of live cells, which may exceed capacity
+ */
+EXPORT uint64_t life_board_get_cells(const LifeBoard* board, int64_t* cells_out, uint64_t capacity) {
+    if (!board) return 0;
+    uint64_t count = 0;
+    for (int r = board->live_min_row; r <= board->live_max_row; r++) {
+        const uint64_t* row = board->cells + (size_t)r * board->words;
+        for (int w = 0; w < board->words; w++) {
+            uint64_t bits = row[w];
+            while (bits) {
+                const int b = __builtin_ctzll(bits);
+                if (count < capacity) {
+                    cells_out[2 * count] = board->row0 + r;
+                    cells_out[2 * count + 1] = board->col0 + (int64_t)w * LIFE_WORD_BITS + b;
+                }
+                count++;
+                bits &= bits - 1;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * Render a viewport as one byte per cell
+ *
+ * @param row0, col0 Top-left cell of the viewport
+ * @param height, width Viewport size in cells
+ * @param out Receives height * width bytes, row-major, 1 for live cells
+ * @return 0 on success, -1 on error
+ */
+EXPORT int life_board_render(const LifeBoard* board, int64_t row0, int64_t col0,
+                             int64_t height, int64_t width, uint8_t* out) {
+    if (!board || height < 0 || width < 0 || (height * width > 0 && !out)) return -1;
+    if (height == 0 || width == 0) return 0;
+    memset(out, 0, (size_t)(height * width));
+
+    const int64_t col_end = board->col0 + (int64_t)board->words * LIFE_WORD_BITS;
+    const int64_t c_begin = col0 > board->col0 ? col0 : board->col0;
+    const int64_t c_end = col0 + width < col_end ? col0 + width : col_end;
+    for (int64_t vr = 0; vr < height; vr++) {
+        const int64_t r = row0 + vr - board->row0;
+        if (r < board->live_min_row || r > board->live_max_row) continue;
+        const uint64_t* row = board->cells + (size_t)r * board->words;
+        uint8_t* line = out + vr * width;
+        for (int64_t c = c_begin; c < c_end; c++) {
+            const int64_t bit = c - board->col0;
+            line[c - col0] = (uint8_t)((row[bit / LIFE_WORD_BITS] >> (bit % LIFE_WORD_BITS)) & 1);
+        }
+    }
+    return 0;
+}
+
+// Work stealing
+//
+// Each worker owns a contiguous range of the active list, packed as
+// (begin, end) into one atomic word. The owner claims small chunks from
+// the front; an idle worker steals the back half of another range. Both
+// sides update a range with a single compare-and-swap, so no tile is
+// stepped twice, and a worker only exits after finding every range
+// empty, by which point each remaining tile belongs to a busy owner.
+
+typedef struct {
+    _Atomic uint64_t range;    // begin in the low 32 bits, end in the high 32 bits
+    char pad[64 - sizeof(uint64_t)];
+} WorkRange;
+
+static inline uint64_t work_pack(uint32_t begin, uint32_t end) {
+    return (uint64_t)begin | ((uint64_t)end << 32);
+}
+
+// Claim up to chunk items from the front of a range
+static bool work_claim(WorkRange* range, uint32_t chunk, uint32_t* begin_out, uint32_t* end_out) {
+    uint64_t packed = atomic_load_explicit(&range->range, memory_order_acquire);
+    for (;;) {
+        const uint32_t begin = (uint32_t)packed, end = (uint32_t)(packed >> 32);
+        if (begin >= end) return false;
+        const uint32_t stop = end - begin > chunk ? begin + chunk : end;
+        if (atomic_compare_exchange_weak_explicit(&range->range, &packed, work_pack(stop, end),
+                                                  memory_order_acq_rel, memory_order_acquire)) {
+            *begin_out = begin;
+            *end_out = stop;
+            return true;
+        }
+    }
+}
+
+// Move the back half of some other worker's range into an empty own range
+static bool work_steal(WorkRange* ranges, int self, int workers) {
+    for (int k = 1; k < workers; k++) {
+        WorkRange* victim = &ranges[(self + k) % workers];
+        uint64_t packed = atomic_load_explicit(&victim->range, memory_order_acquire);
+        for (;;) {
+            const uint32_t begin = (uint32_t)packed, end = (uint32_t)(packed >> 32);
+            if (begin >= end) break;
+            const uint32_t middle = begin + (end - begin) / 2;
+            if (atomic_compare_exchange_weak_explicit(&victim->range, &packed, work_pack(begin, middle),
+                                                      memory_order_acq_rel, memory_order_acquire)) {
+                atomic_store_explicit(&ranges[self].range, work_pack(middle, end), memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Tiled sparse board
+//
+// The plane is split into 64 x 64 tiles, one word per tile row, kept in a
+// hash map keyed by tile coordinates. Each tile keeps its last two states.
+// A tile is only stepped when it or one of its eight neighbours differs
+// from two generations ago; otherwise its whole neighbourhood repeats
+// with period 1 or 2 and the next state is the previous one. Still lifes
+// then cost nothing and blinker-type ash a buffer flip, so a generation
+// scales with activity rather than population. Tiles are created when an
+// active tile has live cells on the shared edge and dropped once they are
+// empty and stable.
+
+#define LIFE_TILE_SIZE 64        // Tile side in cells, one word per row
+#define LIFE_TILE_MAP_MIN 1024   // Initial tile hash map slots, a power of two
+
+typedef struct {
+    int64_t tr;                       // Tile row: cells [64 tr, 64 tr + 64)
+    int64_t tc;                       // Tile column
+    uint64_t buffers[3][LIFE_TILE_SIZE];
+    uint8_t cur;                      // buffers[cur] holds generation t
+    uint8_t prev;                     // buffers[prev] holds generation t - 1
+    bool changed;                     // t differs from t - 1
+    bool unstable;                    // t differs from t - 2
+    bool in_use;
+    uint64_t stamp;                   // Last generation the tile was queued for stepping
+} LifeTile;
+
+#define TILE_ROWS(tile) ((tile)->buffers[(tile)->cur])
+#define TILE_PREV(tile) ((tile)->buffers[(tile)->prev])
+#define TILE_NEXT(tile) ((tile)->buffers[3 - (tile)->cur - (tile)->prev])
+
+typedef struct {
+    int32_t* items;
+    size_t count;
+    size_t capacity;
+} TileList;
+
+typedef struct {
+    LifeTile* tiles;
+    size_t n_slots;          // Tiles allocated, used or free
+    size_t capacity;
+    TileList free_slots;
+    int32_t* map;            // Linear probing table of tile indices, -1 when empty
+    size_t map_size;
+    size_t map_count;
+    TileList changed;        // Tiles whose last generation differs from the one before
+    TileList unstable;       // Tiles whose last generation differs from two before
+    TileList active;         // Tiles stepped in the current generation
+    TileList next_changed;
+    TileList next_unstable;
+    uint64_t flipped;        // Period-2 tiles flipped in the last generation
+    uint64_t generation;
+    int threads;             // Worker threads, 0 for the OpenMP default
+    WorkRange* ranges;       // One per worker, reused across generations
+    int n_ranges;
+    LifeRule rule;
+    const LifeKernels* kernels;  // Selected for rule
+} LifeTiledBoard;
+
+static const uint64_t life_zero_tile[LIFE_TILE_SIZE];
+
+// Rule kernels
+//
+// Each specialized kernel steps a board row or a tile with its rule's
+// masks as compile-time constants, so matching neighbour counts folds
+// into a handful of bitwise operations and a listed rule runs at
+// Conway's speed. Other rules share generic kernels that read the masks
+// at run time. A board selects its kernels once, when the rule is set.
+
+// Tile rows and the eight neighbours' edges a tile step reads
+struct TileNeighbourhood {
+    const uint64_t* n;
+    const uint64_t* s;
+    const uint64_t* w;
+    const uint64_t* e;
+    const uint64_t* c;
+    uint64_t nw, ne, sw, se;  // Corner words: last row above, first row below
+};
+
+/**
+ * life_next_word for any rule
+ *
+ * The nine words are summed into four bit planes of the neighbour count,
+ * then every count the rule keeps alive is matched against them. With
+ * constant masks the other counts fold away; Conway keeps its shorter
+ * dedicated adder.
+ */
+LIFE_INLINE uint64_t life_rule_word(unsigned birth, unsigned survive,
+                                    uint64_t a_prev, uint64_t a, uint64_t a_next,
+                                    uint64_t c_prev, uint64_t c, uint64_t c_next,
+                                    uint64_t b_prev, uint64_t b, uint64_t b_next) {
+    if (birth == LIFE_CONWAY_BIRTH && survive == LIFE_CONWAY_SURVIVE) {
+        return life_next_word(a_prev, a, a_next, c_prev, c, c_next, b_prev, b, b_next);
+    }
+    const uint64_t aw = (a << 1) | (a_prev >> 63), ae = (a >> 1) | (a_next << 63);
+    const uint64_t cw = (c << 1) | (c_prev >> 63), ce = (c >> 1) | (c_next << 63);
+    const uint64_t bw = (b << 1) | (b_prev >> 63), be = (b >> 1) | (b_next << 63);
+
+    const uint64_t sa = aw ^ a ^ ae, ka = (aw & a) | (ae & (aw ^ a));
+    const uint64_t sb = bw ^ b ^ be, kb = (bw & b) | (be & (bw ^ b));
+    const uint64_t sc = cw ^ ce, kc = cw & ce;
+    const uint64_t carry = (sa & sb) | (sc & (sa ^ sb));
+    const uint64_t s2 = ka ^ kb ^ kc;
+    const uint64_t k2 = (ka & kb) | (kc & (ka ^ kb));
+
+    // Count bits: weight 4 is k2 plus the carry out of the twos column
+    const uint64_t n0 = sa ^ sb ^ sc;
+    const uint64_t n1 = s2 ^ carry;
+    const uint64_t c2 = s2 & carry;
+    const uint64_t n2 = k2 ^ c2, n3 = k2 & c2;
+
+    // Outcome word for each count, then a multiplexer tree over the count bits
+    uint64_t e[9];
+    for (unsigned k = 0; k <= 8; k++) {
+        const uint64_t born = 0 - (uint64_t)((birth >> k) & 1);
+        const uint64_t kept = 0 - (uint64_t)((survive >> k) & 1);
+        e[k] = born ^ ((born ^ kept) & c);
+    }
+    const uint64_t e01 = e[0] ^ ((e[0] ^ e[1]) & n0), e23 = e[2] ^ ((e[2] ^ e[3]) & n0);
+    const uint64_t e45 = e[4] ^ ((e[4] ^ e[5]) & n0), e67 = e[6] ^ ((e[6] ^ e[7]) & n0);
+    const uint64_t e03 = e01 ^ ((e01 ^ e23) & n1), e47 = e45 ^ ((e45 ^ e67) & n1);
+    const uint64_t e07 = e03 ^ ((e03 ^ e47) & n2);
+    return e07 ^ ((e07 ^ e[8]) & n3);  // A count of 8 has n0..n2 clear
+}
+
+/**
+ * Compute one output row of the bit-packed board
+ *
+ * @return true if any cell in the row is alive
+ */
+LIFE_INLINE bool life_step_row_rule(unsigned birth, unsigned survive,
+                                    const uint64_t* above, const uint64_t* row, const uint64_t* below,
+                                    uint64_t* out, int words) {
+    uint64_t any = 0;
+    for (int w = 0; w < words; w++) {
+        const uint64_t next = life_rule_word(birth, survive,
+            w > 0 ? above[w - 1] : 0, above[w], w + 1 < words ? above[w + 1] : 0,
+            w > 0 ? row[w - 1] : 0, row[w], w + 1 < words ? row[w + 1] : 0,
+            w > 0 ? below[w - 1] : 0, below[w], w + 1 < words ? below[w + 1] : 0);
+        out[w] = next;
+        any |= next;
+    }
+    return any != 0;
+}
+
+/**
+ * Compute the next generation of one tile
+ *
+ * @param changed_out, unstable_out Receive nonzero if next differs from the current or previous rows
+ */
+LIFE_INLINE void tiled_step_rows_rule(unsigned birth, unsigned survive, const TileNeighbourhood* area,
+                                      const uint64_t* prev, uint64_t* next,
+                                      uint64_t* changed_out, uint64_t* unstable_out) {
+    const uint64_t* n = area->n;
+    const uint64_t* s = area->s;
+    const uint64_t* w = area->w;
+    const uint64_t* e = area->e;
+    const uint64_t* c = area->c;
+    const int last = LIFE_TILE_SIZE - 1;
+    uint64_t changed = 0, unstable = 0;
+
+    for (int i = 0; i < LIFE_TILE_SIZE; i++) {
+        next[i] = life_rule_word(birth, survive,
+            i > 0 ? w[i - 1] : area->nw, i > 0 ? c[i - 1] : n[last], i > 0 ? e[i - 1] : area->ne,
+            w[i], c[i], e[i],
+            i < last ? w[i + 1] : area->sw, i < last ? c[i + 1] : s[0], i < last ? e[i + 1] : area->se);
+        changed |= next[i] ^ c[i];
+        unstable |= next[i] ^ prev[i];
+    }
+    *changed_out = changed;
+    *unstable_out = unstable;
+}
+
+// Rules with kernels of their own: name, birth mask, survive mask
+#define LIFE_SPECIALIZED_RULES(X) \
+    X(conway, 0x008, 0x00c)              /* B3/S23 */ \
+    X(highlife, 0x048, 0x00c)            /* B36/S23 */ \
+    X(seeds, 0x004, 0x000)               /* B2/S */ \
+    X(day_and_night, 0x1c8, 0x1d8)       /* B3678/S34678 */ \
+    X(life_without_death, 0x008, 0x1ff)  /* B3/S012345678 */ \
+    X(maze, 0x008, 0x03e)                /* B3/S12345 */ \
+    X(two_by_two, 0x048, 0x026)          /* B36/S125 */ \
+    X(morley, 0x148, 0x034)              /* B368/S245 */ \
+    X(replicator, 0x0aa, 0x0aa)          /* B1357/S1357 */ \
+    X(diamoeba, 0x1e8, 0x1e0)            /* B35678/S5678 */
+
+#define LIFE_RULE_KERNELS(name, birth, survive) \
+    static bool life_step_row_##name(const LifeRule* rule, const uint64_t* above, const uint64_t* row, \
+                                     const uint64_t* below, uint64_t* out, int words) { \
+        (void)rule; \
+        return life_step_row_rule(birth, survive, above, row, below, out, words); \
+    } \
+    static void tiled_step_rows_##name(const LifeRule* rule, const TileNeighbourhood* area, \
+                                       const uint64_t* prev, uint64_t* next, \
+                                       uint64_t* changed_out, uint64_t* unstable_out) { \
+        (void)rule; \
+        tiled_step_rows_rule(birth, survive, area, prev, next, changed_out, unstable_out); \
+    }
+
+#define LIFE_RULE_ENTRY(name, birth, survive) {birth, survive, life_step_row_##name, tiled_step_rows_##name},
+
+LIFE_SPECIALIZED_RULES(LIFE_RULE_KERNELS)
+
+static bool life_step_row_generic(const LifeRule* rule, const uint64_t* above, const uint64_t* row,
+                                  const uint64_t* below, uint64_t* out, int words) {
+    return life_step_row_rule(rule->birth, rule->survive, above, row, below, out, words);
+}
+
+static void tiled_step_rows_generic(const LifeRule* rule, const TileNeighbourhood* area,
+                                    const uint64_t* prev, uint64_t* next,
+                                    uint64_t* changed_out, uint64_t* unstable_out) {
+    tiled_step_rows_rule(rule->birth, rule->survive, area, prev, next, changed_out, unstable_out);
+}
+
+static const LifeKernels life_kernel_table[] = {
+    LIFE_SPECIALIZED_RULES(LIFE_RULE_ENTRY)
+};
+
+static const LifeKernels life_generic_kernels = {0, 0, life_step_row_generic, tiled_step_rows_generic};
+
+// Specialized kernels for the rule if it has them, else the generic ones
+static const LifeKernels* life_rule_kernels(LifeRule rule) {
+    for (size_t i = 0; i < sizeof(life_kernel_table) / sizeof(life_kernel_table[0]); i++) {
+        if (life_kernel_table[i].birth == rule.birth && life_kernel_table[i].survive == rule.survive) {
+            return &life_kernel_table[i];
+        }
+    }
+    return &life_generic_kernels;
+}
+
+static int tile_list_push(TileList* list, int32_t value) {
+    if (list->count == list->capacity) {
+        const size_t capacity = list->capacity ? list->capacity * 2 : 64;
+        int32_t* items = (int32_t*)realloc(list->items, capacity * sizeof(int32_t));
+        if (!items) return -1;
+        list->items = items;
+        list->capacity = capacity;
+    }
+    list->items[list->count++] = value;
+    return 0;
+}
+
+static inline size_t tile_hash(int64_t tr, int64_t tc) {
+    uint64_t h = (uint64_t)tr * 0x9E3779B97F4A7C15ULL ^ ((uint64_t)tc + 0x632BE59BD9B4E019ULL) * 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 31;
+    return (size_t)h;
+}
+
+static LifeTile* tiled_find(const LifeTiledBoard* board, int64_t tr, int64_t tc) {
+    const size_t mask = board->map_size - 1;
+    for (size_t slot = tile_hash(tr, tc) & mask;; slot = (slot + 1) & mask) {
+        const int32_t index = board->map[slot];
+        if (index < 0) return NULL;
+        LifeTile* tile = &board->tiles[index];
+        if (tile->tr == tr && tile->tc == tc) return tile;
+    }
+}
+
+static void tiled_map_insert(LifeTiledBoard* board, int32_t index) {
+    const size_t mask = board->map_size - 1;
+    size_t slot = tile_hash(board->tiles[index].tr, board->tiles[index].tc) & mask;
+    while (board->map[slot] >= 0) slot = (slot + 1) & mask;
+    board->map[slot] = index;
+    board->map_count++;
+}
+
+static int tiled_map_resize(LifeTiledBoard* board, size_t map_size) {
+    int32_t* map = (int32_t*)malloc(map_size * sizeof(int32_t));
+    if (!map) return -1;
+    memset(map, 0xff, map_size * sizeof(int32_t));
+    free(board->map);
+    board->map = map;
+    board->map_size = map_size;
+    board->map_count = 0;
+    for (size_t i = 0; i < board->n_slots; i++) {
+        if (board->tiles[i].in_use) tiled_map_insert(board, (int32_t)i);
+    }
+    return 0;
+}
+
+// Remove a tile from the map with backward-shift deletion
+static void tiled_map_remove(LifeTiledBoard* board, int32_t index) {
+    const size_t mask = board->map_size - 1;
+    size_t hole = tile_hash(board->tiles[index].tr, board->tiles[index].tc) & mask;
+    while (board->map[hole] != index) hole = (hole + 1) & mask;
+
+    for (size_t slot = (hole + 1) & mask; board->map[slot] >= 0; slot = (slot + 1) & mask) {
+        const LifeTile* tile = &board->tiles[board->map[slot]];
+        const size_t home = tile_hash(tile->tr, tile->tc) & mask;
+        // Move the entry into the hole unless its home lies cyclically in (hole, slot]
+        const bool stays = hole <= slot ? (home > hole && home <= slot) : (home > hole || home <= slot);
+        if (!stays) {
+            board->map[hole] = board->map[slot];
+            hole = slot;
+        }
+    }
+    board->map[hole] = -1;
+    board->map_count--;
+}
+
+/**
+ * Create an empty tile and queue nothing
+ *
+ * @return Index of the new tile, or -1 on allocation failure
+ */
+static int32_t tiled_create_tile(LifeTiledBoard* board, int64_t tr, int64_t tc) {
+    if (2 * (board->map_count + 1) > board->map_size &&
+        tiled_map_resize(board, board->map_size * 2) != 0) {
+        return -1;
+    }
+
+    int32_t index;
+    if (board->free_slots.count > 0) {
+        index = board->free_slots.items[--board->free_slots.count];
+    } else {
+        if (board->n_slots == board->capacity) {
+            const size_t capacity = board->capacity ? board->capacity * 2 : 64;
+            if (capacity > INT32_MAX) return -1;
+            LifeTile* tiles = (LifeTile*)realloc(board->tiles, capacity * sizeof(LifeTile));
+            if (!tiles) return -1;
+            board->tiles = tiles;
+            board->capacity = capacity;
+        }
+        index = (int32_t)board->n_slots++;
+    }
+
+    LifeTile* tile = &board->tiles[index];
+    memset(tile, 0, sizeof(LifeTile));
+    tile->tr = tr;
+    tile->tc = tc;
+    tile->prev = 1;
+    tile->in_use = true;
+    tiled_map_insert(board, index);
+    return index;
+}
+
+/**
+ * Tile at the given coordinates, created and queued as unstable if missing
+ *
+ * For loading cells between generations; pointers to other tiles are
+ * invalidated when a tile is created.
+ *
+ * @return Tile, or NULL on allocation failure
+ */
+static LifeTile* tiled_find_or_add(LifeTiledBoard* board, int64_t tr, int64_t tc) {
+    LifeTile* tile = tiled_find(board, tr, tc);
+    if (tile) return tile;
+    const int32_t index = tiled_create_tile(board, tr, tc);
+    if (index < 0 || tile_list_push(&board->unstable, index) != 0) return NULL;
+    tile = &board->tiles[index];
+    tile->unstable = true;
+    return tile;
+}
+
+static void tiled_release_tile(LifeTiledBoard* board, int32_t index) {
+    tiled_map_remove(board, index);
+    board->tiles[index].in_use = false;
+    // On allocation failure the slot is simply not reused
+    tile_list_push(&board->free_slots, index);
+}
+
+static void tiled_clear(LifeTiledBoard* board) {
+    board->n_slots = 0;
+    board->free_slots.count = 0;
+    board->changed.count = 0;
+    board->unstable.count = 0;
+    board->active.count = 0;
+    board->next_changed.count = 0;
+    board->next_unstable.count = 0;
+    board->flipped = 0;
+    memset(board->map, 0xff, board->map_size * sizeof(int32_t));
+    board->map_count = 0;
+    board->generation = 0;
+}
+
+// Rows of a neighbour tile, or dead cells if it does not exist
+static inline const uint64_t* tiled_rows(const LifeTiledBoard* board, int64_t tr, int64_t tc) {
+    const LifeTile* tile = tiled_find(board, tr, tc);
+    return tile ? TILE_ROWS(tile) : life_zero_tile;
+}
+
+/**
+ * Compute the next generation of one tile into its next buffer
+ */
+static void tiled_step_tile(const LifeTiledBoard* board, LifeTile* tile) {
+    const int64_t tr = tile->tr, tc = tile->tc;
+    const TileNeighbourhood area = {
+        tiled_rows(board, tr - 1, tc), tiled_rows(board, tr + 1, tc),
+        tiled_rows(board, tr, tc - 1), tiled_rows(board, tr, tc + 1), TILE_ROWS(tile),
+        tiled_rows(board, tr - 1, tc - 1)[LIFE_TILE_SIZE - 1],
+        tiled_rows(board, tr - 1, tc + 1)[LIFE_TILE_SIZE - 1],
+        tiled_rows(board, tr + 1, tc - 1)[0],
+        tiled_rows(board, tr + 1, tc + 1)[0]
+    };
+    uint64_t changed, unstable;
+    board->kernels->step_tile(&board->rule, &area, TILE_PREV(tile), TILE_NEXT(tile), &changed, &unstable);
+
+    // Only this tile's own flags are written; neighbours read rows and indices
+    tile->changed = changed != 0;
+    tile->unstable = unstable != 0;
+}
+
+/**
+ * Queue an unstable tile and the neighbours its change can reach
+ *
+ * Missing neighbours are created only where the tile has live cells on
+ * the shared edge or corner; elsewhere they stay dead.
+ *
+ * @return 0 on success, -1 on allocation failure
+ */
+static int tiled_queue_neighbourhood(LifeTiledBoard* board, int32_t index, uint64_t stamp) {
+    const LifeTile* tile = &board->tiles[index];
+    const int64_t tr = tile->tr, tc = tile->tc;
+    const uint64_t* rows = TILE_ROWS(tile);
+    const int last = LIFE_TILE_SIZE - 1;
+    uint64_t west = 0, east = 0;
+    for (int i = 0; i < LIFE_TILE_SIZE; i++) {
+        west |= rows[i] & 1ULL;
+        east |= rows[i] >> 63;
+    }
+    const uint64_t top = rows[0], bottom = rows[last];
+
+    for (int dr = -1; dr <= 1; dr++) {
+        for (int dc = -1; dc <= 1; dc++) {
+            LifeTile* other = tiled_find(board, tr + dr, tc + dc);
+            if (!other) {
+                const uint64_t edge_row = dr < 0 ? top : dr > 0 ? bottom : ~0ULL;
+                const uint64_t mask = dc < 0 ? 1ULL : dc > 0 ? 1ULL << 63 : ~0ULL;
+                const bool column_live = dc < 0 ? west != 0 : dc > 0 ? east != 0 : true;
+                const bool reaches = dr == 0 ? column_live : (edge_row & mask) != 0;
+                if (!reaches) continue;
+                const int32_t created = tiled_create_tile(board, tr + dr, tc + dc);
+                if (created < 0) return -1;
+                other = &board->tiles[created];
+                tile = &board->tiles[index];  // The tile array may have moved
+            }
+            if (other->stamp != stamp) {
+                other->stamp = stamp;
+                if (tile_list_push(&board->active, (int32_t)(other - board->tiles)) != 0) return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Step every active tile, in parallel when there is enough work
+ *
+ * All tiles read generation t and write only their own next buffer, so
+ * the buffers double as the halo: no copies are exchanged between
+ * workers.
+ */
+static void tiled_step_active(LifeTiledBoard* board) {
+    const uint32_t n_active = (uint32_t)board->active.count;
+    int workers = life_thread_count(board->threads);
+    if (n_active < LIFE_PARALLEL_MIN_TILES) workers = 1;
+
+    if (workers > 1 && board->n_ranges < workers) {
+        WorkRange* ranges = (WorkRange*)realloc(board->ranges, (size_t)workers * sizeof(WorkRange));
+        if (ranges) {
+            board->ranges = ranges;
+            board->n_ranges = workers;
+        } else {
+            workers = 1;
+        }
+    }
+
+    if (workers <= 1) {
+        for (uint32_t i = 0; i < n_active; i++) {
+            tiled_step_tile(board, &board->tiles[board->active.items[i]]);
+        }
+        return;
+    }
+
+    WorkRange* ranges = board->ranges;
+    #pragma omp parallel num_threads(workers)
+    {
+#ifdef _OPENMP
+        const int self = omp_get_thread_num();
+        const int team = omp_get_num_threads();
+#else
+        const int self = 0;
+        const int team = 1;
+#endif
+        const uint32_t begin = (uint32_t)((uint64_t)n_active * self / team);
+        const uint32_t end = (uint32_t)((uint64_t)n_active * (self + 1) / team);
+        atomic_store_explicit(&ranges[self].range, work_pack(begin, end), memory_order_release);
+        #pragma omp barrier
+
+        uint32_t first, stop;
+        for (;;) {
+            if (!work_claim(&ranges[self], LIFE_STEAL_CHUNK, &first, &stop)) {
+                if (!work_steal(ranges, self, team)) break;
+                continue;
+            }
+            for (uint32_t i = first; i < stop; i++) {
+                tiled_step_tile(board, &board->tiles[board->active.items[i]]);
+            }
+        }
+    }
+}
+
+/**
+ * Advance the tiled board by one generation
+ */
+static int tiled_step_once(LifeTiledBoard* board) {
+    const uint64_t stamp = board->generation + 1;
+
+    board->active.count = 0;
+    for (size_t i = 0; i < board->unstable.count; i++) {
+        if (tiled_queue_neighbourhood(board, board->unstable.items[i], stamp) != 0) return -1;
+    }
+
+    tiled_step_active(board);
+
+    // Everything below writes tiles, so it runs after every active tile has read its neighbours
+    board->next_changed.count = 0;
+    board->next_unstable.count = 0;
+    board->flipped = 0;
+
+    // Changed tiles outside the active set repeat with period 2: t + 1 is t - 1
+    for (size_t i = 0; i < board->changed.count; i++) {
+        const int32_t index = board->changed.items[i];
+        LifeTile* tile = &board->tiles[index];
+        if (tile->stamp == stamp) continue;
+        const uint8_t cur = tile->cur;
+        tile->cur = tile->prev;
+        tile->prev = cur;
+        tile->unstable = false;
+        board->flipped++;
+        if (tile_list_push(&board->next_changed, index) != 0) return -1;
+    }
+
+    for (size_t i = 0; i < board->active.count; i++) {
+        const int32_t index = board->active.items[i];
+        LifeTile* tile = &board->tiles[index];
+        const uint8_t next_index = (uint8_t)(3 - tile->cur - tile->prev);
+        tile->prev = tile->cur;
+        tile->cur = next_index;
+        if (tile->changed && tile_list_push(&board->next_changed, index) != 0) return -1;
+        if (tile->unstable && tile_list_push(&board->next_unstable, index) != 0) return -1;
+    }
+
+    // Drop tiles that are empty and settled
+    for (size_t i = 0; i < board->active.count; i++) {
+        const int32_t index = board->active.items[i];
+        const LifeTile* tile = &board->tiles[index];
+        if (tile->changed || tile->unstable) continue;
+        uint64_t any = 0;
+        for (int r = 0; r < LIFE_TILE_SIZE; r++) any |= TILE_ROWS(tile)[r];
+        if (!any) tiled_release_tile(board, index);
+    }
+
+    TileList done = board->changed;
+    board->changed = board->next_changed;
+    board->next_changed = done;
+    done = board->unstable;
+    board->unstable = board->next_unstable;
+    board->next_unstable = done;
+    board->generation++;
+    return 0;
+}
+
+/**
+ * Release a board created by life_tiled_create
+ */
+EXPORT void life_tiled_destroy(LifeTiledBoard* board) {
+    if (!board) return;
+    free(board->tiles);
+    free(board->map);
+    free(board->free_slots.items);
+    free(board->changed.items);
+    free(board->unstable.items);
+    free(board->active.items);
+    free(board->next_changed.items);
+    free(board->next_unstable.items);
+    free(board->ranges);
+    free(board);
+}
+
+/**
+ * Create an empty tiled board
+ *
+ * @return New board, or NULL on allocation failure
+ */
+EXPORT LifeTiledBoard* life_tiled_create(void) {
+    LifeTiledBoard* board = (LifeTiledBoard*)calloc(1, sizeof(LifeTiledBoard));
+    if (!board) return NULL;
+    if (tiled_map_resize(board, LIFE_TILE_MAP_MIN) != 0) {
+        life_tiled_destroy(board);
+        return NULL;
+    }
+    board->rule = life_conway_rule();
+    board->kernels = life_rule_kernels(board->rule);
+    return board;
+}
+
+/**
+ * Replace the board contents with the given live cells
+ *
+ * Every tile starts out unstable, so the first generation steps them all.
+ *
+ * @param cells Row-major (row, col) pairs, 2 * n_cells values
+ * @param n_cells Number of live cells
+ * @return 0 on success, -1 on error
+ */
+EXPORT int life_tiled_set_cells(LifeTiledBoard* board, const int64_t* cells, size_t n_cells) {
+    if (!board || (n_cells > 0 && !cells)) return -1;
+    tiled_clear(board);
+
+    for (size_t i = 0; i < n_cells; i++) {
+        const int64_t tr = floor_div64(cells[2 * i]);
+        const int64_t tc = floor_div64(cells[2 * i + 1]);
+        LifeTile* tile = tiled_find_or_add(board, tr, tc);
+        if (!tile) return -1;
+        const int64_t r = cells[2 * i] - tr * LIFE_TILE_SIZE;
+        const int64_t c = cells[2 * i + 1] - tc * LIFE_TILE_SIZE;
+        TILE_ROWS(tile)[r] |= 1ULL << c;
+    }
+    return 0;
+}
+
+/**
+ * Advance the tiled board by several generations
+ *
+ * @return 0 on success, -1 on allocation failure
+ */
+EXPORT int life_tiled_step(LifeTiledBoard* board, uint64_t generations) {
+    if (!board) return -1;
+    for (uint64_t g = 0; g < generations; g++) {
+        if (tiled_step_once(board) != 0) return -1;
+    }
+    return 0;
+}
+
+/**
+ * Set the worker threads used by life_tiled_step
+ *
+ * Active tiles are shared out by work stealing, so clustered activity
+ * keeps every worker busy.
+ *
+ * @param threads Thread count, 0 for the OpenMP default, 1 for serial stepping
+ * @return 0 on success, -1 on error
+ */
+EXPORT int life_tiled_set_threads(LifeTiledBoard* board, int threads) {
+    if (!board || threads < 0) return -1;
+    board->threads = threads;
+    return 0;
+}
+
+// Queue every tile for stepping, as after loading cells
+static int tiled_unsettle(LifeTiledBoard* board) {
+    board->unstable.count = 0;
+    for (size_t i = 0; i < board->n_slots; i++) {
+        if (!board->tiles[i].in_use) continue;
+        board->tiles[i].unstable = true;
+        if (tile_list_push(&board->unstable, (int32_t)i) != 0) return -1;
+    }
+    return 0;
+}
+
+static int tiled_apply_rule(LifeTiledBoard* board, LifeRule rule) {
+    if (!life_rule_valid(rule)) return -1;
+    const bool same = board->rule.birth == rule.birth && board->rule.survive == rule.survive;
+    board->rule = rule;
+    board->kernels = life_rule_kernels(rule);
+    // Tiles settled under the old rule need not be settled under the new one
+    return same ? 0 : tiled_unsettle(board);
+}
+
+/**
+ * Set the Life-like rule used by later steps; the cells are kept
+ *
+ * @param birth, survive Bit k set if a dead / live cell with k live neighbours is alive next
+ * @return 0 on success, -1 on error, allocation failure or for a B0 rule
+ */
+EXPORT int life_tiled_set_rule(LifeTiledBoard* board, uint16_t birth, uint16_t survive) {
+    if (!board) return -1;
+    const LifeRule rule = {birth, survive};
+    return tiled_apply_rule(board, rule);
+}
+
+/**
+ * Current rule masks, see life_tiled_set_rule
+ */
+EXPORT void life_tiled_get_rule(const LifeTiledBoard* board, uint16_t* birth_out, uint16_t* survive_out) {
+    if (!board) return;
+    if (birth_out) *birth_out = board->rule.birth;
+    if (survive_out) *survive_out = board->rule.survive;
+}
+
+/**
+ * Number of live cells
+ */
+EXPORT uint64_t life_tiled_population(const LifeTiledBoard* board) {
+    if (!board) return 0;
+    uint64_t population = 0;
+    for (size_t i = 0; i < board->n_slots; i++) {
+        if (!board->tiles[i].in_use) continue;
+        for (int r = 0; r < LIFE_TILE_SIZE; r++) {
+            population += (uint64_t)__builtin_popcountll(TILE_ROWS(&board->tiles[i])[r]);
+        }
+    }
+    return population;
+}
+
+/**
+ * Generations advanced since the last life_tiled_set_cells, plus any loaded from a file
+ */
+EXPORT uint64_t life_tiled_generation(const LifeTiledBoard* board) {
+    return board ? board->generation : 0;
+}
+
+/**
+ * Export the live cells, tile by tile
+ *
+ * @param cells_out Receives (row, col) pairs, 2 * capacity values (may be NULL if capacity is 0)
+ * @param capacity Maximum number of cells written
+ * @return Total number of live cells, which may exceed capacity
+ */
+EXPORT uint64_t life_tiled_get_cells(const LifeTiledBoard* board, int64_t* cells_out, uint64_t capacity) {
+    if (!board) return 0;
+    uint64_t count = 0;
+    for (size_t i = 0; i < board->n_slots; i++) {
+        const LifeTile* tile = &board->tiles[i];
+        if (!tile->in_use) continue;
+        for (int r = 0; r < LIFE_TILE_SIZE; r++) {
+            uint64_t bits = TILE_ROWS(tile)[r];
+            while (bits) {
+                const int b = __builtin_ctzll(bits);
+                if (count < capacity) {
+                    cells_out[2 * count] = tile->tr * LIFE_TILE_SIZE + r;
+                    cells_out[2 * count + 1] = tile->tc * LIFE_TILE_SIZE + b;
+                }
+                count++;
+                bits &= bits - 1;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * Render a viewport as one byte per cell
+ *
+ * Only tiles overlapping the viewport are visited.
+ *
+ * @param row0, col0 Top-left cell of the viewport
+ * @param height, width Viewport size in cells
+ * @param out Receives height * width bytes, row-major, 1 for live cells
+ * @return 0 on success, -1 on error
+ */
+EXPORT int life_tiled_render(const LifeTiledBoard* board, int64_t row0, int64_t col0,
+                             int64_t height, int64_t width, uint8_t* out) {
+    if (!board || height < 0 || width < 0 || (height * width > 0 && !out)) return -1;
+    if (height == 0 || width == 0) return 0;
+    memset(out, 0, (size_t)(height * width));
+
+    const int64_t tr_first = floor_div64(row0), tr_last = floor_div64(row0 + height - 1);
+    const int64_t tc_first = floor_div64(col0), tc_last = floor_div64(col0 + width - 1);
+    for (int64_t tr = tr_first; tr <= tr_last; tr++) {
+        for (int64_t tc = tc_first; tc <= tc_last; tc++) {
+            const LifeTile* tile = tiled_find(board, tr, tc);
+            if (!tile) continue;
+            const uint64_t* rows = TILE_ROWS(tile);
+            const int64_t base_r = tr * LIFE_TILE_SIZE, base_c = tc * LIFE_TILE_SIZE;
+            const int r_begin = base_r < row0 ? (int)(row0 - base_r) : 0;
+            const int r_end = base_r + LIFE_TILE_SIZE > row0 + height ? (int)(row0 + height - base_r) : LIFE_TILE_SIZE;
+            const int c_begin = base_c < col0 ? (int)(col0 - base_c) : 0;
+            const int c_end = base_c + LIFE_TILE_SIZE > col0 + width ? (int)(col0 + width - base_c) : LIFE_TILE_SIZE;
+            for (int r = r_begin; r < r_end; r++) {
+                uint8_t* line = out + (base_r + r - row0) * width + (base_c - col0);
+                for (int c = c_begin; c < c_end; c++) line[c] = (uint8_t)((rows[r] >> c) & 1);
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Tile statistics
+ *
+ * @param tiles_out Tiles currently stored (may be NULL)
+ * @param active_out Tiles stepped in the last generation (may be NULL)
+ * @param flipped_out Period-2 tiles flipped without stepping in the last generation (may be NULL)
+ */
+EXPORT void life_tiled_stats(const LifeTiledBoard* board, uint64_t* tiles_out,
+                             uint64_t* active_out, uint64_t* flipped_out) {
+    if (!board) return;
+    if (tiles_out) *tiles_out = board->map_count;
+    if (active_out) *active_out = board->active.count;
+    if (flipped_out) *flipped_out = board->flipped;
+}
+
+// HashLife
+//
+// The universe is a hash-consed quadtree: every distinct 2^k x 2^k block
+// is stored once, and each node memoizes its RESULT, the centre
+// 2^(k-1) x 2^(k-1) block advanced 2^(k-2) generations. Repeated
+// structure in space and time is then computed once, so periodic and
+// glider-heavy patterns can be run to 10^9+ generations. Arbitrary
+// generation counts are reached by advancing 2^j at a time for each set
+// bit j, with a second memo slot holding the most recent reduced step.
+
+#define HASHLIFE_BLOCK_NODES 65536      // Nodes per arena block
+#define HASHLIFE_MIN_BUCKETS 4096       // Initial hash table size
+#define HASHLIFE_MAX_LEVEL 62           // Root level cap, keeps coordinates in int64_t
+#define HASHLIFE_DEFAULT_MEMORY (1ULL << 30)  // Default node memory limit in bytes
+
+typedef struct HashNode {
+    struct HashNode* nw;
+    struct HashNode* ne;
+    struct HashNode* sw;
+    struct HashNode* se;
+    struct HashNode* result;       // Centre advanced 2^(level-2) generations
+    struct HashNode* step_result;  // Centre advanced 2^step_exp generations
+    struct HashNode* next;         // Hash chain, or free list link
+    uint64_t population;
+    uint8_t level;
+    int8_t step_exp;               // -1 while step_result is unset
+    uint8_t mark;
+} HashNode;
+
+typedef struct HashBlock {
+    struct HashBlock* next;
+    HashNode nodes[HASHLIFE_BLOCK_NODES];
+} HashBlock;
+
+typedef struct {
+    HashNode** buckets;
+    size_t n_buckets;         // Power of two
+    size_t n_nodes;           // Nodes in the table
+    HashNode* free_list;
+    HashBlock* blocks;
+    size_t n_blocks;
+    size_t max_nodes;         // GC threshold derived from the memory limit
+    uint64_t gc_runs;
+    HashNode* leaves[2];      // Dead and live cells, level 0
+    HashNode* empty[HASHLIFE_MAX_LEVEL + 2];  // Canonical empty node per level
+    HashNode* root;           // Centred on the origin: covers [-2^(L-1), 2^(L-1))
+    uint64_t generation;
+    LifeRule rule;            // Memoized results hold for this rule only
+} HashLifeUniverse;
+
+static inline size_t hash_children(const HashNode* nw, const HashNode* ne,
+                                   const HashNode* sw, const HashNode* se) {
+    uint64_t h = (uint64_t)(uintptr_t)nw * 0x9E3779B97F4A7C15ULL;
+    h ^= (uint64_t)(uintptr_t)ne * 0xC2B2AE3D27D4EB4FULL + (h << 6) + (h >> 2);
+    h ^= (uint64_t)(uintptr_t)sw * 0x165667B19E3779F9ULL + (h << 6) + (h >> 2);
+    h ^= (uint64_t)(uintptr_t)se * 0x27D4EB2F165667C5ULL + (h << 6) + (h >> 2);
+    return (size_t)(h ^ (h >> 29));
+}
+
+static HashNode* hashlife_alloc_node(HashLifeUniverse* u) {
+    if (!u->free_list) {
+        HashBlock* block = (HashBlock*)malloc(sizeof(HashBlock));
+        if (!block) return NULL;
+        block->next = u->blocks;
+        u->blocks = block;
+        u->n_blocks++;
+        for (size_t i = HASHLIFE_BLOCK_NODES; i-- > 0;) {
+            block->nodes[i].next = u->free_list;
+            u->free_list = &block->nodes[i];
+        }
+    }
+    HashNode* node = u->free_list;
+    u->free_list = node->next;
+    return node;
+}
+
+static int hashlife_grow_table(HashLifeUniverse* u) {
+    const size_t n_buckets = u->n_buckets * 2;
+    HashNode** buckets = (HashNode**)calloc(n_buckets, sizeof(HashNode*));
+    if (!buckets) return -1;
+    for (size_t b = 0; b < u->n_buckets; b++) {
+        HashNode* node = u->buckets[b];
+        while (node) {
+            HashNode* next = node->next;
+            const size_t slot = hash_children(node->nw, node->ne, node->sw, node->se) & (n_buckets - 1);
+            node->next = buckets[slot];
+            buckets[slot] = node;
+            node = next;
+        }
+    }
+    free(u->buckets);
+    u->buckets = buckets;
+    u->n_buckets = n_buckets;
+    return 0;
+}
+
+/**
+ * Canonical node with the given children
+ *
+ * @return Shared node, or NULL on allocation failure
+ */
+static HashNode* hashlife_join(HashLifeUniverse* u, HashNode* nw, HashNode* ne, HashNode* sw, HashNode* se) {
+    if (!nw || !ne || !sw || !se) return NULL;
+    const size_t h = hash_children(nw, ne, sw, se);
+    for (HashNode* node = u->buckets[h & (u->n_buckets - 1)]; node; node = node->next) {
+        if (node->nw == nw && node->ne == ne && node->sw == sw && node->se == se) return node;
+    }
+
+    if (u->n_nodes >= u->n_buckets && hashlife_grow_table(u) != 0) return NULL;
+    HashNode* node = hashlife_alloc_node(u);
+    if (!node) return NULL;
+    node->nw = nw;
+    node->ne = ne;
+    node->sw = sw;
+    node->se = se;
+    node->result = NULL;
+    node->step_result = NULL;
+    node->population = nw->population + ne->population + sw->population + se->population;
+    node->level = (uint8_t)(nw->level + 1);
+    node->step_exp = -1;
+    node->mark = 0;
+
+    const size_t slot = h & (u->n_buckets - 1);
+    node->next = u->buckets[slot];
+    u->buckets[slot] = node;
+    u->n_nodes++;
+    return node;
+}
+
+static HashNode* hashlife_empty(HashLifeUniverse* u, int level) {
+    for (int l = 1; l <= level && !u->empty[level]; l++) {
+        if (!u->empty[l]) u->empty[l] = hashlife_join(u, u->empty[l - 1], u->empty[l - 1],
+                                                      u->empty[l - 1], u->empty[l - 1]);
+    }
+    return u->empty[level];
+}
+
+// Centre 2^(k-1) block of a level-k node, k >= 2
+static inline HashNode* hashlife_centre(HashLifeUniverse* u, HashNode* n) {
+    return hashlife_join(u, n->nw->se, n->ne->sw, n->sw->ne, n->se->nw);
+}
+
+/**
+ * One generation of the centre 2x2 of a 4x4 block
+ */
+static HashNode* hashlife_base_step(HashLifeUniverse* u, HashNode* n) {
+    // Bit r * 4 + c holds cell (r, c)
+    HashNode* quads[4] = {n->nw, n->ne, n->sw, n->se};
+    unsigned cells = 0;
+    for (int q = 0; q < 4; q++) {
+        const int r0 = (q >> 1) * 2, c0 = (q & 1) * 2;
+        HashNode* leaves[4] = {quads[q]->nw, quads[q]->ne, quads[q]->sw, quads[q]->se};
+        for (int l = 0; l < 4; l++) {
+            if (leaves[l]->population) cells |= 1u << ((r0 + (l >> 1)) * 4 + c0 + (l & 1));
+        }
+    }
+
+    HashNode* out[4];
+    for (int i = 0; i < 4; i++) {
+        const int r = 1 + (i >> 1), c = 1 + (i & 1);
+        int count = 0;
+        for (int dr = -1; dr <= 1; dr++) {
+            for (int dc = -1; dc <= 1; dc++) {
+                if (dr || dc) count += (cells >> ((r + dr) * 4 + c + dc)) & 1;
+            }
+        }
+        const bool alive = (cells >> (r * 4 + c)) & 1;
+        out[i] = u->leaves[((alive ? u->rule.survive : u->rule.birth) >> count) & 1];
+    }
+    return hashlife_join(u, out[0], out[1], out[2], out[3]);
+}
+
+/**
+ * Centre of a level-k node advanced 2^step_exp generations, step_exp <= k - 2
+ *
+ * @return Level k-1 node, or NULL on allocation failure
+ */
+static HashNode* hashlife_successor(HashLifeUniverse* u, HashNode* n, int step_exp) {
+    const int k = n->level;
+    const bool full = step_exp == k - 2;
+    if (n->population == 0) return hashlife_empty(u, k - 1);
+    if (full && n->result) return n->result;
+    if (!full && n->step_exp == step_exp && n->step_result) return n->step_result;
+
+    HashNode* result;
+    if (k == 2) {
+        result = hashlife_base_step(u, n);
+    } else {
+        // Nine overlapping level k-1 blocks
+        HashNode* sub[9] = {
+            n->nw,
+            hashlife_join(u, n->nw->ne, n->ne->nw, n->nw->se, n->ne->sw),
+            n->ne,
+            hashlife_join(u, n->nw->sw, n->nw->se, n->sw->nw, n->sw->ne),
+            hashlife_centre(u, n),
+            hashlife_join(u, n->ne->sw, n->ne->se, n->se->nw, n->se->ne),
+            n->sw,
+            hashlife_join(u, n->sw->ne, n->se->nw, n->sw->se, n->se->sw),
+            n->se
+        };
+
+        // Full speed spends half the step here; otherwise just take centres
+        HashNode* part[9];
+        for (int i = 0; i < 9; i++) {
+            if (!sub[i]) return NULL;
+            part[i] = full ? hashlife_successor(u, sub[i], step_exp - 1) : hashlife_centre(u, sub[i]);
+            if (!part[i]) return NULL;
+        }
+
+        const int inner_exp = full ? step_exp - 1 : step_exp;
+        HashNode* nw = hashlife_join(u, part[0], part[1], part[3], part[4]);
+        HashNode* ne = hashlife_join(u, part[1], part[2], part[4], part[5]);
+        HashNode* sw = hashlife_join(u, part[3], part[4], part[6], part[7]);
+        HashNode* se = hashlife_join(u, part[4], part[5], part[7], part[8]);
+        if (!nw || !ne || !sw || !se) return NULL;
+        result = hashlife_join(u,
+                               hashlife_successor(u, nw, inner_exp),
+                               hashlife_successor(u, ne, inner_exp),
+                               hashlife_successor(u, sw, inner_exp),
+                               hashlife_successor(u, se, inner_exp));
+    }
+    if (!result) return NULL;
+
+    if (full) {
+        n->result = result;
+    } else {
+        n->step_result = result;
+        n->step_exp = (int8_t)step_exp;
+    }
+    return result;
+}
+
+// Root one level up with the old root in the centre
+static HashNode* hashlife_expand(HashLifeUniverse* u, HashNode* root) {
+    HashNode* e = hashlife_empty(u, root->level - 1);
+    return hashlife_join(u,
+                         hashlife_join(u, e, e, e, root->nw),
+                         hashlife_join(u, e, e, root->ne, e),
+                         hashlife_join(u, e, root->sw, e, e),
+                         hashlife_join(u, root->se, e, e, e));
+}
+
+// True if every live cell lies in the centre half of the root
+static bool hashlife_centred(const HashNode* root) {
+    if (root->level < 2) return root->population == 0;
+    return root->population == root->nw->se->population + root->ne->sw->population +
+                               root->sw->ne->population + root->se->nw->population;
+}
+
+static void hashlife_mark(HashNode* node) {
+    while (node && !node->mark) {
+        node->mark = 1;
+        if (node->level == 0) return;
+        hashlife_mark(node->nw);
+        hashlife_mark(node->ne);
+        hashlife_mark(node->sw);
+        node = node->se;
+    }
+}
+
+/**
+ * Free every node not reachable from the root
+ *
+ * Memoized results survive only when their target survives, so the
+ * cache is trimmed to what the current pattern can reuse.
+ */
+static void hashlife_collect(HashLifeUniverse* u) {
+    hashlife_mark(u->leaves[0]);
+    hashlife_mark(u->leaves[1]);
+    for (int level = 0; level <= HASHLIFE_MAX_LEVEL + 1; level++) hashlife_mark(u->empty[level]);
+    hashlife_mark(u->root);
+
+    for (size_t b = 0; b < u->n_buckets; b++) {
+        HashNode** link = &u->buckets[b];
+        while (*link) {
+            HashNode* node = *link;
+            if (node->mark) {
+                if (node->result && !node->result->mark) node->result = NULL;
+                if (node->step_result && !node->step_result->mark) {
+                    node->step_result = NULL;
+                    node->step_exp = -1;
+                }
+                link = &node->next;
+            } else {
+                *link = node->next;
+                node->next = u->free_list;
+                u->free_list = node;
+                u->n_nodes--;
+            }
+        }
+    }
+
+    // Clear marks; leaves are not in the table
+    for (size_t b = 0; b < u->n_buckets; b++) {
+        for (HashNode* node = u->buckets[b]; node; node = node->next) node->mark = 0;
+    }
+    u->leaves[0]->mark = 0;
+    u->leaves[1]->mark = 0;
+    u->gc_runs++;
+}
+
+static void hashlife_maybe_collect(HashLifeUniverse* u) {
+    if (u->n_nodes > u->max_nodes) hashlife_collect(u);
+}
+
+// Switch rules, dropping every memoized result when the rule changes
+static int hashlife_apply_rule(HashLifeUniverse* u, LifeRule rule) {
+    if (!life_rule_valid(rule)) return -1;
+    if (u->rule.birth == rule.birth && u->rule.survive == rule.survive) return 0;
+    u->rule = rule;
+    for (size_t b = 0; b < u->n_buckets; b++) {
+        for (HashNode* node = u->buckets[b]; node; node = node->next) {
+            node->result = NULL;
+            node->step_result = NULL;
+            node->step_exp = -1;
+        }
+    }
+    return 0;
+}
+
+// Node with the cell at (r, c) set, relative to the node's top-left corner
+static HashNode* hashlife_set_cell(HashLifeUniverse* u, HashNode* node, uint64_t r, uint64_t c) {
+    if (node->level == 0) return u->leaves[1];
+    const uint64_t half = 1ULL << (node->level - 1);
+    HashNode* nw = node->nw;
+    HashNode* ne = node->ne;
+    HashNode* sw = node->sw;
+    HashNode* se = node->se;
+    if (r < half) {
+        if (c < half) nw = hashlife_set_cell(u, nw, r, c);
+        else ne = hashlife_set_cell(u, ne, r, c - half);
+    } else {
+        if (c < half) sw = hashlife_set_cell(u, sw, r - half, c);
+        else se = hashlife_set_cell(u, se, r - half, c - half);
+    }
+    return hashlife_join(u, nw, ne, sw, se);
+}
+
+static uint64_t hashlife_collect_cells(const HashNode* node, int64_t row, int64_t col,
+                                       int64_t* cells_out, uint64_t capacity, uint64_t count) {
+    if (node->population == 0) return count;
+    if (node->level == 0) {
+        if (count < capacity) {
+            cells_out[2 * count] = row;
+            cells_out[2 * count + 1] = col;
+        }
+        return count + 1;
+    }
+    const int64_t half = (int64_t)1 << (node->level - 1);
+    count = hashlife_collect_cells(node->nw, row, col, cells_out, capacity, count);
+    count = hashlife_collect_cells(node->ne, row, col + half, cells_out, capacity, count);
+    count = hashlife_collect_cells(node->sw, row + half, col, cells_out, capacity, count);
+    return hashlife_collect_cells(node->se, row + half, col + half, cells_out, capacity, count);
+}
+
+static void hashlife_render_node(const HashNode* node, int64_t row, int64_t col,
+                                 int64_t row0, int64_t col0, int64_t height, int64_t width, uint8_t* out) {
+    if (node->population == 0) return;
+    const int64_t size = (int64_t)1 << node->level;
+    if (row >= row0 + height || col >= col0 + width || row + size <= row0 || col + size <= col0) return;
+    if (node->level == 0) {
+        out[(row - row0) * width + (col - col0)] = 1;
+        return;
+    }
+    const int64_t half = size / 2;
+    hashlife_render_node(node->nw, row, col, row0, col0, height, width, out);
+    hashlife_render_node(node->ne, row, col + half, row0, col0, height, width, out);
+    hashlife_render_node(node->sw, row + half, col, row0, col0, height, width, out);
+    hashlife_render_node(node->se, row + half, col + half, row0, col0, height, width, out);
+}
+
+/**
+ * Release a universe created by hashlife_create
+ */
+EXPORT void hashlife_destroy(HashLifeUniverse* u) {
+    if (!u) return;
+    while (u->blocks) {
+        HashBlock* next = u->blocks->next;
+        free(u->blocks);
+        u->blocks = next;
+    }
+    free(u->buckets);
+    free(u->leaves[0]);
+    free(u->leaves[1]);
+    free(u);
+}
+
+/**
+ * Smallest node memory limit in bytes: one arena block (about 4.7 MB)
+ *
+ * Nodes are allocated a block at a time, so smaller limits cannot be kept.
+ */
+EXPORT uint64_t hashlife_min_memory_limit(void) {
+    return (uint64_t)HASHLIFE_BLOCK_NODES * sizeof(HashNode);
+}
+
+/**
+ * Set the node memory limit
+ *
+ * The limit is checked between jumps: when exceeded, nodes unreachable
+ * from the current pattern are collected. A single jump may overshoot it.
+ * Limits below hashlife_min_memory_limit() are raised to it.
+ *
+ * @param memory_bytes Limit in bytes, 0 for the default
+ */
+EXPORT void hashlife_set_memory_limit(HashLifeUniverse* u, uint64_t memory_bytes) {
+    if (!u) return;
+    if (memory_bytes == 0) memory_bytes = HASHLIFE_DEFAULT_MEMORY;
+    u->max_nodes = (size_t)(memory_bytes / sizeof(HashNode));
+    if (u->max_nodes < HASHLIFE_BLOCK_NODES) u->max_nodes = HASHLIFE_BLOCK_NODES;
+}
+
+/**
+ * Set the Life-like rule used by later steps; the pattern is kept
+ *
+ * Memoized results belong to the old rule and are dropped.
+ *
+ * @param birth, survive Bit k set if a dead / live cell with k live neighbours is alive next
+ * @return 0 on success, -1 on error or for a B0 rule
+ */
+EXPORT int hashlife_set_rule(HashLifeUniverse* u, uint16_t birth, uint16_t survive) {
+    if (!u) return -1;
+    const LifeRule rule = {birth, survive};
+    return hashlife_apply_rule(u, rule);
+}
+
+/**
+ * Current rule masks, see hashlife_set_rule
+ */
+EXPORT void hashlife_get_rule(const HashLifeUniverse* u, uint16_t* birth_out, uint16_t* survive_out) {
+    if (!u) return;
+    if (birth_out) *birth_out = u->rule.birth;
+    if (survive_out) *survive_out = u->rule.survive;
+}
+
+/**
+ * Create an empty universe
+ *
+ * @param memory_bytes Node memory limit in bytes, 0 for the default (1 GiB);
+ *                     see hashlife_set_memory_limit
+ * @return New universe, or NULL on allocation failure
+ */
+EXPORT HashLifeUniverse* hashlife_create(uint64_t memory_bytes) {
+    HashLifeUniverse* u = (HashLifeUniverse*)calloc(1, sizeof(HashLifeUniverse));
+    if (!u) return NULL;
+    u->n_buckets = HASHLIFE_MIN_BUCKETS;
+    u->buckets = (HashNode**)calloc(u->n_buckets, sizeof(HashNode*));
+    for (int alive = 0; alive < 2; alive++) {
+        u->leaves[alive] = (HashNode*)calloc(1, sizeof(HashNode));
+        if (u->leaves[alive]) {
+            u->leaves[alive]->population = (uint64_t)alive;
+            u->leaves[alive]->step_exp = -1;
+        }
+    }
+    if (!u->buckets || !u->leaves[0] || !u->leaves[1]) {
+        hashlife_destroy(u);
+        return NULL;
+    }
+    u->empty[0] = u->leaves[0];
+    u->rule = life_conway_rule();
+    hashlife_set_memory_limit(u, memory_bytes);
+    u->root = hashlife_empty(u, 3);
+    if (!u->root) {
+        hashlife_destroy(u);
+        return NULL;
+    }
+    return u;
+}
+
+/**
+ * Replace the universe contents with the given live cells
+ *
+ * @param cells Row-major (row, col) pairs, 2 * n_cells values
+ * @param n_cells Number of live cells
+ * @return 0 on success, -1 on error
+ */
+EXPORT int hashlife_set_cells(HashLifeUniverse* u, const int64_t* cells, size_t n_cells) {
+    if (!u || (n_cells > 0 && !cells)) return -1;
+
+    // Smallest centred root that holds every cell
+    int level = 3;
+    for (size_t i = 0; i < 2 * n_cells; i++) {
+        const int64_t v = cells[i];
+        while (level <= HASHLIFE_MAX_LEVEL &&
+               (v < -((int64_t)1 << (level - 1)) || v >= ((int64_t)1 << (level - 1)))) {
+            level++;
+        }
+    }
+    if (level > HASHLIFE_MAX_LEVEL) return -1;
+
+    HashNode* root = hashlife_empty(u, level);
+    const int64_t offset = (int64_t)1 << (level - 1);
+    for (size_t i = 0; i < n_cells && root; i++) {
+        u->root = root;  // Reachable if a collection runs mid-build
+        root = hashlife_set_cell(u, root, (uint64_t)(cells[2 * i] + offset), (uint64_t)(cells[2 * i + 1] + offset));
+        if (root && (i & 4095) == 4095) {
+            u->root = root;
+            hashlife_maybe_collect(u);
+        }
+    }
+    if (!root) return -1;
+    u->root = root;
+    u->generation = 0;
+    hashlife_maybe_collect(u);
+    return 0;
+}
+
+/**
+ * Advance the universe by any number of generations
+ *
+ * Each set bit j of generations is one jump of 2^j generations; the root
+ * is padded first so nothing can escape it during the jump.
+ *
+ * @return 0 on success, -1 on allocation failure or if the pattern outgrows the coordinate range
+ */
+EXPORT int hashlife_step(HashLifeUniverse* u, uint64_t generations) {
+    if (!u) return -1;
+    for (int j = 0; j < 64 && (generations >> j) != 0; j++) {
+        if (!((generations >> j) & 1)) continue;
+
+        HashNode* root = u->root;
+        while (root && (root->level < j + 3 || !hashlife_centred(root))) {
+            if (root->level >= HASHLIFE_MAX_LEVEL) return -1;
+            root = hashlife_expand(u, root);
+        }
+        // The jump keeps only the centre half of the root; one more level
+        // puts the pattern in the centre quarter, beyond its reach
+        if (root && root->level >= HASHLIFE_MAX_LEVEL) return -1;
+        if (root) root = hashlife_expand(u, root);
+        if (!root) return -1;
+        root = hashlife_successor(u, root, j);
+        if (!root) return -1;
+
+        u->root = root;
+        u->generation += 1ULL << j;
+        hashlife_maybe_collect(u);
+    }
+    return 0;
+}
+
+/**
+ * Number of live cells
+ */
+EXPORT uint64_t hashlife_population(const HashLifeUniverse* u) {
+    return u ? u->root->population : 0;
+}
+
+/**
+ * Generations advanced since the last hashlife_set_cells, plus any loaded from a file
+ */
+EXPORT uint64_t hashlife_generation(const HashLifeUniverse* u) {
+    return u ? u->generation : 0;
+}
+
+/**
+ * Export the live cells
+ *
+ * @param cells_out Receives (row, col) pairs, 2 * capacity values (may be NULL if capacity is 0)
+ * @param capacity Maximum number of cells written
+ * @return Total number of live cells, which may exceed capacity
+ */
+EXPORT uint64_t hashlife_get_cells(const HashLifeUniverse* u, int64_t* cells_out, uint64_t capacity) {
+    if (!u) return 0;
+    const int64_t offset = (int64_t)1 << (u->root->level - 1);
+    return hashlife_collect_cells(u->root, -offset, -offset, cells_out, capacity, 0);
+}
+
+/**
+ * Render a viewport as one byte per cell
+ *
+ * Empty and off-screen quadrants are skipped whole.
+ *
+ * @param row0, col0 Top-left cell of the viewport
+ * @param height, width Viewport size in cells
+ * @param out Receives height * width bytes, row-major, 1 for live cells
+ * @return 0 on success, -1 on error
+ */
+EXPORT int hashlife_render(const HashLifeUniverse* u, int64_t row0, int64_t col0,
+                           int64_t height, int64_t width, uint8_t* out) {
+    if (!u || height < 0 || width < 0 || (height * width > 0 && !out)) return -1;
+    if (height == 0 || width == 0) return 0;
+    memset(out, 0, (size_t)(height * width));
+    const int64_t offset = (int64_t)1 << (u->root->level - 1);
+    hashlife_render_node(u->root, -offset, -offset, row0, col0, height, width, out);
+    return 0;
+}
+
+/**
+ * Node cache statistics
+ *
+ * @param nodes_out Canonical nodes currently stored (may be NULL)
+ * @param bytes_out Bytes held by node blocks and the hash table (may be NULL)
+ * @param gc_runs_out Collections run so far (may be NULL)
+ */
+EXPORT void hashlife_memory_stats(const HashLifeUniverse* u, uint64_t* nodes_out,
+                                  uint64_t* bytes_out, uint64_t* gc_runs_out) {
+    if (!u) return;
+    if (nodes_out) *nodes_out = u->n_nodes;
+    if (bytes_out) *bytes_out = u->n_blocks * sizeof(HashBlock) + u->n_buckets * sizeof(HashNode*);
+    if (gc_runs_out) *gc_runs_out = u->gc_runs;
+}
+
+// Pattern files
+//
+// RLE and Macrocell files are memory-mapped and parsed in place, straight
+// into tiles or quadtree nodes, so loading a large pattern never builds a
+// cell list. RLE is native to the tiled board and Macrocell to HashLife;
+// the other engine converts one 64 x 64 block at a time. Checkpoints
+// store the same structures in binary: every non-empty tile, or every
+// distinct quadtree node once in post-order, so a long HashLife run saves
+// in proportion to its node count rather than its population.
+
+#define LIFE_RLE_LINE 70                     // Longest RLE body line written
+#define LIFE_PATTERN_LIMIT ((int64_t)1 << 60)  // Largest coordinate magnitude read from a file
+#define LIFE_WRITE_BUFFER (1 << 20)          // stdio buffer for pattern and checkpoint files
+#define LIFE_CHECKPOINT_TILES 1              // Checkpoint of tile records
+#define LIFE_CHECKPOINT_NODES 2              // Checkpoint of quadtree node records
+
+static const char life_checkpoint_magic[8] = {'L', 'I', 'F', 'E', 'C', 'K', 'P', '1'};
+
+// Checkpoint file header, followed by count records; native byte order
+typedef struct {
+    char magic[8];
+    uint32_t engine;          // LIFE_CHECKPOINT_TILES or LIFE_CHECKPOINT_NODES
+    uint32_t rule;            // Birth mask, survive mask << 16
+    uint64_t generation;
+    uint64_t count;
+} CheckpointHeader;
+
+typedef struct {
+    int64_t tr;
+    int64_t tc;
+    uint64_t rows[LIFE_TILE_SIZE];
+} CheckpointTile;
+
+typedef struct {
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+} MappedFile;
+
+static void unmap_file(MappedFile* mf) {
+#ifdef _WIN32
+    if (mf->data) UnmapViewOfFile(mf->data);
+    if (mf->mapping) CloseHandle(mf->mapping);
+    if (mf->file && mf->file != INVALID_HANDLE_VALUE) CloseHandle(mf->file);
+#else
+    if (mf->data) munmap((void*)mf->data, mf->size);
+#endif
+    memset(mf, 0, sizeof(MappedFile));
+}
+
+/**
+ * Map a whole file read-only; an empty file maps to NULL data
+ *
+ * @return 0 on success, -1 if the file cannot be opened or mapped
+ */
+static int map_file(const char* path, MappedFile* mf) {
+    memset(mf, 0, sizeof(MappedFile));
+#ifdef _WIN32
+    mf->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                           FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    LARGE_INTEGER size;
+    if (mf->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(mf->file, &size)) {
+        unmap_file(mf);
+        return -1;
+    }
+    mf->size = (size_t)size.QuadPart;
+    if (mf->size == 0) return 0;
+    mf->mapping = CreateFileMappingA(mf->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mf->mapping) mf->data = (const char*)MapViewOfFile(mf->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!mf->data) {
+        unmap_file(mf);
+        return -1;
+    }
+    return 0;
+#else
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return -1;
+    }
+    mf->size = (size_t)st.st_size;
+    if (mf->size > 0) {
+        void* data = mmap(NULL, mf->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            mf->size = 0;
+            return -1;
+        }
+        madvise(data, mf->size, MADV_SEQUENTIAL);
+        mf->data = (const char*)data;
+    }
+    close(fd);  // The mapping outlives the descriptor
+    return 0;
+#endif
+}
+
+static FILE* open_output(const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (file) setvbuf(file, NULL, _IOFBF, LIFE_WRITE_BUFFER);
+    return file;
+}
+
+// Close a file opened by open_output, reporting any write error
+static int close_output(FILE* file, int status) {
+    if (ferror(file)) status = -1;
+    if (fclose(file) != 0) status = -1;
+    return status;
+}
+
+static inline const char* line_end(const char* p, const char* end) {
+    const char* nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+    return nl ? nl : end;
+}
+
+static inline const char* skip_blanks(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    return p;
+}
+
+// Parse an unsigned decimal after optional blanks
+static bool parse_uint64(const char** pp, const char* end, uint64_t* out) {
+    const char* p = skip_blanks(*pp, end);
+    if (p == end || *p < '0' || *p > '9') return false;
+    uint64_t value = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; p++) {
+        const uint64_t digit = (uint64_t)(*p - '0');
+        if (value > (UINT64_MAX - digit) / 10) return false;
+        value = value * 10 + digit;
+    }
+    *pp = p;
+    *out = value;
+    return true;
+}
+
+// Parse a signed decimal within LIFE_PATTERN_LIMIT after optional blanks
+static bool parse_coordinate(const char** pp, const char* end, int64_t* out) {
+    const char* p = skip_blanks(*pp, end);
+    const bool negative = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+')) p++;
+    uint64_t magnitude;
+    if (!parse_uint64(&p, end, &magnitude) || magnitude > (uint64_t)LIFE_PATTERN_LIMIT) return false;
+    *pp = p;
+    *out = negative ? -(int64_t)magnitude : (int64_t)magnitude;
+    return true;
+}
+
+/**
+ * Parse a rule string up to a comma or the end of the line
+ *
+ * Accepts B/S notation in either order (B36/S23, S23/B36) and the older
+ * survive/birth digits (23/36); case and blanks are ignored. Bounded-grid
+ * suffixes and other neighbourhoods are not accepted.
+ *
+ * @return 0 on success, -1 on a malformed or B0 rule
+ */
+static int parse_rule(const char* p, const char* end, LifeRule* rule) {
+    uint16_t masks[2] = {0, 0};   // Sections in order of appearance
+    int kinds[2] = {-1, -1};      // 0 birth, 1 survive, -1 unmarked
+    int section = 0;
+    for (; p < end && *p != ',' && *p != '\n'; p++) {
+        const char ch = (char)(*p >= 'A' && *p <= 'Z' ? *p - 'A' + 'a' : *p);
+        if (ch == ' ' || ch == '\t' || ch == '\r') continue;
+        if (ch == '/') {
+            if (++section > 1) return -1;
+        } else if ((ch == 'b' || ch == 's') && kinds[section] < 0 && masks[section] == 0) {
+            kinds[section] = ch == 's';
+        } else if (ch >= '0' && ch <= '8') {
+            masks[section] |= (uint16_t)(1u << (ch - '0'));
+        } else {
+            return -1;
+        }
+    }
+    if (section != 1) return -1;
+    if (kinds[0] < 0 && kinds[1] < 0) {
+        rule->survive = masks[0];
+        rule->birth = masks[1];
+    } else if (kinds[0] >= 0 && kinds[1] >= 0 && kinds[0] != kinds[1]) {
+        rule->birth = masks[kinds[0] == 1];
+        rule->survive = masks[kinds[0] == 0];
+    } else {
+        return -1;
+    }
+    return life_rule_valid(*rule) ? 0 : -1;
+}
+
+// Format a rule as B.../S..., at least 22 bytes
+static void format_rule(LifeRule rule, char* out) {
+    *out++ = 'B';
+    for (int k = 0; k <= 8; k++) {
+        if ((rule.birth >> k) & 1) *out++ = (char)('0' + k);
+    }
+    *out++ = '/';
+    *out++ = 'S';
+    for (int k = 0; k <= 8; k++) {
+        if ((rule.survive >> k) & 1) *out++ = (char)('0' + k);
+    }
+    *out = '\0';
+}
+
+// Receives each horizontal run of live cells read from a pattern file
+typedef int (*LiveRunSink)(void* target, int64_t row, int64_t col, int64_t length);
+
+/**
+ * Parse an RLE pattern
+ *
+ * The top-left of the pattern is placed at the origin, or at the Pos of
+ * an extended #CXRLE header. Any state other than b and . is live. The
+ * "x = ..., y = ..." header is required, after any comment lines, so
+ * files in other formats are rejected rather than read as runs.
+ *
+ * @param generation_out Receives the Gen of a #CXRLE header, 0 without one
+ * @param rule_out Receives the header's rule, B3/S23 without one
+ * @return 0 on success, -1 on a malformed file or rule, or a sink error
+ */
+static int parse_rle(const char* p, const char* end, LiveRunSink sink, void* target,
+                     uint64_t* generation_out, LifeRule* rule_out) {
+    int64_t row0 = 0, col0 = 0;
+    bool has_header = false;
+    *generation_out = 0;
+    *rule_out = life_conway_rule();
+
+    // Comment lines and the size header
+    for (;;) {
+        p = skip_blanks(p, end);
+        if (p < end && *p == '\n') {
+            p++;
+        } else if (p < end && *p == '#') {
+            const char* eol = line_end(p, end);
+            if (eol - p >= 6 && memcmp(p, "#CXRLE", 6) == 0) {
+                for (const char* q = p + 6; q < eol; q++) {
+                    if (eol - q >= 4 && memcmp(q, "Pos=", 4) == 0) {
+                        q += 4;
+                        if (!parse_coordinate(&q, eol, &col0) || q == eol || *q != ',') return -1;
+                        q++;
+                        if (!parse_coordinate(&q, eol, &row0)) return -1;
+                    } else if (eol - q >= 4 && memcmp(q, "Gen=", 4) == 0) {
+                        q += 4;
+                        if (!parse_uint64(&q, eol, generation_out)) return -1;
+                    }
+                    if (q == eol) break;
+                }
+            }
+            p = eol;
+        } else if (p < end && *p == 'x') {
+            // x = width, y = height; the size itself is implied by the runs
+            const char* eol = line_end(p, end);
+            const char* q = skip_blanks(p + 1, eol);
+            uint64_t size;
+            if (q == eol || *q++ != '=' || !parse_uint64(&q, eol, &size)) return -1;
+            q = skip_blanks(q, eol);
+            if (q == eol || *q++ != ',') return -1;
+            q = skip_blanks(q, eol);
+            if (q == eol || *q++ != 'y') return -1;
+            q = skip_blanks(q, eol);
+            if (q == eol || *q++ != '=' || !parse_uint64(&q, eol, &size)) return -1;
+            for (; q + 4 <= eol; q++) {
+                if (memcmp(q, "rule", 4) == 0) {
+                    q = skip_blanks(q + 4, eol);
+                    if (q == eol || *q != '=') return -1;
+                    if (parse_rule(q + 1, eol, rule_out) != 0) return -1;
+                    break;
+                }
+            }
+            p = eol;
+            has_header = true;
+            break;
+        } else {
+            break;
+        }
+    }
+    if (!has_header) return -1;
+
+    int64_t row = row0, col = col0;
+    uint64_t count = 0;
+    while (p < end) {
+        const char ch = *p++;
+        if (ch >= '0' && ch <= '9') {
+            count = count * 10 + (uint64_t)(ch - '0');
+            if (count > (uint64_t)LIFE_PATTERN_LIMIT) return -1;
+            continue;
+        }
+        if (ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n') continue;
+
+        const int64_t n = count ? (int64_t)count : 1;
+        count = 0;
+        if (ch == '!') return 0;
+        if (ch == '$') {
+            row += n;
+            col = col0;
+        } else if (ch == 'b' || ch == '.') {
+            col += n;
+        } else if (ch == '*' || (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z')) {
+            if (col + n > LIFE_PATTERN_LIMIT || sink(target, row, col, n) != 0) return -1;
+            col += n;
+        } else if (ch == '#') {
+            p = line_end(p, end);
+        } else {
+            return -1;
+        }
+        if (row > LIFE_PATTERN_LIMIT || col > LIFE_PATTERN_LIMIT) return -1;
+    }
+    return 0;  // A missing '!' ends the pattern at the end of the file
+}
+
+// LiveRunSink setting cells of a tiled board
+static int tiled_add_run(void* target, int64_t row, int64_t col, int64_t length) {
+    LifeTiledBoard* board = (LifeTiledBoard*)target;
+    const int64_t tr = floor_div64(row);
+    const int r = (int)(row - tr * LIFE_TILE_SIZE);
+    while (length > 0) {
+        const int64_t tc = floor_div64(col);
+        const int c = (int)(col - tc * LIFE_TILE_SIZE);
+        const int n = length < LIFE_TILE_SIZE - c ? (int)length : LIFE_TILE_SIZE - c;
+        LifeTile* tile = tiled_find_or_add(board, tr, tc);
+        if (!tile) return -1;
+        TILE_ROWS(tile)[r] |= (n == LIFE_TILE_SIZE ? ~0ULL : (1ULL << n) - 1) << c;
+        col += n;
+        length -= n;
+    }
+    return 0;
+}
+
+// OR the live cells of a level <= 6 node into rows, bit c of rows[r] for cell (r, c)
+static void hashlife_node_rows(const HashNode* node, int r, int c, uint64_t* rows) {
+    if (node->population == 0) return;
+    if (node->level == 0) {
+        rows[r] |= 1ULL << c;
+        return;
+    }
+    const int half = 1 << (node->level - 1);
+    hashlife_node_rows(node->nw, r, c, rows);
+    hashlife_node_rows(node->ne, r, c + half, rows);
+    hashlife_node_rows(node->sw, r + half, c, rows);
+    hashlife_node_rows(node->se, r + half, c + half, rows);
+}
+
+/**
+ * Node of a level <= 6 block of rows with its top-left at (r, c)
+ *
+ * @return Shared node, or NULL on allocation failure
+ */
+static HashNode* hashlife_from_rows(HashLifeUniverse* u, const uint64_t* rows, int r, int c, int level) {
+    if (level == 0) return u->leaves[(rows[r] >> c) & 1];
+    const int size = 1 << level;
+    const uint64_t mask = (size == LIFE_WORD_BITS ? ~0ULL : (1ULL << size) - 1) << c;
+    bool empty = true;
+    for (int i = 0; i < size && empty; i++) empty = (rows[r + i] & mask) == 0;
+    if (empty) return hashlife_empty(u, level);
+
+    const int half = size / 2;
+    return hashlife_join(u,
+                         hashlife_from_rows(u, rows, r, c, level - 1),
+                         hashlife_from_rows(u, rows, r, c + half, level - 1),
+                         hashlife_from_rows(u, rows, r + half, c, level - 1),
+                         hashlife_from_rows(u, rows, r + half, c + half, level - 1));
+}
+
+// Node with the block at (r, c) replaced, relative to the node's top-left corner
+static HashNode* hashlife_set_block(HashLifeUniverse* u, HashNode* node, uint64_t r, uint64_t c,
+                                    HashNode* block) {
+    if (!node || !block) return NULL;
+    if (node->level == block->level) return block;
+    const uint64_t half = 1ULL << (node->level - 1);
+    HashNode* nw = node->nw;
+    HashNode* ne = node->ne;
+    HashNode* sw = node->sw;
+    HashNode* se = node->se;
+    if (r < half) {
+        if (c < half) nw = hashlife_set_block(u, nw, r, c, block);
+        else ne = hashlife_set_block(u, ne, r, c - half, block);
+    } else {
+        if (c < half) sw = hashlife_set_block(u, sw, r - half, c, block);
+        else se = hashlife_set_block(u, se, r - half, c - half, block);
+    }
+    return hashlife_join(u, nw, ne, sw, se);
+}
+
+/**
+ * Replace the universe contents and rule with those of a tiled board
+ *
+ * @return 0 on success, -1 on allocation failure or if a tile is out of range
+ */
+static int hashlife_load_tiles(HashLifeUniverse* u, const LifeTiledBoard* board) {
+    // Smallest centred root, at least one level above a tile, that holds every tile
+    int level = 7;
+    for (size_t i = 0; i < board->n_slots; i++) {
+        const LifeTile* tile = &board->tiles[i];
+        if (!tile->in_use) continue;
+        while (level <= HASHLIFE_MAX_LEVEL &&
+               (tile->tr < -((int64_t)1 << (level - 7)) || tile->tr >= ((int64_t)1 << (level - 7)) ||
+                tile->tc < -((int64_t)1 << (level - 7)) || tile->tc >= ((int64_t)1 << (level - 7)))) {
+            level++;
+        }
+    }
+    if (level > HASHLIFE_MAX_LEVEL) return -1;
+
+    HashNode* root = hashlife_empty(u, level);
+    const int64_t offset = (int64_t)1 << (level - 1);
+    for (size_t i = 0; i < board->n_slots && root; i++) {
+        const LifeTile* tile = &board->tiles[i];
+        if (!tile->in_use) continue;
+        u->root = root;  // Reachable if a collection runs mid-build
+        HashNode* block = hashlife_from_rows(u, TILE_ROWS(tile), 0, 0, 6);
+        if (block && block->population == 0) continue;
+        root = hashlife_set_block(u, root, (uint64_t)(tile->tr * LIFE_TILE_SIZE + offset),
+                                  (uint64_t)(tile->tc * LIFE_TILE_SIZE + offset), block);
+        if (root && (i & 255) == 255) {
+            u->root = root;
+            hashlife_maybe_collect(u);
+        }
+    }
+    if (!root) return -1;
+    u->root = root;
+    u->generation = board->generation;
+    hashlife_apply_rule(u, board->rule);
+    hashlife_maybe_collect(u);
+    return 0;
+}
+
+static int tiled_load_node(LifeTiledBoard* board, const HashNode* node, int64_t row, int64_t col) {
+    if (node->population == 0) return 0;
+    if (node->level == 6) {
+        LifeTile* tile = tiled_find_or_add(board, floor_div64(row), floor_div64(col));
+        if (!tile) return -1;
+        hashlife_node_rows(node, 0, 0, TILE_ROWS(tile));
+        return 0;
+    }
+    const int64_t half = (int64_t)1 << (node->level - 1);
+    if (tiled_load_node(board, node->nw, row, col) != 0) return -1;
+    if (tiled_load_node(board, node->ne, row, col + half) != 0) return -1;
+    if (tiled_load_node(board, node->sw, row + half, col) != 0) return -1;
+    return tiled_load_node(board, node->se, row + half, col + half);
+}
+
+/**
+ * Replace the board contents and rule with those of a universe
+ *
+ * The root is first padded so its level-6 blocks line up with tiles.
+ *
+ * @return 0 on success, -1 on allocation failure
+ */
+static int tiled_load_universe(LifeTiledBoard* board, HashLifeUniverse* u) {
+    tiled_clear(board);
+    while (u->root->level < 7) {
+        HashNode* root = hashlife_expand(u, u->root);
+        if (!root) return -1;
+        u->root = root;
+    }
+    const int64_t offset = (int64_t)1 << (u->root->level - 1);
+    if (tiled_load_node(board, u->root, -offset, -offset) != 0) return -1;
+    board->generation = u->generation;
+    board->rule = u->rule;
+    board->kernels = life_rule_kernels(u->rule);
+    return 0;
+}
+
+/**
+ * Parse a Macrocell ([M2]) pattern into the universe
+ *
+ * Lines are numbered from 1 and refer to earlier lines, 0 being the empty
+ * node of the child level; the last line is the root, centred on the
+ * origin. Level-3 nodes are 8 x 8 leaves of . * $ cells.
+ *
+ * The universe takes the #R rule, B3/S23 without one.
+ *
+ * @param generation_out Receives the #G generation, 0 without one
+ * @return 0 on success, -1 on a malformed or multistate file, an unsupported rule, or allocation failure
+ */
+static int hashlife_parse_macrocell(HashLifeUniverse* u, const char* p, const char* end,
+                                    uint64_t* generation_out) {
+    *generation_out = 0;
+    if (end - p < 4 || memcmp(p, "[M2]", 4) != 0) return -1;
+    p = line_end(p, end);
+
+    HashNode** nodes = NULL;  // nodes[i - 1] is line i
+    size_t n_nodes = 0, capacity = 0;
+    LifeRule rule = life_conway_rule();
+    int status = 0;
+    while (p < end && status == 0) {
+        p = skip_blanks(p + (*p == '\n'), end);
+        const char* eol = line_end(p, end);
+        HashNode* node = NULL;
+        if (p == eol) {
+            continue;
+        } else if (*p == '#') {
+            const char* q = p + 2;
+            if (eol - p >= 2 && p[1] == 'R' && parse_rule(q, eol, &rule) != 0) status = -1;
+            if (eol - p >= 2 && p[1] == 'G' && !parse_uint64(&q, eol, generation_out)) status = -1;
+            p = eol;
+            continue;
+        } else if (*p == '.' || *p == '*' || *p == '$') {
+            uint64_t rows[8] = {0};
+            int r = 0, c = 0;
+            for (; p < eol && status == 0; p++) {
+                if (*p == '.') {
+                    c++;
+                } else if (*p == '*') {
+                    if (r >= 8 || c >= 8) status = -1;
+                    else rows[r] |= 1ULL << c++;
+                } else if (*p == '$') {
+                    r++;
+                    c = 0;
+                } else if (*p != '\r') {
+                    status = -1;
+                }
+            }
+            if (status == 0) node = hashlife_from_rows(u, rows, 0, 0, 3);
+        } else {
+            // Level-1 lines only appear in multistate files
+            uint64_t level, child[4];
+            bool ok = parse_uint64(&p, eol, &level) && level > 3 && level <= HASHLIFE_MAX_LEVEL;
+            for (int i = 0; i < 4 && ok; i++) ok = parse_uint64(&p, eol, &child[i]) && child[i] <= n_nodes;
+            if (!ok || skip_blanks(p, eol) != eol) {
+                status = -1;
+                break;
+            }
+            HashNode* quads[4];
+            for (int i = 0; i < 4; i++) {
+                quads[i] = child[i] ? nodes[child[i] - 1] : hashlife_empty(u, (int)level - 1);
+                if (quads[i] && quads[i]->level != level - 1) ok = false;
+            }
+            if (!ok) {
+                status = -1;
+                break;
+            }
+            node = hashlife_join(u, quads[0], quads[1], quads[2], quads[3]);
+            p = eol;
+        }
+        if (status != 0) break;
+
+        if (n_nodes == capacity) {
+            capacity = capacity ? capacity * 2 : 1024;
+            HashNode** grown = (HashNode**)realloc(nodes, capacity * sizeof(HashNode*));
+            if (!grown) {
+                status = -1;
+                break;
+            }
+            nodes = grown;
+        }
+        if (!node) status = -1;
+        else nodes[n_nodes++] = node;
+    }
+
+    if (status == 0 && n_nodes == 0) status = -1;
+    if (status == 0) {
+        u->root = nodes[n_nodes - 1];
+        u->generation = *generation_out;
+        hashlife_apply_rule(u, rule);
+    }
+    free(nodes);
+    hashlife_maybe_collect(u);
+    return status;
+}
+
+// Pointer to post-order index map for writing each distinct node once
+typedef struct {
+    const HashNode** keys;
+    uint32_t* values;
+    size_t size;              // Power of two, at least twice the node count
+    uint32_t count;
+} NodeIndex;
+
+// Writes one node record given the indices of its children (unused at level 3)
+typedef int (*NodeRecordWriter)(void* target, const HashNode* node, const uint32_t* children);
+
+static int node_index_init(NodeIndex* index, size_t n_nodes) {
+    index->size = 64;
+    while (index->size < 2 * n_nodes) index->size *= 2;
+    index->keys = (const HashNode**)calloc(index->size, sizeof(HashNode*));
+    index->values = (uint32_t*)malloc(index->size * sizeof(uint32_t));
+    index->count = 0;
+    return index->keys && index->values ? 0 : -1;
+}
+
+static void node_index_free(NodeIndex* index) {
+    free(index->keys);
+    free(index->values);
+}
+
+static inline size_t node_index_slot(const NodeIndex* index, const HashNode* node) {
+    size_t slot = ((uint64_t)(uintptr_t)node * 0x9E3779B97F4A7C15ULL >> 17) & (index->size - 1);
+    while (index->keys[slot] && index->keys[slot] != node) slot = (slot + 1) & (index->size - 1);
+    return slot;
+}
+
+/**
+ * Number the non-empty nodes at level >= 3 in post-order, writing each once
+ *
+ * @return Index of the node from 1, 0 if it is empty, UINT32_MAX on error
+ */
+static uint32_t node_index_write(NodeIndex* index, const HashNode* node, NodeRecordWriter write, void* target) {
+    if (node->population == 0) return 0;
+    size_t slot = node_index_slot(index, node);
+    if (index->keys[slot]) return index->values[slot];
+
+    uint32_t children[4] = {0, 0, 0, 0};
+    if (node->level > 3) {
+        const HashNode* quads[4] = {node->nw, node->ne, node->sw, node->se};
+        for (int i = 0; i < 4; i++) {
+            children[i] = node_index_write(index, quads[i], write, target);
+            if (children[i] == UINT32_MAX) return UINT32_MAX;
+        }
+        slot = node_index_slot(index, node);  // Children may have claimed the slot
+    }
+    if (index->count == UINT32_MAX - 1 || write(target, node, children) != 0) return UINT32_MAX;
+    index->keys[slot] = node;
+    index->values[slot] = ++index->count;
+    return index->count;
+}
+
+// Root of at least level 3, so every node written is a leaf or has leaf descendants
+static int hashlife_pad_root(HashLifeUniverse* u) {
+    while (u->root->level < 3) {
+        HashNode* root = hashlife_expand(u, u->root);
+        if (!root) return -1;
+        u->root = root;
+    }
+    return 0;
+}
+
+static int macrocell_write_node(void* target, const HashNode* node, const uint32_t* children) {
+    FILE* file = (FILE*)target;
+    if (node->level > 3) {
+        return fprintf(file, "%d %u %u %u %u\n", node->level,
+                       children[0], children[1], children[2], children[3]) < 0 ? -1 : 0;
+    }
+    // Leaf rows end with $; trailing dead cells and rows are dropped
+    uint64_t rows[8] = {0};
+    hashlife_node_rows(node, 0, 0, rows);
+    int last = 7;
+    while (last > 0 && rows[last] == 0) last--;
+    for (int r = 0; r <= last; r++) {
+        for (uint64_t bits = rows[r]; bits; bits >>= 1) fputc(bits & 1 ? '*' : '.', file);
+        fputc('$', file);
+    }
+    return fputc('\n', file) == EOF ? -1 : 0;
+}
+
+static int hashlife_write_macrocell_file(HashLifeUniverse* u, const char* path, uint64_t generation) {
+    if (hashlife_pad_root(u) != 0) return -1;
+    NodeIndex index;
+    if (node_index_init(&index, u->n_nodes) != 0) {
+        node_index_free(&index);
+        return -1;
+    }
+    FILE* file = open_output(path);
+    if (!file) {
+        node_index_free(&index);
+        return -1;
+    }
+    char rule[24];
+    format_rule(u->rule, rule);
+    fprintf(file, "[M2] (life_lib)\n#R %s\n#G %llu\n", rule, (unsigned long long)generation);
+    int status = 0;
+    if (u->root->population == 0) {
+        fputs("$\n", file);  // Empty level-3 root
+    } else if (node_index_write(&index, u->root, macrocell_write_node, file) == UINT32_MAX) {
+        status = -1;
+    }
+    node_index_free(&index);
+    return close_output(file, status);
+}
+
+static int checkpoint_write_node(void* target, const HashNode* node, const uint32_t* children) {
+    FILE* file = (FILE*)target;
+    const uint8_t level = node->level;
+    if (fwrite(&level, 1, 1, file) != 1) return -1;
+    if (level > 3) return fwrite(children, sizeof(uint32_t), 4, file) == 4 ? 0 : -1;
+    // Leaf: bit 8 r + c for cell (r, c)
+    uint64_t rows[8] = {0}, bits = 0;
+    hashlife_node_rows(node, 0, 0, rows);
+    for (int r = 0; r < 8; r++) bits |= rows[r] << (8 * r);
+    return fwrite(&bits, sizeof(bits), 1, file) == 1 ? 0 : -1;
+}
+
+static int write_checkpoint_header(FILE* file, uint32_t engine, LifeRule rule,
+                                   uint64_t generation, uint64_t count) {
+    CheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, life_checkpoint_magic, sizeof(header.magic));
+    header.engine = engine;
+    header.rule = rule.birth | (uint32_t)rule.survive << 16;
+    header.generation = generation;
+    header.count = count;
+    return fwrite(&header, sizeof(header), 1, file) == 1 ? 0 : -1;
+}
+
+// Read and check a checkpoint header; the records start at *records_out
+static int read_checkpoint_header(const MappedFile* mf, CheckpointHeader* header, LifeRule* rule_out,
+                                  const char** records_out) {
+    if (mf->size < sizeof(CheckpointHeader)) return -1;
+    memcpy(header, mf->data, sizeof(CheckpointHeader));
+    if (memcmp(header->magic, life_checkpoint_magic, sizeof(header->magic)) != 0) return -1;
+    rule_out->birth = (uint16_t)(header->rule & 0xffff);
+    rule_out->survive = (uint16_t)(header->rule >> 16);
+    if (!life_rule_valid(*rule_out)) return -1;
+    *records_out = mf->data + sizeof(CheckpointHeader);
+    return 0;
+}
+
+/**
+ * Rebuild a universe from checkpoint node records
+ *
+ * @return 0 on success, -1 on a truncated or inconsistent file, or allocation failure
+ */
+static int hashlife_read_checkpoint_nodes(HashLifeUniverse* u, const char* p, const char* end, uint64_t count) {
+    if (count > (uint64_t)(end - p) / 9) return -1;  // Shortest record is a level byte and a leaf
+    HashNode** nodes = (HashNode**)malloc((size_t)(count ? count : 1) * sizeof(HashNode*));
+    if (!nodes) return -1;
+    int status = 0;
+    for (uint64_t i = 0; i < count && status == 0; i++) {
+        const int level = (uint8_t)*p++;
+        HashNode* node = NULL;
+        if (level == 3 && end - p >= 8) {
+            uint64_t bits, rows[8];
+            memcpy(&bits, p, sizeof(bits));
+            p += sizeof(bits);
+            for (int r = 0; r < 8; r++) rows[r] = (bits >> (8 * r)) & 0xff;
+            node = hashlife_from_rows(u, rows, 0, 0, 3);
+        } else if (level > 3 && level <= HASHLIFE_MAX_LEVEL && end - p >= 16) {
+            uint32_t child[4];
+            memcpy(child, p, sizeof(child));
+            p += sizeof(child);
+            HashNode* quads[4];
+            for (int q = 0; q < 4 && status == 0; q++) {
+                if (child[q] > i) status = -1;
+                else quads[q] = child[q] ? nodes[child[q] - 1] : hashlife_empty(u, level - 1);
+                if (status == 0 && quads[q] && quads[q]->level != level - 1) status = -1;
+            }
+            if (status == 0) node = hashlife_join(u, quads[0], quads[1], quads[2], quads[3]);
+        }
+        if (!node) status = -1;
+        else nodes[i] = node;
+    }
+    if (status == 0 && p != end) status = -1;
+    if (status == 0) {
+        u->root = count ? nodes[count - 1] : hashlife_empty(u, 3);
+        if (!u->root) status = -1;
+    }
+    free(nodes);
+    if (status == 0) hashlife_pad_root(u);
+    hashlife_maybe_collect(u);
+    return status;
+}
+
+/**
+ * Replace the board contents with checkpoint tile records
+ *
+ * @return 0 on success, -1 on a truncated file or allocation failure
+ */
+static int tiled_read_checkpoint_tiles(LifeTiledBoard* board, const char* p, const char* end, uint64_t count) {
+    tiled_clear(board);
+    if (count > (uint64_t)(end - p) / sizeof(CheckpointTile) ||
+        (uint64_t)(end - p) != count * sizeof(CheckpointTile)) {
+        return -1;
+    }
+    for (uint64_t i = 0; i < count; i++, p += sizeof(CheckpointTile)) {
+        CheckpointTile record;
+        memcpy(&record, p, sizeof(record));
+        LifeTile* tile = tiled_find_or_add(board, record.tr, record.tc);
+        if (!tile) return -1;
+        for (int r = 0; r < LIFE_TILE_SIZE; r++) TILE_ROWS(tile)[r] |= record.rows[r];
+    }
+    return 0;
+}
+
+static inline bool is_macrocell(const MappedFile* mf) {
+    return mf->size >= 4 && memcmp(mf->data, "[M2]", 4) == 0;
+}
+
+typedef struct {
+    int64_t tr;
+    int64_t tc;
+    const uint64_t* rows;
+} TileRef;
+
+static int tile_ref_compare(const void* a, const void* b) {
+    const TileRef* x = (const TileRef*)a;
+    const TileRef* y = (const TileRef*)b;
+    if (x->tr != y->tr) return x->tr < y->tr ? -1 : 1;
+    if (x->tc != y->tc) return x->tc < y->tc ? -1 : 1;
+    return 0;
+}
+
+typedef struct {
+    FILE* file;
+    int64_t col0;             // Left edge of the bounding box
+    int64_t row, col;         // Cell after the last token written
+    int64_t run_row, run_col, run_length;  // Pending live run, merged with adjacent ones
+    int line_length;
+} RleWriter;
+
+static void rle_token(RleWriter* w, int64_t count, char tag) {
+    char token[32];
+    const int n = count > 1 ? snprintf(token, sizeof(token), "%lld%c", (long long)count, tag)
+                            : snprintf(token, sizeof(token), "%c", tag);
+    if (w->line_length + n > LIFE_RLE_LINE) {
+        fputc('\n', w->file);
+        w->line_length = 0;
+    }
+    fputs(token, w->file);
+    w->line_length += n;
+}
+
+static void rle_flush_run(RleWriter* w) {
+    if (w->run_length == 0) return;
+    if (w->run_row > w->row) {
+        rle_token(w, w->run_row - w->row, '$');
+        w->row = w->run_row;
+        w->col = w->col0;
+    }
+    if (w->run_col > w->col) rle_token(w, w->run_col - w->col, 'b');
+    rle_token(w, w->run_length, 'o');
+    w->col = w->run_col + w->run_length;
+    w->run_length = 0;
+}
+
+// Runs must arrive in row-major order
+static void rle_add_run(RleWriter* w, int64_t row, int64_t col, int64_t length) {
+    if (w->run_length > 0 && row == w->run_row && col == w->run_col + w->run_length) {
+        w->run_length += length;
+        return;
+    }
+    rle_flush_run(w);
+    w->run_row = row;
+    w->run_col = col;
+    w->run_length = length;
+}
+
+/**
+ * Write the board as extended RLE, one band of tiles at a time
+ *
+ * @return 0 on success, -1 on allocation or write failure
+ */
+static int tiled_write_rle_file(const LifeTiledBoard* board, const char* path, uint64_t generation) {
+    TileRef* refs = (TileRef*)malloc((board->n_slots ? board->n_slots : 1) * sizeof(TileRef));
+    if (!refs) return -1;
+
+    // Non-empty tiles and the bounding box of their cells
+    size_t n_refs = 0;
+    int64_t min_r = INT64_MAX, max_r = INT64_MIN, min_c = INT64_MAX, max_c = INT64_MIN;
+    for (size_t i = 0; i < board->n_slots; i++) {
+        const LifeTile* tile = &board->tiles[i];
+        if (!tile->in_use) continue;
+        const uint64_t* rows = TILE_ROWS(tile);
+        uint64_t columns = 0;
+        int first = -1, last = -1;
+        for (int r = 0; r < LIFE_TILE_SIZE; r++) {
+            if (!rows[r]) continue;
+            columns |= rows[r];
+            if (first < 0) first = r;
+            last = r;
+        }
+        if (!columns) continue;
+        const int64_t base_r = tile->tr * LIFE_TILE_SIZE, base_c = tile->tc * LIFE_TILE_SIZE;
+        if (base_r + first < min_r) min_r = base_r + first;
+        if (base_r + last > max_r) max_r = base_r + last;
+        if (base_c + __builtin_ctzll(columns) < min_c) min_c = base_c + __builtin_ctzll(columns);
+        if (base_c + 63 - __builtin_clzll(columns) > max_c) max_c = base_c + 63 - __builtin_clzll(columns);
+        refs[n_refs].tr = tile->tr;
+        refs[n_refs].tc = tile->tc;
+        refs[n_refs].rows = rows;
+        n_refs++;
+    }
+    qsort(refs, n_refs, sizeof(TileRef), tile_ref_compare);
+    if (n_refs == 0) min_r = max_r = min_c = max_c = 0;
+
+    FILE* file = open_output(path);
+    if (!file) {
+        free(refs);
+        return -1;
+    }
+    char rule[24];
+    format_rule(board->rule, rule);
+    fprintf(file, "#CXRLE Pos=%lld,%lld Gen=%llu\nx = %lld, y = %lld, rule = %s\n",
+            (long long)min_c, (long long)min_r, (unsigned long long)generation,
+            (long long)(n_refs ? max_c - min_c + 1 : 0), (long long)(n_refs ? max_r - min_r + 1 : 0), rule);
+
+    RleWriter w = {file, min_c, min_r, min_c, 0, 0, 0, 0};
+    for (size_t band = 0; band < n_refs;) {
+        size_t band_end = band;
+        while (band_end < n_refs && refs[band_end].tr == refs[band].tr) band_end++;
+        for (int r = 0; r < LIFE_TILE_SIZE; r++) {
+            const int64_t row = refs[band].tr * LIFE_TILE_SIZE + r;
+            for (size_t t = band; t < band_end; t++) {
+                uint64_t bits = refs[t].rows[r];
+                while (bits) {
+                    const int b = __builtin_ctzll(bits);
+                    const uint64_t rest = ~(bits >> b);
+                    const int length = rest ? __builtin_ctzll(rest) : LIFE_WORD_BITS;
+                    rle_add_run(&w, row, refs[t].tc * LIFE_TILE_SIZE + b, length);
+                    bits = b + length >= LIFE_WORD_BITS ? 0 : bits & (~0ULL << (b + length));
+                }
+            }
+        }
+        band = band_end;
+    }
+    rle_flush_run(&w);
+    fputs("!\n", file);
+    free(refs);
+    return close_output(file, 0);
+}
+
+static int tiled_save_checkpoint_file(const LifeTiledBoard* board, const char* path, uint64_t generation) {
+    FILE* file = open_output(path);
+    if (!file) return -1;
+    uint64_t count = 0;
+    int status = write_checkpoint_header(file, LIFE_CHECKPOINT_TILES, board->rule, generation, 0);
+    for (size_t i = 0; i < board->n_slots && status == 0; i++) {
+        const LifeTile* tile = &board->tiles[i];
+        if (!tile->in_use || memcmp(TILE_ROWS(tile), life_zero_tile, sizeof(life_zero_tile)) == 0) continue;
+        CheckpointTile record;
+        record.tr = tile->tr;
+        record.tc = tile->tc;
+        memcpy(record.rows, TILE_ROWS(tile), sizeof(record.rows));
+        if (fwrite(&record, sizeof(record), 1, file) != 1) status = -1;
+        count++;
+    }
+    // The record count is known once the tiles are written
+    if (status == 0 && (fseek(file, 0, SEEK_SET) != 0 ||
+                        write_checkpoint_header(file, LIFE_CHECKPOINT_TILES, board->rule, generation, count) != 0)) {
+        status = -1;
+    }
+    return close_output(file, status);
+}
+
+static int hashlife_save_checkpoint_file(HashLifeUniverse* u, const char* path, uint64_t generation) {
+    if (hashlife_pad_root(u) != 0) return -1;
+    NodeIndex index;
+    if (node_index_init(&index, u->n_nodes) != 0) {
+        node_index_free(&index);
+        return -1;
+    }
+    FILE* file = open_output(path);
+    if (!file) {
+        node_index_free(&index);
+        return -1;
+    }
+    int status = write_checkpoint_header(file, LIFE_CHECKPOINT_NODES, u->rule, generation, 0);
+    if (status == 0 && node_index_write(&index, u->root, checkpoint_write_node, file) == UINT32_MAX) status = -1;
+    if (status == 0 && (fseek(file, 0, SEEK_SET) != 0 ||
+                        write_checkpoint_header(file, LIFE_CHECKPOINT_NODES, u->rule, generation,
+                                                index.count) != 0)) {
+        status = -1;
+    }
+    node_index_free(&index);
+    return close_output(file, status);
+}
+
+/**
+ * Replace the board contents with an RLE or Macrocell file
+ *
+ * The file is memory-mapped and RLE runs are set straight into tiles;
+ * Macrocell files are read into a scratch quadtree first. Every tile
+ * starts out unstable. The board takes the file's rule, B3/S23 if it
+ * names none. On error the board is left empty.
+ *
+ * @param path File path, Macrocell if it starts with [M2]
+ * @param generation_out Receives the generation recorded in the file, 0 if none (may be NULL)
+ * @return 0 on success, -1 on I/O error, a malformed file, an unsupported rule, or allocation failure
+ */
+EXPORT int life_tiled_read_pattern(LifeTiledBoard* board, const char* path, uint64_t* generation_out) {
+    if (!board || !path) return -1;
+    tiled_clear(board);
+    MappedFile mf;
+    if (map_file(path, &mf) != 0) return -1;
+
+    uint64_t generation = 0;
+    int status;
+    if (is_macrocell(&mf)) {
+        HashLifeUniverse* u = hashlife_create(0);
+        status = u ? hashlife_parse_macrocell(u, mf.data, mf.data + mf.size, &generation) : -1;
+        if (status == 0) status = tiled_load_universe(board, u);
+        hashlife_destroy(u);
+    } else {
+        LifeRule rule;
+        status = parse_rle(mf.data, mf.data + mf.size, tiled_add_run, board, &generation, &rule);
+        if (status == 0) status = tiled_apply_rule(board, rule);
+    }
+    unmap_file(&mf);
+
+    if (status != 0) {
+        tiled_clear(board);
+        return -1;
+    }
+    board->generation = generation;
+    if (generation_out) *generation_out = generation;
+    return 0;
+}
+
+/**
+ * Write the board as extended RLE
+ *
+ * A #CXRLE line records the top-left cell and the generation, so reading
+ * the file back restores the pattern in place.
+ *
+ * @param generation Generation recorded in the file
+ * @return 0 on success, -1 on I/O or allocation failure
+ */
+EXPORT int life_tiled_write_rle(const LifeTiledBoard* board, const char* path, uint64_t generation) {
+    if (!board || !path) return -1;
+    return tiled_write_rle_file(board, path, generation);
+}
+
+/**
+ * Write the board as a Macrocell file, through a scratch quadtree
+ *
+ * @param generation Generation recorded in the file
+ * @return 0 on success, -1 on I/O or allocation failure
+ */
+EXPORT int life_tiled_write_macrocell(const LifeTiledBoard* board, const char* path, uint64_t generation) {
+    if (!board || !path) return -1;
+    HashLifeUniverse* u = hashlife_create(0);
+    int status = u ? hashlife_load_tiles(u, board) : -1;
+    if (status == 0) status = hashlife_write_macrocell_file(u, path, generation);
+    hashlife_destroy(u);
+    return status;
+}
+
+/**
+ * Save the board as a binary checkpoint of its non-empty tiles
+ *
+ * @param generation Generation recorded in the checkpoint
+ * @return 0 on success, -1 on I/O failure
+ */
+EXPORT int life_tiled_save_checkpoint(const LifeTiledBoard* board, const char* path, uint64_t generation) {
+    if (!board || !path) return -1;
+    return tiled_save_checkpoint_file(board, path, generation);
+}
+
+/**
+ * Replace the board contents with a checkpoint from either engine
+ *
+ * Every tile starts out unstable, and the board takes the saved rule.
+ * On error the board is left empty.
+ *
+ * @param generation_out Receives the saved generation (may be NULL)
+ * @return 0 on success, -1 on I/O error, a corrupt checkpoint, or allocation failure
+ */
+EXPORT int life_tiled_load_checkpoint(LifeTiledBoard* board, const char* path, uint64_t* generation_out) {
+    if (!board || !path) return -1;
+    tiled_clear(board);
+    MappedFile mf;
+    if (map_file(path, &mf) != 0) return -1;
+
+    CheckpointHeader header;
+    LifeRule rule;
+    const char* records;
+    int status = read_checkpoint_header(&mf, &header, &rule, &records);
+    if (status == 0 && header.engine == LIFE_CHECKPOINT_TILES) {
+        status = tiled_read_checkpoint_tiles(board, records, mf.data + mf.size, header.count);
+        if (status == 0) status = tiled_apply_rule(board, rule);
+    } else if (status == 0 && header.engine == LIFE_CHECKPOINT_NODES) {
+        HashLifeUniverse* u = hashlife_create(0);
+        status = u ? hashlife_read_checkpoint_nodes(u, records, mf.data + mf.size, header.count) : -1;
+        if (status == 0) status = hashlife_apply_rule(u, rule);
+        if (status == 0) status = tiled_load_universe(board, u);
+        hashlife_destroy(u);
+    } else {
+        status = -1;
+    }
+    unmap_file(&mf);
+
+    if (status != 0) {
+        tiled_clear(board);
+        return -1;
+    }
+    board->generation = header.generation;
+    if (generation_out) *generation_out = header.generation;
+    return 0;
+}
+
+/**
+ * Replace the universe contents with an RLE or Macrocell file
+ *
+ * The file is memory-mapped; Macrocell lines become nodes directly, RLE
+ * runs are gathered into a scratch tiled board and joined tile by tile.
+ * The universe takes the file's rule, B3/S23 if it names none. On error
+ * the universe is left empty.
+ *
+ * @param path File path, Macrocell if it starts with [M2]
+ * @param generation_out Receives the generation recorded in the file, 0 if none (may be NULL)
+ * @return 0 on success, -1 on I/O error, a malformed file, an unsupported rule, or allocation failure
+ */
+EXPORT int hashlife_read_pattern(HashLifeUniverse* u, const char* path, uint64_t* generation_out) {
+    if (!u || !path) return -1;
+    MappedFile mf;
+    if (map_file(path, &mf) != 0) return -1;
+
+    uint64_t generation = 0;
+    int status;
+    if (is_macrocell(&mf)) {
+        status = hashlife_parse_macrocell(u, mf.data, mf.data + mf.size, &generation);
+    } else {
+        LifeTiledBoard* board = life_tiled_create();
+        LifeRule rule;
+        status = board ? parse_rle(mf.data, mf.data + mf.size, tiled_add_run, board, &generation, &rule) : -1;
+        if (status == 0) status = tiled_apply_rule(board, rule);
+        if (status == 0) status = hashlife_load_tiles(u, board);
+        life_tiled_destroy(board);
+    }
+    unmap_file(&mf);
+
+    if (status != 0) {
+        u->root = hashlife_empty(u, 3);
+        u->generation = 0;
+        return -1;
+    }
+    u->generation = generation;
+    if (generation_out) *generation_out = generation;
+    return 0;
+}
+
+/**
+ * Write the universe as extended RLE, through a scratch tiled board
+ *
+ * @param generation Generation recorded in the file
+ * @return 0 on success, -1 on I/O or allocation failure
+ */
+EXPORT int hashlife_write_rle(HashLifeUniverse* u, const char* path, uint64_t generation) {
+    if (!u || !path) return -1;
+    LifeTiledBoard* board = life_tiled_create();
+    int status = board ? tiled_load_universe(board, u) : -1;
+    if (status == 0) status = tiled_write_rle_file(board, path, generation);
+    life_tiled_destroy(board);
+    return status;
+}
+
+/**
+ * Write the universe as a Macrocell file, each distinct node once
+ *
+ * @param generation Generation recorded in the file
+ * @return 0 on success, -1 on I/O or allocation failure
+ */
+EXPORT int hashlife_write_macrocell(HashLifeUniverse* u, const char* path, uint64_t generation) {
+    if (!u || !path) return -1;
+    return hashlife_write_macrocell_file(u, path, generation);
+}
+
+/**
+ * Save the universe as a binary checkpoint of its distinct nodes
+ *
+ * @param generation Generation recorded in the checkpoint
+ * @return 0 on success, -1 on I/O or allocation failure
+ */
+EXPORT int hashlife_save_checkpoint(HashLifeUniverse* u, const char* path, uint64_t generation) {
+    if (!u || !path) return -1;
+    return hashlife_save_checkpoint_file(u, path, generation);
+}
+
+/**
+ * Replace the universe contents with a checkpoint from either engine
+ *
+ * The universe takes the saved rule. On error it is left empty.
+ *
+ * @param generation_out Receives the saved generation (may be NULL)
+ * @return 0 on success, -1 on I/O error, a corrupt checkpoint, or allocation failure
+ */
+EXPORT int hashlife_load_checkpoint(HashLifeUniverse* u, const char* path, uint64_t* generation_out) {
+    if (!u || !path) return -1;
+    MappedFile mf;
+    if (map_file(path, &mf) != 0) return -1;
+
+    CheckpointHeader header;
+    LifeRule rule;
+    const char* records;
+    int status = read_checkpoint_header(&mf, &header, &rule, &records);
+    if (status == 0 && header.engine == LIFE_CHECKPOINT_NODES) {
+        status = hashlife_read_checkpoint_nodes(u, records, mf.data + mf.size, header.count);
+        if (status == 0) status = hashlife_apply_rule(u, rule);
+    } else if (status == 0 && header.engine == LIFE_CHECKPOINT_TILES) {
+        LifeTiledBoard* board = life_tiled_create();
+        status = board ? tiled_read_checkpoint_tiles(board, records, mf.data + mf.size, header.count) : -1;
+        if (status == 0) status = tiled_apply_rule(board, rule);
+        if (status == 0) status = hashlife_load_tiles(u, board);
+        life_tiled_destroy(board);
+    } else {
+        status = -1;
+    }
+    unmap_file(&mf);
+
+    if (status != 0) {
+        u->root = hashlife_empty(u, 3);
+        u->generation = 0;
+        return -1;
+    }
+    u->generation = header.generation;
+    if (generation_out) *generation_out = header.generation;
+    return 0;
+}
@@ -0,0 +1,98 @@
+"""Locate and build the ctypes C libraries shared by the hybrid modules"""
+
+import os
+import subprocess
+import sys
+import tempfile
+from typing import List
+
+# ISA builds made by `python setup.py build_ext`, best first:
+# (name, CPU flags needed to run it, compiler flags to build it)
+ISA_VARIANTS = [
+    ("avx512", ("avx512f", "avx512dq", "avx512bw", "avx512vl"),
+     ["-mavx2", "-mfma", "-mbmi2", "-mavx512f", "-mavx512dq", "-mavx512bw", "-mavx512vl"]),
+    ("avx2", ("avx2", "fma", "bmi2"), ["-mavx2", "-mfma", "-mbmi2"]),
+]
+
+LIB_EXT = ".dll" if sys.platform == "win32" else ".so"
+
+
+def cpu_flags() -> frozenset:
+    """CPU feature flags from /proc/cpuinfo, empty where that is unavailable"""
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                if line.startswith("flags"):
+                    return frozenset(line.split(":", 1)[1].split())
+    except OSError:
+        pass
+    return frozenset()
+
+
+def _is_current(lib_path: str, source: str) -> bool:
+    """Whether lib_path exists and is not older than its source"""
+    try:
+        return os.path.getmtime(lib_path) >= os.path.getmtime(source)
+    except OSError:
+        # A missing source (e.g. an installed package) cannot make a build stale
+        return os.path.exists(lib_path)
+
+
+def _compile_command(source: str, output: str) -> List[str]:
+    cmd = ["gcc", "-O3", "-shared", "-o", output, source, "-lm"]
+    if sys.platform != "win32":
+        cmd[2:2] = ["-fPIC", "-pthread"]
+    return cmd
+
+
+def build_native_lib(source: str, lib_path: str) -> bool:
+    """
+    Compile the baseline library with gcc, for checkouts without `setup.py build_ext`.
+
+    The build goes to a unique temporary file next to lib_path and is moved
+    into place only once it succeeded, so concurrent imports never load or
+    clobber a half-written library.
+
+    Returns:
+        True if lib_path was (re)built
+    """
+    fd, tmp_path = tempfile.mkstemp(prefix=os.path.basename(lib_path) + ".", suffix=".tmp",
+                                    dir=os.path.dirname(lib_path))
+    os.close(fd)
+    try:
+        # Without OpenMP the parallel loops still run, serially
+        for openmp in (["-fopenmp"], []):
+            try:
+                if subprocess.run(_compile_command(source, tmp_path) + openmp, capture_output=True).returncode == 0:
+                    os.replace(tmp_path, lib_path)
+                    return True
+            except OSError:
+                return False
+        return False
+    finally:
+        if os.path.exists(tmp_path):
+            os.unlink(tmp_path)
+
+
+def native_lib_path(script_dir: str, name: str) -> str:
+    """
+    Path of the best usable build of script_dir/name.c for this CPU.
+
+    NATIVE_ISA=baseline|avx2|avx512 restricts the choice, e.g. for benchmarking;
+    a variant the CPU cannot run is never chosen. Variants older than the
+    source are skipped, since they may lack functions the bindings expect.
+    The baseline is rebuilt when it is missing or stale; if that fails, a
+    stale baseline is still returned.
+    """
+    source = os.path.join(script_dir, name + ".c")
+    forced = os.environ.get("NATIVE_ISA")
+    flags = cpu_flags()
+    for isa, required, _ in ISA_VARIANTS:
+        path = os.path.join(script_dir, f"{name}_{isa}{LIB_EXT}")
+        if forced in (None, isa) and flags.issuperset(required) and _is_current(path, source):
+            return path
+
+    lib_path = os.path.join(script_dir, name + LIB_EXT)
+    if not _is_current(lib_path, source):
+        build_native_lib(source, lib_path)
+    return lib_path
@@ -11,7 +11,7 @@ import numpy as np
 import matplotlib
 matplotlib.use('TkAgg')  # Use TkAgg backend for interactive plots
 import matplotlib.pyplot as plt
-from linear_array_hybrid import ArrayParameters, calculate_pattern
+from linear_array_hybrid import ArrayParameters, calculate_multibeam_pattern
 
 def plot_steering_comparison(angles, theta, patterns, patterns_db, snr_db=None, phase_error_std=None):
     """Create comparison plot in polar coordinates for different steering angles."""
@@ -73,22 +73,19 @@ def main():
         theta = np.linspace(-180, 180, 721)  # 0.5 degree resolution
         steering_angles = [-60, -30, 0, 30, 60]  # Different steering angles to demonstrate
         
-        # Calculate patterns for all steering angles
-        patterns = []
+        # Calculate patterns for all steering angles in one batched call
+        params = ArrayParameters(
+            n_elements=n_elements,
+            spacing_wavelength=0.5,
+            phase_error_std=args.phase_error if args.phase_error is not None else 0.0
+        )
+        patterns = calculate_multibeam_pattern(params, theta, steering_angles, snr_db=args.snr)
         patterns_db = []
-        for angle in steering_angles:
-            params = ArrayParameters(
-                n_elements=n_elements,
-                spacing_wavelength=0.5,
-                steering_angle=angle,
-                phase_error_std=args.phase_error if args.phase_error is not None else 0.0
-            )
-            pattern = calculate_pattern(params, theta, snr_db=args.snr)
+        for pattern in patterns:
             pattern_abs = np.abs(pattern)
             max_val = np.max(pattern_abs)
             # Add small offset to prevent log of zero, and limit dynamic range to -60 dB
             pattern_db = 20 * np.log10(np.maximum(pattern_abs, max_val * 1e-6) / max_val)
-            patterns.append(pattern)
             patterns_db.append(pattern_db)
         
         # Create and display the plot
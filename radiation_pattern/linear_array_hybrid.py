@@ -16,19 +16,61 @@ from typing import Tuple, Optional
 from dataclasses import dataclass
 import time
 
+try:
+    import native_build
+except ImportError:
+    # Running from a checkout: the build helper sits at the repository root
+    sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+    import native_build
+
+class PatternMonteCarloStats(ctypes.Structure):
+    """Mirror of the C structure for Monte Carlo summaries"""
+    _fields_ = [
+        ("trials", ctypes.c_uint64),
+        ("psll_mean_db", ctypes.c_double),
+        ("psll_std_db", ctypes.c_double),
+        ("psll_worst_db", ctypes.c_double),
+        ("pointing_error_mean_deg", ctypes.c_double),
+        ("pointing_error_rms_deg", ctypes.c_double),
+        ("pointing_error_max_deg", ctypes.c_double)
+    ]
+
+class PatternMetrics(ctypes.Structure):
+    """Mirror of the C structure for adaptively refined pattern metrics"""
+    _fields_ = [
+        ("peak_angle_deg", ctypes.c_double),
+        ("peak_power", ctypes.c_double),
+        ("beamwidth_3db_deg", ctypes.c_double),
+        ("half_power_left_deg", ctypes.c_double),
+        ("half_power_right_deg", ctypes.c_double),
+        ("psll_db", ctypes.c_double),
+        ("psll_angle_deg", ctypes.c_double),
+        ("n_nulls", ctypes.c_int),
+        ("n_maxima", ctypes.c_int),
+        ("evaluations", ctypes.c_uint64)
+    ]
+
+class PatternStats(ctypes.Structure):
+    """Mirror of the C structure for the hot-path counters"""
+    _fields_ = [
+        ("calls", ctypes.c_uint64),
+        ("evaluations", ctypes.c_uint64),
+        ("rng_draws", ctypes.c_uint64),
+        ("allocations", ctypes.c_uint64),
+        ("allocated_bytes", ctypes.c_uint64),
+        ("setup_cycles", ctypes.c_uint64),
+        ("kernel_cycles", ctypes.c_uint64),
+        ("noise_cycles", ctypes.c_uint64),
+        ("threads", ctypes.c_uint32),
+        ("ns_per_cycle", ctypes.c_double)
+    ]
+
 # Load the C library
 def load_radiation_pattern_lib() -> ctypes.CDLL:
     """Load the compiled C library"""
     script_dir = os.path.dirname(os.path.abspath(__file__))
     
-    if sys.platform == 'win32':
-        lib_path = os.path.join(script_dir, 'radiation_pattern_lib.dll')
-        if not os.path.exists(lib_path):
-            os.system(f'gcc -O3 -shared -o "{lib_path}" "{os.path.join(script_dir, "radiation_pattern_lib.c")}" -lm')
-    else:
-        lib_path = os.path.join(script_dir, 'radiation_pattern_lib.so')
-        if not os.path.exists(lib_path):
-            os.system(f'gcc -O3 -fPIC -shared -o "{lib_path}" "{os.path.join(script_dir, "radiation_pattern_lib.c")}" -lm')
+    lib_path = native_build.native_lib_path(script_dir, "radiation_pattern_lib")
     
     try:
         lib = ctypes.CDLL(lib_path)
@@ -38,6 +80,9 @@ def load_radiation_pattern_lib() -> ctypes.CDLL:
     # Set up function signatures
     array_1d_double = npct.ndpointer(dtype=np.float64, ndim=1, flags='CONTIGUOUS')
     array_1d_complex = npct.ndpointer(dtype=np.complex128, ndim=1, flags='CONTIGUOUS')
+    array_1d_complex64 = npct.ndpointer(dtype=np.complex64, ndim=1, flags='CONTIGUOUS')
+    array_2d_double = npct.ndpointer(dtype=np.float64, ndim=2, flags='C_CONTIGUOUS')
+    array_2d_complex = npct.ndpointer(dtype=np.complex128, ndim=2, flags='C_CONTIGUOUS')
     
     # RNG seed function
     lib.seed_rng.argtypes = [ctypes.c_uint64]
@@ -56,6 +101,166 @@ def load_radiation_pattern_lib() -> ctypes.CDLL:
     ]
     lib.calculate_pattern.restype = ctypes.c_int
     
+    lib.calculate_pattern_f32.argtypes = lib.calculate_pattern.argtypes[:-1] + [array_1d_complex64]
+    lib.calculate_pattern_f32.restype = ctypes.c_int
+    
+    lib.calculate_pattern_fft.argtypes = lib.calculate_pattern.argtypes[:-1] + [
+        ctypes.c_int,          # oversample
+        array_1d_complex       # pattern_out
+    ]
+    lib.calculate_pattern_fft.restype = ctypes.c_int
+    
+    lib.calculate_pattern_multibeam.argtypes = [
+        ctypes.c_int,          # n_elements
+        ctypes.c_double,       # spacing_wavelength
+        array_1d_double,       # steering_angles
+        ctypes.c_int,          # n_beams
+        array_1d_double,       # amplitude_weights
+        array_1d_double,       # phase_weights
+        ctypes.c_double,       # phase_error_std
+        array_1d_double,       # theta_deg
+        ctypes.c_int,          # n_theta
+        array_2d_complex       # patterns_out
+    ]
+    lib.calculate_pattern_multibeam.restype = ctypes.c_int
+    
+    lib.calculate_pattern_weight_sets.argtypes = [
+        ctypes.c_int,          # n_elements
+        ctypes.c_double,       # spacing_wavelength
+        ctypes.c_double,       # steering_angle
+        array_2d_double,       # amplitude_sets
+        array_2d_double,       # phase_sets
+        ctypes.c_int,          # n_sets
+        ctypes.c_double,       # phase_error_std
+        array_1d_double,       # theta_deg
+        ctypes.c_int,          # n_theta
+        array_2d_complex       # patterns_out
+    ]
+    lib.calculate_pattern_weight_sets.restype = ctypes.c_int
+    
+    lib.monte_carlo_pattern_stats.argtypes = [
+        ctypes.c_int,          # n_elements
+        ctypes.c_double,       # spacing_wavelength
+        ctypes.c_double,       # steering_angle
+        array_1d_double,       # amplitude_weights
+        array_1d_double,       # phase_weights
+        ctypes.c_double,       # phase_error_std
+        array_1d_double,       # theta_deg
+        ctypes.c_int,          # n_theta
+        ctypes.c_int,          # n_trials
+        array_1d_double,       # mean_power_out
+        array_1d_double,       # var_power_out
+        ctypes.c_double,       # psll_min_db
+        ctypes.c_double,       # psll_max_db
+        ctypes.c_int,          # n_bins
+        npct.ndpointer(dtype=np.uint64, ndim=1, flags='CONTIGUOUS'),  # psll_histogram
+        ctypes.POINTER(PatternMonteCarloStats)  # stats_out
+    ]
+    lib.monte_carlo_pattern_stats.restype = ctypes.c_int
+    
+    lib.analyze_pattern.argtypes = [
+        ctypes.c_int,          # n_elements
+        ctypes.c_double,       # spacing_wavelength
+        ctypes.c_double,       # steering_angle
+        array_1d_double,       # amplitude_weights
+        array_1d_double,       # phase_weights
+        ctypes.c_double,       # phase_error_std
+        ctypes.c_double,       # theta_min_deg
+        ctypes.c_double,       # theta_max_deg
+        ctypes.c_double,       # tolerance_deg
+        array_1d_double,       # null_angles_out
+        ctypes.c_int,          # max_nulls
+        ctypes.POINTER(PatternMetrics)  # metrics_out
+    ]
+    lib.analyze_pattern.restype = ctypes.c_int
+    
+    # Planar arrays
+    lib.calculate_planar_pattern.argtypes = [
+        ctypes.c_int,          # nx
+        ctypes.c_int,          # ny
+        ctypes.c_double,       # dx_wavelength
+        ctypes.c_double,       # dy_wavelength
+        ctypes.c_double,       # steering_theta
+        ctypes.c_double,       # steering_phi
+        array_2d_double,       # amplitude_weights (ny x nx)
+        array_2d_double,       # phase_weights (ny x nx)
+        ctypes.c_double,       # phase_error_std
+        array_1d_double,       # theta_deg
+        ctypes.c_int,          # n_theta
+        array_1d_double,       # phi_deg
+        ctypes.c_int,          # n_phi
+        array_2d_complex       # pattern_out (n_theta x n_phi)
+    ]
+    lib.calculate_planar_pattern.restype = ctypes.c_int
+    
+    lib.calculate_planar_pattern_positions.argtypes = [
+        ctypes.c_int,          # n_elements
+        array_1d_double,       # x_wavelength
+        array_1d_double,       # y_wavelength
+        ctypes.c_double,       # steering_theta
+        ctypes.c_double,       # steering_phi
+        array_1d_double,       # amplitude_weights
+        array_1d_double,       # phase_weights
+        ctypes.c_double,       # phase_error_std
+        array_1d_double,       # theta_deg
+        ctypes.c_int,          # n_theta
+        array_1d_double,       # phi_deg
+        ctypes.c_int,          # n_phi
+        array_2d_complex       # pattern_out (n_theta x n_phi)
+    ]
+    lib.calculate_planar_pattern_positions.restype = ctypes.c_int
+    
+    # Pattern plans; the hot calls take raw pointers so no per-call array checks run
+    lib.pattern_plan_create.argtypes = [
+        ctypes.c_int,          # n_elements
+        ctypes.c_double,       # spacing_wavelength
+        array_1d_double,       # theta_deg
+        ctypes.c_int           # n_theta
+    ]
+    lib.pattern_plan_create.restype = ctypes.c_void_p
+    
+    lib.pattern_plan_destroy.argtypes = [ctypes.c_void_p]
+    lib.pattern_plan_destroy.restype = None
+    
+    lib.pattern_plan_execute.argtypes = [
+        ctypes.c_void_p,       # plan
+        ctypes.c_double,       # steering_angle
+        ctypes.c_void_p,       # amplitude_weights
+        ctypes.c_void_p,       # phase_weights
+        ctypes.c_double,       # phase_error_std
+        ctypes.c_void_p        # pattern_out
+    ]
+    lib.pattern_plan_execute.restype = ctypes.c_int
+    
+    lib.pattern_plan_execute_awgn.argtypes = [
+        ctypes.c_void_p,       # plan
+        ctypes.c_double,       # steering_angle
+        ctypes.c_void_p,       # amplitude_weights
+        ctypes.c_void_p,       # phase_weights
+        ctypes.c_double,       # phase_error_std
+        ctypes.c_double,       # snr_db
+        ctypes.c_double,       # signal_power (<= 0 to measure)
+        ctypes.c_void_p,       # signal_power_out
+        ctypes.c_void_p        # pattern_out
+    ]
+    lib.pattern_plan_execute_awgn.restype = ctypes.c_int
+    
+    # Array factor kernel selection
+    lib.get_pattern_kernel.argtypes = []
+    lib.get_pattern_kernel.restype = ctypes.c_char_p
+    lib.set_pattern_kernel.argtypes = [ctypes.c_char_p]
+    lib.set_pattern_kernel.restype = ctypes.c_int
+    
+    # Hot-path counters
+    lib.set_stats_enabled.argtypes = [ctypes.c_bool]
+    lib.set_stats_enabled.restype = ctypes.c_int
+    lib.get_stats_enabled.argtypes = []
+    lib.get_stats_enabled.restype = ctypes.c_bool
+    lib.get_stats.argtypes = [ctypes.POINTER(PatternStats)]
+    lib.get_stats.restype = ctypes.c_int
+    lib.reset_stats.argtypes = []
+    lib.reset_stats.restype = None
+    
     lib.add_awgn.argtypes = [
         array_1d_complex,      # signal
         ctypes.c_int,          # n_samples
@@ -63,6 +268,22 @@ def load_radiation_pattern_lib() -> ctypes.CDLL:
     ]
     lib.add_awgn.restype = ctypes.c_int
     
+    lib.add_awgn_power.argtypes = [
+        array_1d_complex,      # signal
+        ctypes.c_int,          # n_samples
+        ctypes.c_double,       # snr_db
+        ctypes.c_double        # signal_power (<= 0 to measure)
+    ]
+    lib.add_awgn_power.restype = ctypes.c_int
+    
+    lib.calculate_pattern_awgn.argtypes = lib.calculate_pattern.argtypes[:-1] + [
+        ctypes.c_double,       # snr_db
+        ctypes.c_double,       # signal_power (<= 0 to measure)
+        ctypes.POINTER(ctypes.c_double),  # signal_power_out
+        array_1d_complex       # pattern_out
+    ]
+    lib.calculate_pattern_awgn.restype = ctypes.c_int
+    
     return lib
 
 # Load the C library on module import
@@ -99,7 +320,49 @@ class ArrayParameters:
         self.amplitude_weights = np.ascontiguousarray(self.amplitude_weights, dtype=np.float64)
         self.phase_weights = np.ascontiguousarray(self.phase_weights, dtype=np.float64)
 
-def calculate_pattern(params: ArrayParameters, theta: np.ndarray, snr_db: Optional[float] = None) -> np.ndarray:
+def get_pattern_kernel() -> str:
+    """Name of the C array factor kernel in use ('avx512', 'avx2', 'generic' or 'scalar')."""
+    return _lib.get_pattern_kernel().decode()
+
+def set_pattern_kernel(name: Optional[str] = None) -> None:
+    """Force an array factor kernel by name, or restore the best one for this CPU with None."""
+    if _lib.set_pattern_kernel(name.encode() if name is not None else None) != 0:
+        raise ValueError(f"Pattern kernel '{name}' is unknown or not supported on this CPU")
+
+def set_stats_enabled(enabled: bool) -> None:
+    """Turn the C library's hot-path counters on or off (off by default)."""
+    if _lib.set_stats_enabled(enabled) != 0:
+        raise RuntimeError("radiation_pattern_lib was built with PATTERN_STATS=0")
+
+def get_stats_enabled() -> bool:
+    """Whether the hot-path counters are on."""
+    return bool(_lib.get_stats_enabled())
+
+def get_stats() -> dict:
+    """Hot-path counters summed over every thread, with the cycle counts also in nanoseconds.
+
+    The pattern functions count calls, elements x angles evaluated, Box-Muller
+    pairs drawn and scratch allocations, and split their cycles into setup
+    (weights and phase steps), kernel and noise; the fused noisy pattern
+    counts its noise as kernel time. Multi-beam and weight-set calls count
+    once with the terms of every row, and analyze_pattern counts each of its
+    single-angle evaluations as n_elements terms.
+    """
+    stats = PatternStats()
+    if _lib.get_stats(ctypes.byref(stats)) != 0:
+        raise RuntimeError("Failed to read pattern stats")
+    result = {name: getattr(stats, name) for name, _ in PatternStats._fields_}
+    for phase in ("setup", "kernel", "noise"):
+        result[f"{phase}_ns"] = result[f"{phase}_cycles"] * stats.ns_per_cycle
+    return result
+
+def reset_stats() -> None:
+    """Zero the hot-path counters of every thread."""
+    _lib.reset_stats()
+
+def calculate_pattern(params: ArrayParameters, theta: np.ndarray, snr_db: Optional[float] = None,
+                      precision: str = 'double', method: str = 'direct',
+                      signal_power: Optional[float] = None) -> np.ndarray:
     """
     Calculate the radiation pattern for a linear array using C implementation.
     
@@ -107,39 +370,401 @@ def calculate_pattern(params: ArrayParameters, theta: np.ndarray, snr_db: Option
         params: ArrayParameters object containing array configuration
         theta: Array of angles (in degrees) to calculate pattern for
         snr_db: Optional Signal-to-Noise Ratio in dB for adding AWGN
+        precision: 'double' (complex128 result) or 'single' (complex64 result,
+            faster but accurate to roughly 1e-5 of the main lobe)
+        method: 'direct' sums every element at every angle; 'fft' transforms
+            the zero-padded weights once and interpolates, which is much
+            faster for large arrays and dense grids (double precision only,
+            accurate to roughly 1e-4 of the main lobe)
+        signal_power: Optional known mean |AF|^2 of the clean pattern; sets the
+            noise level directly so repeated noisy realizations skip measuring
+            it (e.g. np.mean(np.abs(calculate_pattern(params, theta))**2))
         
     Returns:
         Complex array containing the radiation pattern
     """
+    if precision not in ('double', 'single'):
+        raise ValueError("precision must be 'double' or 'single'")
+    if method not in ('direct', 'fft'):
+        raise ValueError("method must be 'direct' or 'fft'")
+    if method == 'fft' and precision != 'double':
+        raise ValueError("the FFT method only supports double precision")
+    
     # Ensure theta is contiguous and double precision
     theta = np.ascontiguousarray(theta, dtype=np.float64)
     
+    if precision == 'single':
+        pattern32 = np.zeros(len(theta), dtype=np.complex64)
+        result = _lib.calculate_pattern_f32(
+            params.n_elements,
+            params.spacing_wavelength,
+            params.steering_angle,
+            params.amplitude_weights,
+            params.phase_weights,
+            params.phase_error_std,
+            theta,
+            len(theta),
+            pattern32
+        )
+        if result != 0:
+            raise RuntimeError("Failed to calculate radiation pattern")
+        if snr_db is None:
+            return pattern32
+        
+        # The noise generator works in double precision
+        pattern = pattern32.astype(np.complex128)
+        result = _lib.add_awgn_power(pattern, len(pattern), snr_db, signal_power or 0.0)
+        if result != 0:
+            raise RuntimeError("Failed to add AWGN")
+        return pattern.astype(np.complex64)
+    
     # Prepare output array
     pattern = np.zeros(len(theta), dtype=np.complex128)
     
+    # Pattern and noise in one fused C pass
+    if snr_db is not None and method == 'direct':
+        result = _lib.calculate_pattern_awgn(
+            params.n_elements,
+            params.spacing_wavelength,
+            params.steering_angle,
+            params.amplitude_weights,
+            params.phase_weights,
+            params.phase_error_std,
+            theta,
+            len(theta),
+            snr_db,
+            signal_power or 0.0,
+            None,
+            pattern
+        )
+        if result != 0:
+            raise RuntimeError("Failed to calculate noisy radiation pattern")
+        return pattern
+    
     # Call C function to calculate pattern
-    result = _lib.calculate_pattern(
+    if method == 'fft':
+        result = _lib.calculate_pattern_fft(
+            params.n_elements,
+            params.spacing_wavelength,
+            params.steering_angle,
+            params.amplitude_weights,
+            params.phase_weights,
+            params.phase_error_std,
+            theta,
+            len(theta),
+            0,  # Default oversampling
+            pattern
+        )
+    else:
+        result = _lib.calculate_pattern(
+            params.n_elements,
+            params.spacing_wavelength,
+            params.steering_angle,
+            params.amplitude_weights,
+            params.phase_weights,
+            params.phase_error_std,  # Pass std dev directly
+            theta,
+            len(theta),
+            pattern
+        )
+    
+    if result != 0:
+        raise RuntimeError("Failed to calculate radiation pattern")
+    
+    # Add noise if SNR is specified
+    if snr_db is not None:
+        result = _lib.add_awgn_power(pattern, len(pattern), snr_db, signal_power or 0.0)
+        if result != 0:
+            raise RuntimeError("Failed to add AWGN")
+    
+    return pattern
+
+class PatternPlan:
+    """
+    Reusable workspace for repeated pattern evaluations on one angle grid.
+    
+    The plan owns contiguous copies of the weights, the output buffer and
+    the C-side scratch (including precomputed sin(theta)), so execute()
+    allocates nothing on either side of the ctypes boundary. ctypes
+    releases the GIL for the duration of each C call, so several Python
+    threads can drive separate plans concurrently; a single plan must not
+    be executed from two threads at once.
+    
+    Example:
+        plan = PatternPlan(params, theta)
+        for angle in angles:
+            pattern = plan.execute(steering_angle=angle)  # reuses plan.output
+    """
+    
+    def __init__(self, params: ArrayParameters, theta: np.ndarray):
+        self.params = params
+        self.theta = np.ascontiguousarray(theta, dtype=np.float64)
+        self.amplitude_weights = params.amplitude_weights.copy()
+        self.phase_weights = params.phase_weights.copy()
+        self.output = np.zeros(len(self.theta), dtype=np.complex128)
+        self.signal_power = ctypes.c_double(0.0)
+        
+        self._plan = _lib.pattern_plan_create(params.n_elements, params.spacing_wavelength,
+                                              self.theta, len(self.theta))
+        if not self._plan:
+            raise MemoryError("Failed to create pattern plan")
+        
+        # Raw pointers, resolved once
+        self._amplitude_ptr = self.amplitude_weights.ctypes.data
+        self._phase_ptr = self.phase_weights.ctypes.data
+        self._output_ptr = self.output.ctypes.data
+        self._signal_power_ptr = ctypes.addressof(self.signal_power)
+    
+    def set_weights(self, amplitude_weights: Optional[np.ndarray] = None,
+                    phase_weights: Optional[np.ndarray] = None) -> None:
+        """Copy new element weights into the plan's buffers (no reallocation)."""
+        if amplitude_weights is not None:
+            np.copyto(self.amplitude_weights, amplitude_weights)
+        if phase_weights is not None:
+            np.copyto(self.phase_weights, phase_weights)
+    
+    def execute(self, steering_angle: Optional[float] = None, snr_db: Optional[float] = None,
+                signal_power: Optional[float] = None) -> np.ndarray:
+        """
+        Evaluate the pattern into the plan's output buffer.
+        
+        Args:
+            steering_angle: Steering angle in degrees (default: params.steering_angle)
+            snr_db: Optional Signal-to-Noise Ratio in dB for adding AWGN
+            signal_power: Optional known mean |AF|^2 of the clean pattern; skips
+                measuring it. The power used for the last noisy call is left in
+                plan.signal_power.value
+            
+        Returns:
+            plan.output, overwritten by the next call (copy it to keep it)
+        """
+        if self._plan is None:
+            raise RuntimeError("Pattern plan has been closed")
+        if steering_angle is None:
+            steering_angle = self.params.steering_angle
+        
+        if snr_db is None:
+            result = _lib.pattern_plan_execute(self._plan, steering_angle, self._amplitude_ptr,
+                                               self._phase_ptr, self.params.phase_error_std,
+                                               self._output_ptr)
+        else:
+            result = _lib.pattern_plan_execute_awgn(self._plan, steering_angle, self._amplitude_ptr,
+                                                    self._phase_ptr, self.params.phase_error_std,
+                                                    snr_db, signal_power or 0.0,
+                                                    self._signal_power_ptr, self._output_ptr)
+        if result != 0:
+            raise RuntimeError("Failed to calculate radiation pattern")
+        return self.output
+    
+    def close(self) -> None:
+        """Release the C workspace."""
+        if self._plan is not None:
+            _lib.pattern_plan_destroy(self._plan)
+            self._plan = None
+    
+    def __enter__(self) -> 'PatternPlan':
+        return self
+    
+    def __exit__(self, *exc) -> None:
+        self.close()
+    
+    def __del__(self):
+        if getattr(self, '_plan', None) is not None and _lib is not None:
+            self.close()
+
+def _add_noise_rows(patterns: np.ndarray, snr_db: Optional[float]) -> None:
+    """Add AWGN to each row of a pattern matrix in place, one SNR reference per row."""
+    if snr_db is None:
+        return
+    for row in patterns:
+        if _lib.add_awgn(row, len(row), snr_db) != 0:
+            raise RuntimeError("Failed to add AWGN")
+
+def calculate_multibeam_pattern(params: ArrayParameters, theta: np.ndarray, steering_angles: np.ndarray,
+                                snr_db: Optional[float] = None) -> np.ndarray:
+    """
+    Calculate patterns for many steering angles in a single C call.
+    
+    Equivalent to calling calculate_pattern once per angle with
+    params.steering_angle replaced, but sin(theta) and the steering
+    phasors are computed once for all beams.
+    
+    Args:
+        params: ArrayParameters object (its steering_angle is ignored)
+        theta: Array of angles (in degrees) to calculate patterns for
+        steering_angles: Array of beam steering angles in degrees
+        snr_db: Optional Signal-to-Noise Ratio in dB for adding AWGN to each beam
+        
+    Returns:
+        Complex array of shape (len(steering_angles), len(theta))
+    """
+    theta = np.ascontiguousarray(theta, dtype=np.float64)
+    steering_angles = np.ascontiguousarray(steering_angles, dtype=np.float64)
+    patterns = np.zeros((len(steering_angles), len(theta)), dtype=np.complex128)
+    
+    result = _lib.calculate_pattern_multibeam(
         params.n_elements,
         params.spacing_wavelength,
-        params.steering_angle,
+        steering_angles,
+        len(steering_angles),
         params.amplitude_weights,
         params.phase_weights,
-        params.phase_error_std,  # Pass std dev directly
+        params.phase_error_std,
         theta,
         len(theta),
-        pattern
+        patterns
     )
+    if result != 0:
+        raise RuntimeError("Failed to calculate multi-beam patterns")
+    
+    _add_noise_rows(patterns, snr_db)
+    return patterns
+
+def calculate_weight_set_patterns(params: ArrayParameters, theta: np.ndarray,
+                                  amplitude_sets: np.ndarray, phase_sets: np.ndarray,
+                                  snr_db: Optional[float] = None) -> np.ndarray:
+    """
+    Calculate patterns for many sets of element weights in a single C call.
     
+    Args:
+        params: ArrayParameters object (its weights are ignored)
+        theta: Array of angles (in degrees) to calculate patterns for
+        amplitude_sets: Amplitude weights, shape (n_sets, n_elements)
+        phase_sets: Phase weights in degrees, shape (n_sets, n_elements)
+        snr_db: Optional Signal-to-Noise Ratio in dB for adding AWGN to each set
+        
+    Returns:
+        Complex array of shape (n_sets, len(theta))
+    """
+    theta = np.ascontiguousarray(theta, dtype=np.float64)
+    amplitude_sets = np.ascontiguousarray(amplitude_sets, dtype=np.float64)
+    phase_sets = np.ascontiguousarray(phase_sets, dtype=np.float64)
+    if amplitude_sets.ndim != 2 or amplitude_sets.shape[1] != params.n_elements:
+        raise ValueError("Amplitude sets must have shape (n_sets, n_elements)")
+    if phase_sets.shape != amplitude_sets.shape:
+        raise ValueError("Phase sets must have the same shape as amplitude sets")
+    
+    patterns = np.zeros((amplitude_sets.shape[0], len(theta)), dtype=np.complex128)
+    
+    result = _lib.calculate_pattern_weight_sets(
+        params.n_elements,
+        params.spacing_wavelength,
+        params.steering_angle,
+        amplitude_sets,
+        phase_sets,
+        amplitude_sets.shape[0],
+        params.phase_error_std,
+        theta,
+        len(theta),
+        patterns
+    )
     if result != 0:
-        raise RuntimeError("Failed to calculate radiation pattern")
+        raise RuntimeError("Failed to calculate weight set patterns")
     
-    # Add noise if SNR is specified
-    if snr_db is not None:
-        result = _lib.add_awgn(pattern, len(pattern), snr_db)
-        if result != 0:
-            raise RuntimeError("Failed to add AWGN")
+    _add_noise_rows(patterns, snr_db)
+    return patterns
+
+def monte_carlo_statistics(params: ArrayParameters, theta: np.ndarray, n_trials: int,
+                           psll_range: Tuple[float, float] = (-60.0, 0.0), n_bins: int = 60) -> dict:
+    """
+    Run phase-error Monte Carlo trials in C and return streamed statistics.
     
-    return pattern
+    Each trial draws fresh phase errors with params.phase_error_std. The
+    per-trial patterns are reduced on the fly and never stored, so memory
+    does not grow with n_trials.
+    
+    Args:
+        params: ArrayParameters object containing array configuration
+        theta: Array of angles (in degrees); keep within +-90 for sidelobe statistics
+        n_trials: Number of trials
+        psll_range: (min_db, max_db) range of the peak sidelobe histogram;
+            values outside fall into the first or last bin. The PSLL
+            summaries use the unclipped levels, over the trials that have
+            a sidelobe on the grid.
+        n_bins: Number of histogram bins
+        
+    Returns:
+        Dictionary with 'mean_power' and 'var_power' (|AF|^2 per angle),
+        'psll_histogram' and 'psll_bin_edges', and the scalar summaries of
+        PatternMonteCarloStats
+    """
+    theta = np.ascontiguousarray(theta, dtype=np.float64)
+    mean_power = np.zeros(len(theta))
+    var_power = np.zeros(len(theta))
+    histogram = np.zeros(max(n_bins, 1), dtype=np.uint64)
+    stats = PatternMonteCarloStats()
+    
+    result = _lib.monte_carlo_pattern_stats(
+        params.n_elements,
+        params.spacing_wavelength,
+        params.steering_angle,
+        params.amplitude_weights,
+        params.phase_weights,
+        params.phase_error_std,
+        theta,
+        len(theta),
+        n_trials,
+        mean_power,
+        var_power,
+        psll_range[0],
+        psll_range[1],
+        n_bins,
+        histogram,
+        ctypes.byref(stats)
+    )
+    if result != 0:
+        raise RuntimeError("Failed to run Monte Carlo trials")
+    
+    summary = {name: getattr(stats, name) for name, _ in PatternMonteCarloStats._fields_}
+    summary.update({
+        'mean_power': mean_power,
+        'var_power': var_power,
+        'psll_histogram': histogram[:n_bins],
+        'psll_bin_edges': np.linspace(psll_range[0], psll_range[1], n_bins + 1)
+    })
+    return summary
+
+def analyze_pattern(params: ArrayParameters, theta_range: Tuple[float, float] = (-90.0, 90.0),
+                    tolerance_deg: float = 1e-6, max_nulls: int = 256) -> dict:
+    """
+    Measure main lobe, beamwidth, sidelobe level and nulls without a dense grid.
+    
+    The C side samples about four points per lobe and refines only around
+    extrema and half-power points, typically needing 10-100x fewer
+    evaluations than a uniform grid of comparable accuracy.
+    
+    Args:
+        params: ArrayParameters object containing array configuration
+        theta_range: (min, max) angular range in degrees
+        tolerance_deg: Angular accuracy of refined extrema
+        max_nulls: Maximum number of null angles returned
+        
+    Returns:
+        Dictionary with the fields of PatternMetrics and 'null_angles_deg'
+    """
+    nulls = np.zeros(max(max_nulls, 1))
+    metrics = PatternMetrics()
+    
+    result = _lib.analyze_pattern(
+        params.n_elements,
+        params.spacing_wavelength,
+        params.steering_angle,
+        params.amplitude_weights,
+        params.phase_weights,
+        params.phase_error_std,
+        theta_range[0],
+        theta_range[1],
+        tolerance_deg,
+        nulls,
+        max_nulls,
+        ctypes.byref(metrics)
+    )
+    if result != 0:
+        raise RuntimeError("Failed to analyze pattern")
+    
+    summary = {name: getattr(metrics, name) for name, _ in PatternMetrics._fields_}
+    summary['null_angles_deg'] = nulls[:min(metrics.n_nulls, max_nulls)]
+    return summary
 
 def plot_radiation_pattern(params: ArrayParameters, theta: Optional[np.ndarray] = None) -> Tuple[plt.Figure, plt.Axes]:
     """
@@ -185,15 +810,52 @@ def plot_radiation_pattern(params: ArrayParameters, theta: Optional[np.ndarray]
     plt.tight_layout()
     return fig, (ax1, ax2)
 
-def measure_performance(n_elements_range: range) -> dict:
+def _status_bytes(field: str) -> int:
+    """Read a memory field such as VmRSS from /proc/self/status, in bytes"""
+    with open("/proc/self/status") as f:
+        for line in f:
+            if line.startswith(field + ":"):
+                return int(line.split()[1]) * 1024
+    raise OSError(f"{field} missing from /proc/self/status")
+
+def _measure_peak_rss(func) -> int:
+    """
+    Run func() and return its peak resident memory above the RSS before the call.
+    
+    On Linux the high-water mark is reset through /proc/self/clear_refs so each
+    call is measured on its own. Elsewhere only growth of the process's lifetime
+    peak is visible, which reads 0 when an earlier call already went higher.
+    """
+    try:
+        with open("/proc/self/clear_refs", "w") as f:
+            f.write("5")
+        before = _status_bytes("VmRSS")
+        func()
+        return max(0, _status_bytes("VmHWM") - before)
+    except OSError:
+        pass
+    try:
+        import resource
+    except ImportError:
+        func()
+        return 0
+    scale = 1 if sys.platform == "darwin" else 1024  # ru_maxrss is in KiB on Linux
+    before = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    func()
+    return max(0, resource.getrusage(resource.RUSAGE_SELF).ru_maxrss - before) * scale
+
+def measure_performance(n_elements_range: range, n_angles: int = 721, repeats: int = 5) -> dict:
     """
     Measure performance metrics for different array sizes.
     
     Args:
         n_elements_range: Range of number of elements to test
+        n_angles: Number of angles per pattern
+        repeats: Timed runs per size; calc_time is their median
         
     Returns:
-        Dictionary containing performance metrics
+        Dictionary containing performance metrics; memory_usage is the
+        measured peak RSS growth of one calculation in bytes
     """
     results = {
         'n_elements': [],
@@ -201,25 +863,22 @@ def measure_performance(n_elements_range: range) -> dict:
         'memory_usage': [],
     }
     
-    theta = np.linspace(-180, 180, 721)
+    theta = np.linspace(-180, 180, n_angles)
     
     for n in n_elements_range:
         params = ArrayParameters(n_elements=n, spacing_wavelength=0.5)
         
-        # Measure calculation time
-        start_time = time.time()
-        _ = calculate_pattern(params, theta)
-        calc_time = time.time() - start_time
+        # Peak memory of one call, which also warms up the timed runs
+        memory_usage = _measure_peak_rss(lambda: calculate_pattern(params, theta))
         
-        # Estimate memory usage (theoretical, in bytes)
-        memory_usage = (
-            n * 16 +  # Complex weights (8 bytes real + 8 bytes imag)
-            len(theta) * 8 +  # Theta array (double precision)
-            n * len(theta) * 16  # Steering vectors (complex)
-        )
+        times = []
+        for _ in range(repeats):
+            start_time = time.perf_counter()
+            _ = calculate_pattern(params, theta)
+            times.append(time.perf_counter() - start_time)
         
         results['n_elements'].append(n)
-        results['calc_time'].append(calc_time)
+        results['calc_time'].append(float(np.median(times)))
         results['memory_usage'].append(memory_usage)
     
     return results
@@ -239,14 +898,16 @@ def compare_implementations(n_elements: int = 100, n_angles: int = 721) -> None:
     params_c = ArrayParameters(n_elements=n_elements, spacing_wavelength=0.5)
     
     # Test Python implementation
-    start_time = time.time()
+    start_time = time.perf_counter()
     pattern_py = linear_array.calculate_pattern(params_py, theta)
-    py_time = time.time() - start_time
+    py_time = time.perf_counter() - start_time
     
-    # Test C implementation
-    start_time = time.time()
-    pattern_c = calculate_pattern(params_c, theta)
-    c_time = time.time() - start_time
+    # Test C implementation, best of several runs as a single one is near timer resolution
+    c_time = float('inf')
+    for _ in range(5):
+        start_time = time.perf_counter()
+        pattern_c = calculate_pattern(params_c, theta)
+        c_time = min(c_time, time.perf_counter() - start_time)
     
     # Compare results
     max_diff = np.max(np.abs(pattern_py - pattern_c))
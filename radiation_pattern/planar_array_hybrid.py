@@ -0,0 +1,142 @@
+"""
+Planar Array Radiation Pattern Calculator - Hybrid Python/C Implementation
+
+This module computes radiation patterns of planar antenna arrays over a
+theta x phi grid. Rectangular lattices use the separable C engine; arrays
+with arbitrary element positions use the blocked fallback. Both share the
+C library loaded by linear_array_hybrid.
+"""
+
+import numpy as np
+import matplotlib.pyplot as plt
+from typing import Tuple, Optional
+from dataclasses import dataclass
+
+from linear_array_hybrid import _lib
+
+@dataclass
+class PlanarArrayParameters:
+    """
+    Parameters defining a planar antenna array.
+    
+    Directions use theta measured from broadside (the array normal) and phi
+    measured in the array plane from the x axis.
+    """
+    nx: int
+    ny: int
+    dx_wavelength: float = 0.5
+    dy_wavelength: float = 0.5
+    steering_theta: float = 0.0  # Main beam elevation from broadside in degrees
+    steering_phi: float = 0.0  # Main beam azimuth in degrees
+    amplitude_weights: Optional[np.ndarray] = None  # Shape (ny, nx)
+    phase_weights: Optional[np.ndarray] = None  # Shape (ny, nx), degrees
+    phase_error_std: float = 0.0  # Standard deviation of phase errors in degrees
+    element_positions: Optional[np.ndarray] = None  # Optional (ny*nx, 2) x/y positions in wavelengths
+    seed: Optional[int] = None  # Random seed for reproducible phase errors
+
+    def __post_init__(self):
+        """Validate and initialize weights if not provided."""
+        if self.seed is not None:
+            _lib.seed_rng(self.seed)
+        
+        shape = (self.ny, self.nx)
+        if self.amplitude_weights is None:
+            self.amplitude_weights = np.ones(shape)
+        if self.phase_weights is None:
+            self.phase_weights = np.zeros(shape)
+        
+        self.amplitude_weights = np.ascontiguousarray(self.amplitude_weights, dtype=np.float64).reshape(shape)
+        self.phase_weights = np.ascontiguousarray(self.phase_weights, dtype=np.float64).reshape(shape)
+        
+        if self.element_positions is not None:
+            self.element_positions = np.ascontiguousarray(self.element_positions, dtype=np.float64)
+            if self.element_positions.shape != (self.nx * self.ny, 2):
+                raise ValueError("Element positions must have shape (nx * ny, 2)")
+
+def calculate_planar_pattern(params: PlanarArrayParameters, theta: np.ndarray, phi: np.ndarray) -> np.ndarray:
+    """
+    Calculate the radiation pattern of a planar array using C implementation.
+    
+    Args:
+        params: PlanarArrayParameters object containing array configuration
+        theta: Elevation angles from broadside in degrees
+        phi: Azimuth angles in degrees
+        
+    Returns:
+        Complex array of shape (len(theta), len(phi))
+    """
+    theta = np.ascontiguousarray(theta, dtype=np.float64)
+    phi = np.ascontiguousarray(phi, dtype=np.float64)
+    pattern = np.zeros((len(theta), len(phi)), dtype=np.complex128)
+    
+    if params.element_positions is None:
+        result = _lib.calculate_planar_pattern(
+            params.nx,
+            params.ny,
+            params.dx_wavelength,
+            params.dy_wavelength,
+            params.steering_theta,
+            params.steering_phi,
+            params.amplitude_weights,
+            params.phase_weights,
+            params.phase_error_std,
+            theta,
+            len(theta),
+            phi,
+            len(phi),
+            pattern
+        )
+    else:
+        result = _lib.calculate_planar_pattern_positions(
+            params.nx * params.ny,
+            np.ascontiguousarray(params.element_positions[:, 0]),
+            np.ascontiguousarray(params.element_positions[:, 1]),
+            params.steering_theta,
+            params.steering_phi,
+            params.amplitude_weights.ravel(),
+            params.phase_weights.ravel(),
+            params.phase_error_std,
+            theta,
+            len(theta),
+            phi,
+            len(phi),
+            pattern
+        )
+    
+    if result != 0:
+        raise RuntimeError("Failed to calculate planar radiation pattern")
+    
+    return pattern
+
+def plot_planar_pattern(params: PlanarArrayParameters, theta: Optional[np.ndarray] = None,
+                        phi: Optional[np.ndarray] = None, dynamic_range_db: float = 60.0) -> Tuple[plt.Figure, plt.Axes]:
+    """
+    Plot the normalized planar pattern in dB over the theta x phi grid.
+    
+    Args:
+        params: PlanarArrayParameters object containing array configuration
+        theta: Optional elevation angles. If None, uses 0 to 90 degrees in 1 degree steps
+        phi: Optional azimuth angles. If None, uses 0 to 359 degrees in 1 degree steps
+        dynamic_range_db: Range below the peak shown in the plot
+        
+    Returns:
+        Figure and Axes objects
+    """
+    if theta is None:
+        theta = np.arange(0, 91, 1.0)
+    if phi is None:
+        phi = np.arange(0, 360, 1.0)
+    
+    pattern_abs = np.abs(calculate_planar_pattern(params, theta, phi))
+    max_val = np.max(pattern_abs)
+    pattern_db = 20 * np.log10(np.maximum(pattern_abs, max_val * 10 ** (-dynamic_range_db / 20)) / max_val)
+    
+    fig, ax = plt.subplots(figsize=(10, 5))
+    mesh = ax.pcolormesh(phi, theta, pattern_db, shading='auto', vmin=-dynamic_range_db, vmax=0)
+    fig.colorbar(mesh, ax=ax, label='Magnitude (dB)')
+    ax.set_xlabel('Phi (degrees)')
+    ax.set_ylabel('Theta (degrees)')
+    ax.set_title(f'Planar Array Pattern ({params.nx}x{params.ny}, '
+                 f'steering θ={params.steering_theta}°, φ={params.steering_phi}°)')
+    
+    return fig, ax
@@ -2,9 +2,15 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <complex.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 #ifdef _WIN32
 #define EXPORT __declspec(dllexport)
@@ -12,19 +18,66 @@
 #define EXPORT
 #endif
 
+#define PHASOR_RESYNC 64      // Elements between exact phasor evaluations in calculate_pattern
+#define PHASOR_RESYNC_F32 32  // Same for the single precision kernels
+#define PATTERN_FFT_OVERSAMPLE 16  // Default zero-padding factor for calculate_pattern_fft
+#define PATTERN_FFT_MIN_SIZE 64    // Smallest FFT length used by calculate_pattern_fft
+#define PATTERN_GEMM_TILE 32       // Angles per tile in the multi-beam kernels
+#define PATTERN_MC_CHUNK 32        // Monte Carlo trials per ordered reduction chunk
+#define PATTERN_NOISE_TILE 256     // Angles per tile in calculate_pattern_awgn
+#define PLANAR_TILE 256            // Grid points per tile in the planar engines
+#define PLANAR_ELEMENT_BLOCK 256   // Elements per block for arbitrary planar layouts
+#define PATTERN_REFINE_MIN_COARSE 16  // Fewest coarse samples in analyze_pattern
+#define PATTERN_REFINE_MAX_ITER 100   // Iteration cap for each refined root
+#define STATS_MAX_THREADS 256         // Threads with their own stats slot; later ones share the last
+#define STATS_CALIBRATION_NS 2000000  // Cycle counter calibration window when stats are enabled
+
+// Build with -DPATTERN_STATS=0 to compile the hot-path counters out
+#ifndef PATTERN_STATS
+#define PATTERN_STATS 1
+#endif
+
+// Hot-path counters summed over every thread, see get_stats()
+typedef struct {
+    uint64_t calls;            // Instrumented calls
+    uint64_t evaluations;      // Array factor terms, elements times angles
+    uint64_t rng_draws;        // Box-Muller pairs drawn
+    uint64_t allocations;      // Scratch buffers allocated
+    uint64_t allocated_bytes;  // Their total size
+    uint64_t setup_cycles;     // Cycles spent on weights and phase steps
+    uint64_t kernel_cycles;    // Cycles spent in the array factor kernels
+    uint64_t noise_cycles;     // Cycles spent adding noise
+    uint32_t threads;          // Threads that have recorded stats
+    double ns_per_cycle;       // Cycle counter period, to convert the cycle counts
+} PatternStats;
+
 // PCG Random Number Generator state
 typedef struct {
     uint64_t state;
     uint64_t inc;
 } pcg32_random_t;
 
-// Initialize PCG RNG
-static pcg32_random_t rng = { 0x853c49e6748fea9bULL, 0xda3e39cb94b95bdbULL };
+// Counter-based streams
+//
+// Every call that needs randomness takes the next epoch from an atomic
+// counter, and draw i of that call comes from its own PCG stream keyed by
+// (seed, epoch, i). Draws never share state, so parallel loops are
+// race-free and seed_rng() gives bit-identical results at any thread count.
+static uint64_t rng_seed = 0x853c49e6748fea9bULL;
+static _Atomic uint64_t rng_epoch = 0;
+
+// SplitMix64 finalizer, used to decorrelate stream keys
+static uint64_t splitmix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
 
 // PCG Random Number Generator implementation
-static uint32_t pcg32_random(void) {
-    uint64_t oldstate = rng.state;
-    rng.state = oldstate * 6364136223846793005ULL + rng.inc;
+static uint32_t pcg32_random(pcg32_random_t* rng) {
+    uint64_t oldstate = rng->state;
+    rng->state = oldstate * 6364136223846793005ULL + rng->inc;
     uint32_t xorshifted = ((oldstate >> 18u) ^ oldstate) >> 27u;
     uint32_t rot = oldstate >> 59u;
     return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
@@ -32,34 +85,836 @@ static uint32_t pcg32_random(void) {
 
 // Seed the PCG RNG
 EXPORT void seed_rng(uint64_t seed) {
-    rng.state = seed;
-    rng.inc = (seed << 1) | 1;
-    pcg32_random(); // Advance state
+    rng_seed = seed;
+    atomic_store(&rng_epoch, 0);
 }
 
-// Generate random normal using Box-Muller transform
-static double randn(double mean, double std_dev) {
-    double u1, u2, z;
-    static bool has_spare = false;
-    static double spare;
+// Stream key for the draws of one epoch
+static uint64_t rng_epoch_key(uint64_t epoch) {
+    return splitmix64(rng_seed ^ splitmix64(epoch));
+}
 
-    if (has_spare) {
-        has_spare = false;
-        return mean + std_dev * spare;
-    }
+// Claim `count` consecutive epochs and return the first
+static uint64_t rng_claim_epochs(uint64_t count) {
+    return atomic_fetch_add_explicit(&rng_epoch, count, memory_order_relaxed);
+}
+
+// Claim the stream key for one generating call
+static uint64_t rng_begin_call(void) {
+    return rng_epoch_key(rng_claim_epochs(1));
+}
+
+// Generate a pair of standard normals for draw `index` using Box-Muller
+static void randn_pair(uint64_t key, uint64_t index, double* z0, double* z1) {
+    // Standard PCG stream initialisation: the index picks the increment
+    pcg32_random_t rng = { 0, (index << 1) | 1 };
+    pcg32_random(&rng);
+    rng.state += key ^ splitmix64(index);
+    pcg32_random(&rng);
 
+    double u1, u2;
     do {
-        u1 = (double)pcg32_random() / UINT32_MAX;
-        u2 = (double)pcg32_random() / UINT32_MAX;
+        u1 = (double)pcg32_random(&rng) / UINT32_MAX;
+        u2 = (double)pcg32_random(&rng) / UINT32_MAX;
     } while (u1 <= 1e-7);  // Avoid log(0)
 
-    double r = sqrt(-2.0 * log(u1));
-    double theta = 2.0 * M_PI * u2;
-    z = r * cos(theta);
-    spare = r * sin(theta);
-    has_spare = true;
+    const double r = sqrt(-2.0 * log(u1));
+    const double theta = 2.0 * M_PI * u2;
+    *z0 = r * cos(theta);
+    *z1 = r * sin(theta);
+}
+
+// Hot-path statistics
+//
+// Opt-in counters for the pattern entry points. While disabled every
+// instrumented call pays one branch per counter. Each calling thread
+// claims its own cache-line slot on first use and adds to it with relaxed
+// atomics, so counting never contends; OpenMP workers are counted by the
+// thread that called into the library.
+
+enum {
+    STAT_CALLS,
+    STAT_EVALUATIONS,
+    STAT_RNG_DRAWS,
+    STAT_ALLOCATIONS,
+    STAT_ALLOCATED_BYTES,
+    STAT_SETUP_CYCLES,
+    STAT_KERNEL_CYCLES,
+    STAT_NOISE_CYCLES,
+    STAT_COUNT
+};
+
+#if PATTERN_STATS
+
+// Counters of one thread, padded to a cache line
+typedef struct {
+    _Alignas(64) _Atomic uint64_t counters[STAT_COUNT];
+} StatsSlot;
+
+static StatsSlot stats_slots[STATS_MAX_THREADS];
+static _Atomic uint64_t stats_threads_claimed = 0;
+static _Thread_local StatsSlot* stats_slot = NULL;
+static bool stats_enabled = false;
+static double ns_per_cycle = 0.0;
+
+// Monotonic clock in nanoseconds, only used to calibrate the cycle counter
+static int64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Read the free-running cycle counter
+static inline uint64_t read_cycle_counter(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return (uint64_t)get_time_ns();
+#endif
+}
+
+// Measure the cycle counter against the monotonic clock
+static void calibrate_cycle_counter(void) {
+    const int64_t start_ns = get_time_ns();
+    const uint64_t start_ticks = read_cycle_counter();
+    int64_t elapsed_ns;
+    do {
+        elapsed_ns = get_time_ns() - start_ns;
+    } while (elapsed_ns < STATS_CALIBRATION_NS);
+    const uint64_t elapsed_ticks = read_cycle_counter() - start_ticks;
+
+    ns_per_cycle = elapsed_ticks ? (double)elapsed_ns / (double)elapsed_ticks : 1.0;
+}
+
+// This thread's slot, claimed on first use
+static inline StatsSlot* stats_thread_slot(void) {
+    if (!stats_slot) {
+        const uint64_t index = atomic_fetch_add_explicit(&stats_threads_claimed, 1, memory_order_relaxed);
+        stats_slot = &stats_slots[index < STATS_MAX_THREADS ? index : STATS_MAX_THREADS - 1];
+    }
+    return stats_slot;
+}
+
+// Add to one of this thread's counters, if stats are enabled
+static inline void stats_add(int counter, uint64_t value) {
+    if (stats_enabled) {
+        atomic_fetch_add_explicit(&stats_thread_slot()->counters[counter], value, memory_order_relaxed);
+    }
+}
+
+// Open a phase; returns 0 when stats are disabled
+static inline uint64_t stats_start(void) {
+    return stats_enabled ? read_cycle_counter() : 0;
+}
+
+// Charge the cycles since start to counter and open the next phase
+static inline uint64_t stats_phase(uint64_t start, int counter) {
+    if (start == 0) return 0;
+    const uint64_t now = read_cycle_counter();
+    atomic_fetch_add_explicit(&stats_thread_slot()->counters[counter], now - start, memory_order_relaxed);
+    return now;
+}
+
+#else
+
+static inline void stats_add(int counter, uint64_t value) { (void)counter; (void)value; }
+static inline uint64_t stats_start(void) { return 0; }
+static inline uint64_t stats_phase(uint64_t start, int counter) { (void)start; (void)counter; return 0; }
+
+#endif
+
+// Count one scratch allocation of `bytes`
+static inline void stats_allocation(size_t bytes) {
+    stats_add(STAT_ALLOCATIONS, 1);
+    stats_add(STAT_ALLOCATED_BYTES, bytes);
+}
+
+// Array factor kernels
+//
+// Every kernel receives the complex element weights in split (SoA) arrays
+// and one phase step psi = k * d * (sin(theta) - sin(steering)) per angle.
+// Element n+1's phasor is element n's times exp(j * psi); the recurrence
+// restarts from an exact sincos every PHASOR_RESYNC elements.
+
+typedef void (*PatternKernel)(const double* weights_re, const double* weights_im, int n_elements,
+                              const double* psi, int n_theta, double complex* pattern_out);
+typedef void (*PatternKernelF32)(const float* weights_re, const float* weights_im, int n_elements,
+                                 const double* psi, int n_theta, float complex* pattern_out);
+typedef void (*PatternGemm)(const double* weights_re, const double* weights_im, int n_sets, int n_elements,
+                            const double* u, int n_theta, double complex* patterns_out);
+typedef void (*PlanarPositionsKernel)(const double* x, const double* y, const double* weights_re,
+                                      const double* weights_im, int n_elements, const double* du,
+                                      const double* dv, int n_points, double complex* pattern_out);
+
+#if defined(__GNUC__)
+#define KERNEL_INLINE static inline __attribute__((always_inline))
+#else
+#define KERNEL_INLINE static inline
+#endif
+
+/**
+ * Portable kernel, one angle at a time
+ */
+static void pattern_kernel_scalar(const double* weights_re, const double* weights_im, int n_elements,
+                                  const double* psi, int n_theta, double complex* pattern_out) {
+    #pragma omp parallel for if(n_theta > 1000)
+    for (int t = 0; t < n_theta; t++) {
+        const double step_re = cos(psi[t]);
+        const double step_im = sin(psi[t]);
+        double sum_re = 0;
+        double sum_im = 0;
+
+        for (int base = 0; base < n_elements; base += PHASOR_RESYNC) {
+            const int end = base + PHASOR_RESYNC < n_elements ? base + PHASOR_RESYNC : n_elements;
+            double z_re = cos(base * psi[t]);
+            double z_im = sin(base * psi[t]);
+
+            for (int n = base; n < end; n++) {
+                sum_re += weights_re[n] * z_re - weights_im[n] * z_im;
+                sum_im += weights_re[n] * z_im + weights_im[n] * z_re;
+
+                const double next_re = z_re * step_re - z_im * step_im;
+                z_im = z_re * step_im + z_im * step_re;
+                z_re = next_re;
+            }
+        }
+
+        pattern_out[t] = sum_re + I * sum_im;
+    }
+}
+
+/**
+ * Portable single precision kernel (accumulates in double)
+ */
+static void pattern_kernel_f32_scalar(const float* weights_re, const float* weights_im, int n_elements,
+                                      const double* psi, int n_theta, float complex* pattern_out) {
+    #pragma omp parallel for if(n_theta > 1000)
+    for (int t = 0; t < n_theta; t++) {
+        const double step_re = cos(psi[t]);
+        const double step_im = sin(psi[t]);
+        double sum_re = 0;
+        double sum_im = 0;
+
+        for (int base = 0; base < n_elements; base += PHASOR_RESYNC) {
+            const int end = base + PHASOR_RESYNC < n_elements ? base + PHASOR_RESYNC : n_elements;
+            double z_re = cos(base * psi[t]);
+            double z_im = sin(base * psi[t]);
+
+            for (int n = base; n < end; n++) {
+                sum_re += weights_re[n] * z_re - weights_im[n] * z_im;
+                sum_im += weights_re[n] * z_im + weights_im[n] * z_re;
+
+                const double next_re = z_re * step_re - z_im * step_im;
+                z_im = z_re * step_im + z_im * step_re;
+                z_re = next_re;
+            }
+        }
+
+        pattern_out[t] = (float)sum_re + I * (float)sum_im;
+    }
+}
+
+/**
+ * Accumulate one tile of multi-beam patterns
+ * 
+ * Builds the steering block exp(j * n * u_t) for PHASOR_RESYNC elements
+ * and PATTERN_GEMM_TILE angles at a time, then multiplies it into every
+ * weight set. The block is generated once and reused by all sets, which
+ * is what makes the batched call cheaper than one call per beam.
+ */
+KERNEL_INLINE void pattern_gemm_tile(const double* weights_re, const double* weights_im, int n_sets,
+                                     int n_elements, const double* u, int n_theta, int t0,
+                                     double complex* patterns_out) {
+    double block_re[PHASOR_RESYNC][PATTERN_GEMM_TILE];
+    double block_im[PHASOR_RESYNC][PATTERN_GEMM_TILE];
+    const int width = n_theta - t0 < PATTERN_GEMM_TILE ? n_theta - t0 : PATTERN_GEMM_TILE;
+
+    for (int base = 0; base < n_elements; base += PHASOR_RESYNC) {
+        const int count = base + PHASOR_RESYNC < n_elements ? PHASOR_RESYNC : n_elements - base;
+
+        // Steering block, exact at the first element and by recurrence after it
+        for (int tt = 0; tt < PATTERN_GEMM_TILE; tt++) {
+            const double ut = tt < width ? u[t0 + tt] : 0;
+            const double step_re = cos(ut);
+            const double step_im = sin(ut);
+            double z_re = cos(base * ut);
+            double z_im = sin(base * ut);
+            for (int n = 0; n < count; n++) {
+                block_re[n][tt] = z_re;
+                block_im[n][tt] = z_im;
+                const double next_re = z_re * step_re - z_im * step_im;
+                z_im = z_re * step_im + z_im * step_re;
+                z_re = next_re;
+            }
+        }
+
+        for (int b = 0; b < n_sets; b++) {
+            const double* wr = weights_re + (size_t)b * n_elements + base;
+            const double* wi = weights_im + (size_t)b * n_elements + base;
+            double* out = (double*)(patterns_out + (size_t)b * n_theta + t0);
+            double acc_re[PATTERN_GEMM_TILE] = {0};
+            double acc_im[PATTERN_GEMM_TILE] = {0};
+
+            if (base > 0) {
+                for (int tt = 0; tt < width; tt++) {
+                    acc_re[tt] = out[2 * tt];
+                    acc_im[tt] = out[2 * tt + 1];
+                }
+            }
+
+            for (int n = 0; n < count; n++) {
+                for (int tt = 0; tt < PATTERN_GEMM_TILE; tt++) {
+                    acc_re[tt] += wr[n] * block_re[n][tt] - wi[n] * block_im[n][tt];
+                    acc_im[tt] += wr[n] * block_im[n][tt] + wi[n] * block_re[n][tt];
+                }
+            }
+
+            for (int tt = 0; tt < width; tt++) {
+                out[2 * tt] = acc_re[tt];
+                out[2 * tt + 1] = acc_im[tt];
+            }
+        }
+    }
+}
+
+// Multi-beam product for one instruction set, P[b][t] = sum_n W[b][n] * exp(j * n * u_t)
+#define DEFINE_PATTERN_GEMM(SUFFIX, TARGET)                                                      \
+TARGET static void pattern_gemm_##SUFFIX(const double* weights_re, const double* weights_im,     \
+                                         int n_sets, int n_elements, const double* u,            \
+                                         int n_theta, double complex* patterns_out) {            \
+    _Pragma("omp parallel for schedule(dynamic) if((int64_t)n_sets * n_elements * n_theta > 1000000)") \
+    for (int t0 = 0; t0 < n_theta; t0 += PATTERN_GEMM_TILE) {                                    \
+        pattern_gemm_tile(weights_re, weights_im, n_sets, n_elements, u, n_theta, t0, patterns_out); \
+    }                                                                                            \
+}
+
+// The baseline build already vectorizes the tile loops, so the portable
+// and generic entries share it
+DEFINE_PATTERN_GEMM(scalar, )
+
+/**
+ * Planar pattern for arbitrary element positions, portable version
+ * 
+ * Every element/direction pair needs its own phase x*du + y*dv, so grid
+ * points are blocked in tiles of PLANAR_TILE and elements in blocks of
+ * PLANAR_ELEMENT_BLOCK, keeping the accumulators and the element block in
+ * cache while each tile is swept.
+ */
+static void planar_positions_scalar(const double* x, const double* y, const double* weights_re,
+                                    const double* weights_im, int n_elements, const double* du,
+                                    const double* dv, int n_points, double complex* pattern_out) {
+    const int n_tiles = (n_points + PLANAR_TILE - 1) / PLANAR_TILE;
+
+    #pragma omp parallel for schedule(dynamic) if(n_tiles > 1)
+    for (int tile = 0; tile < n_tiles; tile++) {
+        const int p0 = tile * PLANAR_TILE;
+        const int width = n_points - p0 < PLANAR_TILE ? n_points - p0 : PLANAR_TILE;
+        double acc_re[PLANAR_TILE] = {0};
+        double acc_im[PLANAR_TILE] = {0};
+
+        for (int e0 = 0; e0 < n_elements; e0 += PLANAR_ELEMENT_BLOCK) {
+            const int e1 = e0 + PLANAR_ELEMENT_BLOCK < n_elements ? e0 + PLANAR_ELEMENT_BLOCK : n_elements;
+            for (int e = e0; e < e1; e++) {
+                for (int p = 0; p < width; p++) {
+                    const double phase = x[e] * du[p0 + p] + y[e] * dv[p0 + p];
+                    const double c = cos(phase);
+                    const double s = sin(phase);
+                    acc_re[p] += weights_re[e] * c - weights_im[e] * s;
+                    acc_im[p] += weights_re[e] * s + weights_im[e] * c;
+                }
+            }
+        }
+
+        for (int p = 0; p < width; p++) {
+            pattern_out[p0 + p] = CMPLX(acc_re[p], acc_im[p]);
+        }
+    }
+}
+
+#if defined(__GNUC__)
+
+// Vector kernels evaluate one register's worth of angles side by side.
+// They are written once with GCC vector extensions and instantiated per
+// instruction set at its native width: 2/4/8 doubles or 4/8/16 floats
+// for generic (SSE2 or NEON), AVX2 and AVX-512.
+typedef double v2df __attribute__((vector_size(16)));
+typedef int64_t v2di __attribute__((vector_size(16)));
+typedef double v4df __attribute__((vector_size(32)));
+typedef int64_t v4di __attribute__((vector_size(32)));
+typedef double v8df __attribute__((vector_size(64)));
+typedef int64_t v8di __attribute__((vector_size(64)));
+typedef double v16df __attribute__((vector_size(128)));
+typedef int64_t v16di __attribute__((vector_size(128)));
+typedef float v4sf __attribute__((vector_size(16)));
+typedef float v8sf __attribute__((vector_size(32)));
+typedef float v16sf __attribute__((vector_size(64)));
+
+// Cody-Waite pi/2 split and Cephes minimax coefficients on [-pi/4, pi/4]
+#define SINCOS_PIO2_1 1.57079625129699707031e+00
+#define SINCOS_PIO2_2 7.54978941586159635335e-08
+#define SINCOS_PIO2_3 5.39030285815811905290e-15
+#define SINCOS_ROUND_MAGIC 6755399441055744.0  // 1.5 * 2^52, rounds to an integer in the low bits
+
+/**
+ * Vector sine and cosine in full double precision
+ *
+ * The quadrant comes from the low bits of q = x * 2/pi rounded with the
+ * magic-number trick. SINCOS_PIO2_1 has 23 significant bits, so
+ * q * SINCOS_PIO2_1 is exact and the reduction keeps full precision for
+ * |q| < 2^30, i.e. |x| < 2^29 * pi (about 1.7e9). Past that the error grows
+ * with |x|, to about 2e-7 at 2^30 * pi, unless the compiler contracts the
+ * products into FMAs. The kernels' phases are at most
+ * 4 * pi * n_elements * spacing_wavelength, far inside the bound.
+ */
+#define DEFINE_VECTOR_SINCOS(NAME, VTYPE, ITYPE)                                              \
+KERNEL_INLINE void NAME(const VTYPE* x_in, VTYPE* sin_out, VTYPE* cos_out) {                   \
+    const VTYPE x = *x_in;                                                                    \
+    const VTYPE shifted = x * M_2_PI + SINCOS_ROUND_MAGIC;                                    \
+    const VTYPE q = shifted - SINCOS_ROUND_MAGIC;                                             \
+    const ITYPE quadrant = (ITYPE)shifted;                                                    \
+    VTYPE r = x - q * SINCOS_PIO2_1;                                                          \
+    r = r - q * SINCOS_PIO2_2;                                                                \
+    r = r - q * SINCOS_PIO2_3;                                                                \
+                                                                                              \
+    const VTYPE r2 = r * r;                                                                   \
+    const VTYPE sin_r = r + r * r2 * (-1.66666666666666307295e-1 + r2 * (8.33333333332211858878e-3 \
+        + r2 * (-1.98412698295895385996e-4 + r2 * (2.75573136213857245213e-6                  \
+        + r2 * (-2.50507477628578072866e-8 + r2 * 1.58962301576546568060e-10)))));           \
+    const VTYPE cos_r = 1.0 - 0.5 * r2 + r2 * r2 * (4.16666666666665929218e-2                 \
+        + r2 * (-1.38888888888730564116e-3 + r2 * (2.48015872888517045348e-5                  \
+        + r2 * (-2.75573141792967388112e-7 + r2 * (2.08757008419747316778e-9                  \
+        + r2 * -1.13585365213876817300e-11)))));                                              \
+                                                                                              \
+    /* Odd quadrants swap sin and cos; quadrants 2-3 (sin) and 1-2 (cos) negate */            \
+    const ITYPE swap = -(quadrant & 1);                                                       \
+    const ITYPE sin_sign = (quadrant & 2) << 62;                                              \
+    const ITYPE cos_sign = ((quadrant + 1) & 2) << 62;                                        \
+    const ITYPE s = ((ITYPE)cos_r & swap) | ((ITYPE)sin_r & ~swap);                           \
+    const ITYPE c = ((ITYPE)sin_r & swap) | ((ITYPE)cos_r & ~swap);                           \
+    *sin_out = (VTYPE)(s ^ sin_sign);                                                         \
+    *cos_out = (VTYPE)(c ^ cos_sign);                                                         \
+}
+
+DEFINE_VECTOR_SINCOS(sincos_v2df, v2df, v2di)
+DEFINE_VECTOR_SINCOS(sincos_v4df, v4df, v4di)
+DEFINE_VECTOR_SINCOS(sincos_v8df, v8df, v8di)
+DEFINE_VECTOR_SINCOS(sincos_v16df, v16df, v16di)
+
+/**
+ * Evaluate one vector of angles starting at t0 in double precision
+ */
+#define DEFINE_PATTERN_BLOCK_F64(NAME, VD, SINCOS)                                                \
+KERNEL_INLINE void NAME(const double* weights_re, const double* weights_im, int n_elements,      \
+                        const double* psi, int n_theta, int t0, double complex* pattern_out) {   \
+    enum { LANES = sizeof(VD) / sizeof(double) };                                                \
+    const int lanes = n_theta - t0 < LANES ? n_theta - t0 : LANES;                               \
+    VD vpsi = {0};                                                                               \
+    for (int l = 0; l < lanes; l++) vpsi[l] = psi[t0 + l];                                       \
+                                                                                                 \
+    VD step_re, step_im;                                                                         \
+    SINCOS(&vpsi, &step_im, &step_re);                                                           \
+    VD sum_re = {0};                                                                             \
+    VD sum_im = {0};                                                                             \
+                                                                                                 \
+    for (int base = 0; base < n_elements; base += PHASOR_RESYNC) {                               \
+        const int end = base + PHASOR_RESYNC < n_elements ? base + PHASOR_RESYNC : n_elements;   \
+        const VD phase = vpsi * (double)base;                                                    \
+        VD z_re, z_im;                                                                           \
+        SINCOS(&phase, &z_im, &z_re);                                                            \
+                                                                                                 \
+        for (int n = base; n < end; n++) {                                                       \
+            sum_re += weights_re[n] * z_re - weights_im[n] * z_im;                               \
+            sum_im += weights_re[n] * z_im + weights_im[n] * z_re;                               \
+                                                                                                 \
+            const VD next_re = z_re * step_re - z_im * step_im;                                  \
+            z_im = z_re * step_im + z_im * step_re;                                              \
+            z_re = next_re;                                                                      \
+        }                                                                                        \
+    }                                                                                            \
+                                                                                                 \
+    double* out = (double*)(pattern_out + t0);                                                   \
+    for (int l = 0; l < lanes; l++) {                                                            \
+        out[2 * l] = sum_re[l];                                                                  \
+        out[2 * l + 1] = sum_im[l];                                                              \
+    }                                                                                            \
+}
+
+/**
+ * Evaluate one vector of angles starting at t0 in single precision
+ *
+ * Phasor restarts are computed in double (VD, same lane count as VF) and
+ * rounded, so large phases keep their accuracy; only the recurrence and
+ * the sums run in float.
+ */
+#define DEFINE_PATTERN_BLOCK_F32(NAME, VF, VD, SINCOS)                                            \
+KERNEL_INLINE void NAME(const float* weights_re, const float* weights_im, int n_elements,        \
+                        const double* psi, int n_theta, int t0, float complex* pattern_out) {    \
+    enum { LANES = sizeof(VF) / sizeof(float) };                                                 \
+    const int lanes = n_theta - t0 < LANES ? n_theta - t0 : LANES;                               \
+    VD vpsi = {0};                                                                               \
+    for (int l = 0; l < lanes; l++) vpsi[l] = psi[t0 + l];                                       \
+                                                                                                 \
+    VD step_re_d, step_im_d;                                                                     \
+    SINCOS(&vpsi, &step_im_d, &step_re_d);                                                       \
+    const VF step_re = __builtin_convertvector(step_re_d, VF);                                   \
+    const VF step_im = __builtin_convertvector(step_im_d, VF);                                   \
+    VF sum_re = {0};                                                                             \
+    VF sum_im = {0};                                                                             \
+                                                                                                 \
+    for (int base = 0; base < n_elements; base += PHASOR_RESYNC_F32) {                           \
+        const int end = base + PHASOR_RESYNC_F32 < n_elements ? base + PHASOR_RESYNC_F32 : n_elements; \
+        const VD phase = vpsi * (double)base;                                                    \
+        VD z_re_d, z_im_d;                                                                       \
+        SINCOS(&phase, &z_im_d, &z_re_d);                                                        \
+        VF z_re = __builtin_convertvector(z_re_d, VF);                                           \
+        VF z_im = __builtin_convertvector(z_im_d, VF);                                           \
+                                                                                                 \
+        for (int n = base; n < end; n++) {                                                       \
+            sum_re += weights_re[n] * z_re - weights_im[n] * z_im;                               \
+            sum_im += weights_re[n] * z_im + weights_im[n] * z_re;                               \
+                                                                                                 \
+            const VF next_re = z_re * step_re - z_im * step_im;                                  \
+            z_im = z_re * step_im + z_im * step_re;                                              \
+            z_re = next_re;                                                                      \
+        }                                                                                        \
+    }                                                                                            \
+                                                                                                 \
+    float* out = (float*)(pattern_out + t0);                                                     \
+    for (int l = 0; l < lanes; l++) {                                                            \
+        out[2 * l] = sum_re[l];                                                                  \
+        out[2 * l + 1] = sum_im[l];                                                              \
+    }                                                                                            \
+}
+
+// One double and one float kernel per instruction set. The parallel loop
+// lives in the target function itself so OpenMP's outlined body is
+// compiled for the same instruction set.
+#define DEFINE_PATTERN_KERNELS(SUFFIX, TARGET, VD, SINCOS, VF, VFD, SINCOS_F32)                 \
+DEFINE_PATTERN_BLOCK_F64(pattern_block_##SUFFIX, VD, SINCOS)                                     \
+DEFINE_PATTERN_BLOCK_F32(pattern_block_f32_##SUFFIX, VF, VFD, SINCOS_F32)                        \
+TARGET static void pattern_kernel_##SUFFIX(const double* weights_re, const double* weights_im,   \
+                                           int n_elements, const double* psi, int n_theta,       \
+                                           double complex* pattern_out) {                        \
+    const int lanes = sizeof(VD) / sizeof(double);                                               \
+    _Pragma("omp parallel for if(n_theta > 1000)")                                               \
+    for (int t0 = 0; t0 < n_theta; t0 += lanes) {                                                \
+        pattern_block_##SUFFIX(weights_re, weights_im, n_elements, psi, n_theta, t0, pattern_out); \
+    }                                                                                            \
+}                                                                                                \
+TARGET static void pattern_kernel_f32_##SUFFIX(const float* weights_re, const float* weights_im, \
+                                               int n_elements, const double* psi, int n_theta,   \
+                                               float complex* pattern_out) {                     \
+    const int lanes = sizeof(VF) / sizeof(float);                                                \
+    _Pragma("omp parallel for if(n_theta > 1000)")                                               \
+    for (int t0 = 0; t0 < n_theta; t0 += lanes) {                                                \
+        pattern_block_f32_##SUFFIX(weights_re, weights_im, n_elements, psi, n_theta, t0, pattern_out); \
+    }                                                                                            \
+}                                                                                                \
+TARGET static void planar_positions_##SUFFIX(const double* x, const double* y,                   \
+                                             const double* weights_re, const double* weights_im, \
+                                             int n_elements, const double* du, const double* dv, \
+                                             int n_points, double complex* pattern_out) {        \
+    const int lanes = sizeof(VD) / sizeof(double);                                               \
+    _Pragma("omp parallel for schedule(dynamic, 16) if(n_points > PLANAR_TILE)")                 \
+    for (int p0 = 0; p0 < n_points; p0 += lanes) {                                               \
+        const int width = n_points - p0 < lanes ? n_points - p0 : lanes;                         \
+        VD vdu = {0};                                                                            \
+        VD vdv = {0};                                                                            \
+        for (int l = 0; l < width; l++) {                                                        \
+            vdu[l] = du[p0 + l];                                                                 \
+            vdv[l] = dv[p0 + l];                                                                 \
+        }                                                                                        \
+        VD acc_re = {0};                                                                         \
+        VD acc_im = {0};                                                                         \
+        for (int e = 0; e < n_elements; e++) {                                                   \
+            const VD phase = x[e] * vdu + y[e] * vdv;                                            \
+            VD s, c;                                                                             \
+            SINCOS(&phase, &s, &c);                                                              \
+            acc_re += weights_re[e] * c - weights_im[e] * s;                                     \
+            acc_im += weights_re[e] * s + weights_im[e] * c;                                     \
+        }                                                                                        \
+        double* out = (double*)(pattern_out + p0);                                               \
+        for (int l = 0; l < width; l++) {                                                        \
+            out[2 * l] = acc_re[l];                                                              \
+            out[2 * l + 1] = acc_im[l];                                                          \
+        }                                                                                        \
+    }                                                                                            \
+}
+
+DEFINE_PATTERN_KERNELS(generic, , v2df, sincos_v2df, v4sf, v4df, sincos_v4df)
+#if defined(__x86_64__) || defined(__i386__)
+DEFINE_PATTERN_KERNELS(avx2, __attribute__((target("avx2,fma"))), v4df, sincos_v4df, v8sf, v8df, sincos_v8df)
+DEFINE_PATTERN_KERNELS(avx512, __attribute__((target("avx512f"))), v8df, sincos_v8df, v16sf, v16df, sincos_v16df)
+DEFINE_PATTERN_GEMM(avx2, __attribute__((target("avx2,fma"))))
+DEFINE_PATTERN_GEMM(avx512, __attribute__((target("avx512f"))))
+#endif
+
+#endif
+
+// Kernels in order of preference
+typedef struct {
+    const char* name;
+    PatternKernel kernel;
+    PatternKernelF32 kernel_f32;
+    PatternGemm gemm;
+    PlanarPositionsKernel planar_positions;
+} PatternKernelInfo;
+
+static const PatternKernelInfo pattern_kernels[] = {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    {"avx512", pattern_kernel_avx512, pattern_kernel_f32_avx512, pattern_gemm_avx512,
+     planar_positions_avx512},
+    {"avx2", pattern_kernel_avx2, pattern_kernel_f32_avx2, pattern_gemm_avx2,
+     planar_positions_avx2},
+#endif
+#if defined(__GNUC__)
+    {"generic", pattern_kernel_generic, pattern_kernel_f32_generic, pattern_gemm_scalar,
+     planar_positions_generic},
+#endif
+    {"scalar", pattern_kernel_scalar, pattern_kernel_f32_scalar, pattern_gemm_scalar,
+     planar_positions_scalar}
+};
+
+#define NUM_PATTERN_KERNELS (sizeof(pattern_kernels) / sizeof(pattern_kernels[0]))
+
+static const PatternKernelInfo* active_pattern_kernel = &pattern_kernels[NUM_PATTERN_KERNELS - 1];
+
+// Check whether this CPU can run a kernel
+static bool pattern_kernel_supported(const PatternKernelInfo* info) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    if (info->kernel == pattern_kernel_avx512) return __builtin_cpu_supports("avx512f");
+    if (info->kernel == pattern_kernel_avx2) return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+    (void)info;
+    return true;
+}
+
+// Pick the best kernel for this CPU, once at load
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void select_pattern_kernel(void) {
+    for (size_t i = 0; i < NUM_PATTERN_KERNELS; i++) {
+        if (pattern_kernel_supported(&pattern_kernels[i])) {
+            active_pattern_kernel = &pattern_kernels[i];
+            return;
+        }
+    }
+}
+
+/**
+ * Get the name of the array factor kernel in use
+ * 
+ * @return "avx512", "avx2", "generic" or "scalar"
+ */
+EXPORT const char* get_pattern_kernel(void) {
+    return active_pattern_kernel->name;
+}
+
+/**
+ * Force the array factor kernel, mainly for benchmarks and tests
+ * 
+ * @param name Kernel name as returned by get_pattern_kernel(), or NULL for the best one
+ * @return 0 on success, -1 if the kernel is unknown or unsupported on this CPU
+ */
+EXPORT int set_pattern_kernel(const char* name) {
+    if (!name) {
+        select_pattern_kernel();
+        return 0;
+    }
+
+    for (size_t i = 0; i < NUM_PATTERN_KERNELS; i++) {
+        if (strcmp(pattern_kernels[i].name, name) == 0 && pattern_kernel_supported(&pattern_kernels[i])) {
+            active_pattern_kernel = &pattern_kernels[i];
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Enable or disable the hot-path counters
+ * 
+ * Stats are off by default; toggle them before calling from other
+ * threads. Counts already made are kept.
+ * 
+ * @param enabled true to count
+ * @return 0 on success, -1 if the library was built with PATTERN_STATS=0
+ */
+EXPORT int set_stats_enabled(bool enabled) {
+#if PATTERN_STATS
+    if (enabled && ns_per_cycle == 0.0) {
+        calibrate_cycle_counter();
+    }
+    stats_enabled = enabled;
+    return 0;
+#else
+    return enabled ? -1 : 0;
+#endif
+}
+
+/**
+ * Check whether the hot-path counters are enabled
+ */
+EXPORT bool get_stats_enabled(void) {
+#if PATTERN_STATS
+    return stats_enabled;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Sum the hot-path counters of every thread
+ * 
+ * Safe to call while other threads count; the result is then a snapshot
+ * that may include part of a call in flight.
+ * 
+ * @param stats_out Output totals
+ * @return 0 on success, -1 on error
+ */
+EXPORT int get_stats(PatternStats* stats_out) {
+    if (!stats_out) return -1;
+
+    uint64_t totals[STAT_COUNT] = {0};
+    memset(stats_out, 0, sizeof(*stats_out));
+#if PATTERN_STATS
+    const uint64_t claimed = atomic_load_explicit(&stats_threads_claimed, memory_order_relaxed);
+    const uint64_t slots = claimed < STATS_MAX_THREADS ? claimed : STATS_MAX_THREADS;
+    for (uint64_t t = 0; t < slots; t++) {
+        for (int c = 0; c < STAT_COUNT; c++) {
+            totals[c] += atomic_load_explicit(&stats_slots[t].counters[c], memory_order_relaxed);
+        }
+    }
+    stats_out->threads = (uint32_t)claimed;
+    stats_out->ns_per_cycle = ns_per_cycle;
+#endif
+
+    stats_out->calls = totals[STAT_CALLS];
+    stats_out->evaluations = totals[STAT_EVALUATIONS];
+    stats_out->rng_draws = totals[STAT_RNG_DRAWS];
+    stats_out->allocations = totals[STAT_ALLOCATIONS];
+    stats_out->allocated_bytes = totals[STAT_ALLOCATED_BYTES];
+    stats_out->setup_cycles = totals[STAT_SETUP_CYCLES];
+    stats_out->kernel_cycles = totals[STAT_KERNEL_CYCLES];
+    stats_out->noise_cycles = totals[STAT_NOISE_CYCLES];
+    return 0;
+}
+
+/**
+ * Zero the hot-path counters of every thread
+ * 
+ * Counts made by calls running concurrently with the reset may survive it.
+ */
+EXPORT void reset_stats(void) {
+#if PATTERN_STATS
+    for (int t = 0; t < STATS_MAX_THREADS; t++) {
+        for (int c = 0; c < STAT_COUNT; c++) {
+            atomic_store_explicit(&stats_slots[t].counters[c], 0, memory_order_relaxed);
+        }
+    }
+#endif
+}
+
+/**
+ * Complex element weights a_n * exp(j * (phase_n - n * steering_step)),
+ * with phase errors drawn from the streams of one RNG key
+ * 
+ * @param steering_step Progressive phase in radians folded into the
+ *        weights (0 when the kernels apply steering through psi)
+ * @param key Stream key from rng_epoch_key(), unused without phase errors
+ */
+static void fill_element_weights_keyed(
+    int n_elements,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std,
+    double steering_step,
+    uint64_t key,
+    double* weights_re,
+    double* weights_im
+) {
+    for (int i = 0; i < n_elements; i += 2) {
+        // Elements 2k and 2k+1 share Box-Muller pair k
+        double errors[2] = {0, 0};
+        if (phase_error_std > 0) {
+            randn_pair(key, (uint64_t)i / 2, &errors[0], &errors[1]);
+        }
+
+        for (int j = i; j < i + 2 && j < n_elements; j++) {
+            const double phase_error = phase_error_std * errors[j - i];
+            const double total_phase = (phase_weights[j] + phase_error) * M_PI / 180.0 - j * steering_step;
+            weights_re[j] = amplitude_weights[j] * cos(total_phase);
+            weights_im[j] = amplitude_weights[j] * sin(total_phase);
+        }
+    }
+}
+
+// Element weights with fresh random phase errors (one RNG epoch per call)
+static void fill_element_weights(
+    int n_elements,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std,
+    double steering_step,
+    double* weights_re,
+    double* weights_im
+) {
+    const uint64_t key = phase_error_std > 0 ? rng_begin_call() : 0;
+    if (phase_error_std > 0) stats_add(STAT_RNG_DRAWS, ((uint64_t)n_elements + 1) / 2);
+    fill_element_weights_keyed(n_elements, amplitude_weights, phase_weights, phase_error_std, steering_step,
+                               key, weights_re, weights_im);
+}
+
+/**
+ * Prepare the kernel inputs shared by both precisions
+ * 
+ * Draws the per-call phase errors and returns one buffer holding the
+ * complex weights (n_elements real parts, then imaginary parts) followed
+ * by the n_theta phase steps.
+ * 
+ * @return Buffer to free(), or NULL on allocation failure
+ */
+static double* prepare_pattern_inputs(
+    int n_elements,
+    double spacing_wavelength,
+    double steering_angle,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std,
+    const double* theta_deg,
+    int n_theta
+) {
+    // Constants
+    const double k = 2.0 * M_PI;  // Wavenumber (normalized to wavelength)
+    const double d = spacing_wavelength;
+
+    const size_t size = (2 * (size_t)n_elements + (size_t)n_theta) * sizeof(double) + 1;
+    double* buffer = (double*)malloc(size);
+    if (!buffer) return NULL;
+    stats_allocation(size);
+    double* weights_re = buffer;
+    double* weights_im = buffer + n_elements;
+    double* psi = buffer + 2 * (size_t)n_elements;
+
+    fill_element_weights(n_elements, amplitude_weights, phase_weights, phase_error_std, 0,
+                         weights_re, weights_im);
+
+    // Convert steering angle to radians
+    const double steering_rad = steering_angle * M_PI / 180.0;
+    const double sin_steering = sin(steering_rad);
 
-    return mean + std_dev * z;
+    // Phase step between neighbouring elements for each angle
+    for (int t = 0; t < n_theta; t++) {
+        const double theta_rad = theta_deg[t] * M_PI / 180.0;
+        psi[t] = k * d * (sin(theta_rad) - sin_steering);
+    }
+
+    return buffer;
 }
 
 /**
@@ -86,74 +941,1567 @@ EXPORT int calculate_pattern(
     int n_theta,
     double complex* pattern_out
 ) {
-    // Constants
-    const double k = 2.0 * M_PI;  // Wavenumber (normalized to wavelength)
-    const double d = spacing_wavelength;
-
-    // Pre-calculate total phases in radians, including fresh random errors
-    double* total_phases = (double*)malloc(n_elements * sizeof(double));
-    if (!total_phases) return -1;
+    uint64_t phase = stats_start();
+    double* inputs = prepare_pattern_inputs(n_elements, spacing_wavelength, steering_angle,
+                                            amplitude_weights, phase_weights, phase_error_std,
+                                            theta_deg, n_theta);
+    if (!inputs) return -1;
+    phase = stats_phase(phase, STAT_SETUP_CYCLES);
 
-    for (int i = 0; i < n_elements; i++) {
-        double phase_error = phase_error_std > 0 ? randn(0, phase_error_std) : 0;
-        total_phases[i] = (phase_weights[i] + phase_error) * M_PI / 180.0;
-    }
-
-    // Convert steering angle to radians
-    const double steering_rad = steering_angle * M_PI / 180.0;
-    const double sin_steering = sin(steering_rad);
-
-    // Calculate pattern for each angle
-    #pragma omp parallel for if(n_theta > 1000)
-    for (int t = 0; t < n_theta; t++) {
-        const double theta_rad = theta_deg[t] * M_PI / 180.0;
-        const double sin_theta = sin(theta_rad);
-        double complex sum = 0;
-
-        // Calculate contribution from each element
-        for (int n = 0; n < n_elements; n++) {
-            const double position = n * d;
-            const double phase = k * position * (sin_theta - sin_steering) + total_phases[n];
-            sum += amplitude_weights[n] * (cos(phase) + I * sin(phase));
-        }
-
-        pattern_out[t] = sum;
-    }
+    active_pattern_kernel->kernel(inputs, inputs + n_elements, n_elements,
+                                  inputs + 2 * (size_t)n_elements, n_theta, pattern_out);
+    stats_phase(phase, STAT_KERNEL_CYCLES);
+    stats_add(STAT_CALLS, 1);
+    stats_add(STAT_EVALUATIONS, (uint64_t)n_elements * (uint64_t)n_theta);
 
-    free(total_phases);
+    free(inputs);
     return 0;
 }
 
 /**
- * Add Additive White Gaussian Noise (AWGN) to a signal
+ * Calculate radiation pattern in single precision, for fast previews
  * 
- * @param signal Complex signal array
- * @param n_samples Number of samples
+ * Same parameters as calculate_pattern; the weights and the element
+ * recurrence use float, so expect relative errors around 1e-5.
+ * 
+ * @param pattern_out Output array for pattern (length n_theta)
+ * @return 0 on success, -1 on error
+ */
+EXPORT int calculate_pattern_f32(
+    int n_elements,
+    double spacing_wavelength,
+    double steering_angle,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std,
+    const double* theta_deg,
+    int n_theta,
+    float complex* pattern_out
+) {
+    uint64_t phase = stats_start();
+    double* inputs = prepare_pattern_inputs(n_elements, spacing_wavelength, steering_angle,
+                                            amplitude_weights, phase_weights, phase_error_std,
+                                            theta_deg, n_theta);
+    if (!inputs) return -1;
+
+    const size_t size = 2 * (size_t)n_elements * sizeof(float) + 1;
+    float* weights = (float*)malloc(size);
+    if (!weights) {
+        free(inputs);
+        return -1;
+    }
+    stats_allocation(size);
+    for (size_t i = 0; i < 2 * (size_t)n_elements; i++) {
+        weights[i] = (float)inputs[i];
+    }
+    phase = stats_phase(phase, STAT_SETUP_CYCLES);
+
+    active_pattern_kernel->kernel_f32(weights, weights + n_elements, n_elements,
+                                      inputs + 2 * (size_t)n_elements, n_theta, pattern_out);
+    stats_phase(phase, STAT_KERNEL_CYCLES);
+    stats_add(STAT_CALLS, 1);
+    stats_add(STAT_EVALUATIONS, (uint64_t)n_elements * (uint64_t)n_theta);
+
+    free(weights);
+    free(inputs);
+    return 0;
+}
+
+/**
+ * Run the multi-beam kernel on prepared weight sets
+ * 
+ * @param phase Stats phase opened by the caller before preparing the weights
+ * @param weights Buffer from the callers: n_sets * n_elements real parts,
+ *        then the same number of imaginary parts; freed here
+ * @return 0 on success, -1 on allocation failure
+ */
+static int evaluate_weight_matrix(
+    uint64_t phase,
+    double* weights,
+    int n_sets,
+    int n_elements,
+    double spacing_wavelength,
+    const double* theta_deg,
+    int n_theta,
+    double complex* patterns_out
+) {
+    const double kd = 2.0 * M_PI * spacing_wavelength;
+
+    const size_t size = (size_t)n_theta * sizeof(double) + 1;
+    double* u = (double*)malloc(size);
+    if (!u) {
+        free(weights);
+        return -1;
+    }
+    stats_allocation(size);
+    // sin(theta) is shared by every beam
+    for (int t = 0; t < n_theta; t++) {
+        u[t] = kd * sin(theta_deg[t] * M_PI / 180.0);
+    }
+    phase = stats_phase(phase, STAT_SETUP_CYCLES);
+
+    active_pattern_kernel->gemm(weights, weights + (size_t)n_sets * n_elements, n_sets, n_elements,
+                                u, n_theta, patterns_out);
+    stats_phase(phase, STAT_KERNEL_CYCLES);
+    stats_add(STAT_CALLS, 1);
+    stats_add(STAT_EVALUATIONS, (uint64_t)n_sets * (uint64_t)n_elements * (uint64_t)n_theta);
+
+    free(u);
+    free(weights);
+    return 0;
+}
+
+/**
+ * Calculate patterns for many steering angles in one call
+ * 
+ * Equivalent to calling calculate_pattern once per steering angle, including
+ * one fresh draw of phase errors per beam in the same RNG order, but the
+ * angle grid is evaluated once and all beams share each steering block.
+ * 
+ * @param steering_angles Steering angles in degrees (length n_beams)
+ * @param n_beams Number of beams
+ * @param patterns_out Output matrix, row-major n_beams x n_theta
+ * @return 0 on success, -1 on error
+ */
+EXPORT int calculate_pattern_multibeam(
+    int n_elements,
+    double spacing_wavelength,
+    const double* steering_angles,
+    int n_beams,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std,
+    const double* theta_deg,
+    int n_theta,
+    double complex* patterns_out
+) {
+    if (n_elements <= 0 || n_beams <= 0 || n_theta < 0) return -1;
+
+    const uint64_t phase = stats_start();
+    const double kd = 2.0 * M_PI * spacing_wavelength;
+    const size_t n_weights = (size_t)n_beams * n_elements;
+    double* weights = (double*)malloc(2 * n_weights * sizeof(double));
+    if (!weights) return -1;
+    stats_allocation(2 * n_weights * sizeof(double));
+
+    for (int b = 0; b < n_beams; b++) {
+        const double steering_step = kd * sin(steering_angles[b] * M_PI / 180.0);
+        fill_element_weights(n_elements, amplitude_weights, phase_weights, phase_error_std, steering_step,
+                             weights + (size_t)b * n_elements, weights + n_weights + (size_t)b * n_elements);
+    }
+
+    return evaluate_weight_matrix(phase, weights, n_beams, n_elements, spacing_wavelength, theta_deg, n_theta,
+                                  patterns_out);
+}
+
+/**
+ * Calculate patterns for many weight sets in one call
+ * 
+ * Each row of the weight matrices is one set of element weights; the result
+ * matches one calculate_pattern call per row, phase error draws included.
+ * 
+ * @param amplitude_sets Amplitude weights, row-major n_sets x n_elements
+ * @param phase_sets Phase weights in degrees, row-major n_sets x n_elements
+ * @param n_sets Number of weight sets
+ * @param patterns_out Output matrix, row-major n_sets x n_theta
+ * @return 0 on success, -1 on error
+ */
+EXPORT int calculate_pattern_weight_sets(
+    int n_elements,
+    double spacing_wavelength,
+    double steering_angle,
+    const double* amplitude_sets,
+    const double* phase_sets,
+    int n_sets,
+    double phase_error_std,
+    const double* theta_deg,
+    int n_theta,
+    double complex* patterns_out
+) {
+    if (n_elements <= 0 || n_sets <= 0 || n_theta < 0) return -1;
+
+    const uint64_t phase = stats_start();
+    const double steering_step = 2.0 * M_PI * spacing_wavelength * sin(steering_angle * M_PI / 180.0);
+    const size_t n_weights = (size_t)n_sets * n_elements;
+    double* weights = (double*)malloc(2 * n_weights * sizeof(double));
+    if (!weights) return -1;
+    stats_allocation(2 * n_weights * sizeof(double));
+
+    for (int b = 0; b < n_sets; b++) {
+        const size_t row = (size_t)b * n_elements;
+        fill_element_weights(n_elements, amplitude_sets + row, phase_sets + row, phase_error_std, steering_step,
+                             weights + row, weights + n_weights + row);
+    }
+
+    return evaluate_weight_matrix(phase, weights, n_sets, n_elements, spacing_wavelength, theta_deg, n_theta,
+                                  patterns_out);
+}
+
+/**
+ * Fill the twiddle factors used by fft_radix2
+ * 
+ * Level len (2, 4, ..., size) stores exp(+j * 2*pi * k / len) for
+ * k < len / 2 contiguously, starting at offset len / 2 - 1, for size - 1
+ * entries in total. Only the first octant of the largest level calls
+ * cos/sin; the rest follows by symmetry.
+ * 
+ * @param twiddles Output table (length size - 1)
+ * @param size Transform length, a power of two >= 8
+ */
+static void fft_fill_twiddles(double complex* twiddles, size_t size) {
+    double complex* top = twiddles + size / 2 - 1;
+    const size_t quarter = size / 4;
+    for (size_t i = 0; i <= size / 8; i++) {
+        const double angle = 2.0 * M_PI * (double)i / (double)size;
+        const double c = cos(angle);
+        const double s = sin(angle);
+        top[i] = CMPLX(c, s);
+        top[quarter - i] = CMPLX(s, c);
+        top[quarter + i] = CMPLX(-s, c);
+        if (i > 0) top[2 * quarter - i] = CMPLX(-c, s);
+    }
+
+    for (size_t len = size / 2; len >= 2; len >>= 1) {
+        const double complex* finer = twiddles + len - 1;
+        double complex* level = twiddles + len / 2 - 1;
+        for (size_t k = 0; k < len / 2; k++) {
+            level[k] = finer[2 * k];
+        }
+    }
+}
+
+/**
+ * In-place radix-2 FFT with a positive exponent
+ * 
+ * Computes X[m] = sum_n x[n] * exp(+j * 2*pi * n * m / size), which is the
+ * array factor's sign convention, without any 1/size scaling.
+ * 
+ * @param data Complex samples (length size)
+ * @param size Transform length, a power of two
+ * @param twiddles Table from fft_fill_twiddles()
+ */
+static void fft_radix2(double complex* data, size_t size, const double complex* twiddles) {
+    // Bit-reversal permutation
+    for (size_t i = 1, j = 0; i < size; i++) {
+        size_t bit = size >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j |= bit;
+        if (i < j) {
+            const double complex tmp = data[i];
+            data[i] = data[j];
+            data[j] = tmp;
+        }
+    }
+
+    // Butterflies, doubling the sub-transform length each pass
+    for (size_t len = 2; len <= size; len <<= 1) {
+        const size_t half = len >> 1;
+        const double complex* level = twiddles + half - 1;
+        for (size_t start = 0; start < size; start += len) {
+            double complex* lo = data + start;
+            double complex* hi = lo + half;
+            for (size_t k = 0; k < half; k++) {
+                // Spelled out: a plain complex multiply goes through __muldc3's NaN handling
+                const double t_re = creal(level[k]) * creal(hi[k]) - cimag(level[k]) * cimag(hi[k]);
+                const double t_im = creal(level[k]) * cimag(hi[k]) + cimag(level[k]) * creal(hi[k]);
+                const double complex t = CMPLX(t_re, t_im);
+                hi[k] = lo[k] - t;
+                lo[k] += t;
+            }
+        }
+    }
+}
+
+/**
+ * Calculate radiation pattern for a linear array via one FFT
+ * 
+ * For uniformly spaced elements the array factor is a trigonometric
+ * polynomial in psi = k * d * (sin(theta) - sin(steering)), so the weights
+ * are zero-padded to M >= oversample * n_elements points and transformed
+ * once, together with their derivative (weights times j*n). Each requested
+ * angle is then a cubic Hermite interpolation between the two nearest
+ * samples, for O(M log M + n_theta) work instead of O(n_elements * n_theta).
+ * 
+ * The interpolation error falls as oversample^-4; the default of 16 keeps
+ * it below about 1e-4 of the main lobe. Angles and phase errors are
+ * handled exactly as in calculate_pattern, including RNG consumption.
+ * 
+ * @param oversample Zero-padding factor (0 selects PATTERN_FFT_OVERSAMPLE)
+ * @param pattern_out Output array for pattern (length n_theta)
+ * @return 0 on success, -1 on error
+ */
+EXPORT int calculate_pattern_fft(
+    int n_elements,
+    double spacing_wavelength,
+    double steering_angle,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std,
+    const double* theta_deg,
+    int n_theta,
+    int oversample,
+    double complex* pattern_out
+) {
+    if (n_elements <= 0 || n_theta < 0 || oversample < 0) return -1;
+    if (oversample == 0) oversample = PATTERN_FFT_OVERSAMPLE;
+
+    size_t size = PATTERN_FFT_MIN_SIZE;
+    while (size < (size_t)oversample * (size_t)n_elements) {
+        size <<= 1;
+    }
+
+    double* inputs = prepare_pattern_inputs(n_elements, spacing_wavelength, steering_angle,
+                                            amplitude_weights, phase_weights, phase_error_std,
+                                            theta_deg, n_theta);
+    if (!inputs) return -1;
+    const double* weights_re = inputs;
+    const double* weights_im = inputs + n_elements;
+    const double* psi = inputs + 2 * (size_t)n_elements;
+
+    // Samples of the pattern, its derivative in psi, and the shared twiddles
+    double complex* samples = (double complex*)malloc((3 * size - 1) * sizeof(double complex));
+    if (!samples) {
+        free(inputs);
+        return -1;
+    }
+    double complex* slopes = samples + size;
+    double complex* twiddles = slopes + size;
+
+    fft_fill_twiddles(twiddles, size);
+
+    for (size_t n = 0; n < size; n++) {
+        if (n < (size_t)n_elements) {
+            samples[n] = weights_re[n] + I * weights_im[n];
+            slopes[n] = I * (double)n * samples[n];
+        } else {
+            samples[n] = 0;
+            slopes[n] = 0;
+        }
+    }
+
+    fft_radix2(samples, size, twiddles);
+    fft_radix2(slopes, size, twiddles);
+
+    // Sample m sits at psi = 2*pi*m/size; the pattern is 2*pi periodic in psi
+    const double step = 2.0 * M_PI / (double)size;
+    const double samples_per_radian = (double)size / (2.0 * M_PI);
+
+    #pragma omp parallel for if(n_theta > 1000)
+    for (int t = 0; t < n_theta; t++) {
+        const double x = psi[t] * samples_per_radian;
+        const double x_floor = floor(x);
+        const double s = x - x_floor;
+        const size_t m0 = (size_t)((int64_t)x_floor & (int64_t)(size - 1));
+        const size_t m1 = (m0 + 1) & (size - 1);
+
+        // Cubic Hermite basis
+        const double s2 = s * s;
+        const double s3 = s2 * s;
+        const double h00 = 2 * s3 - 3 * s2 + 1;
+        const double h10 = s3 - 2 * s2 + s;
+        const double h01 = -2 * s3 + 3 * s2;
+        const double h11 = s3 - s2;
+
+        pattern_out[t] = h00 * samples[m0] + h10 * step * slopes[m0]
+                       + h01 * samples[m1] + h11 * step * slopes[m1];
+    }
+
+    free(samples);
+    free(inputs);
+    return 0;
+}
+
+// Pattern metrics from adaptive refinement
+typedef struct {
+    double peak_angle_deg;       // Main lobe direction
+    double peak_power;           // |AF|^2 at the main lobe peak
+    double beamwidth_3db_deg;    // Half-power beamwidth (NaN if a side leaves the range)
+    double half_power_left_deg;
+    double half_power_right_deg;
+    double psll_db;              // Peak sidelobe level relative to the main lobe (-inf if none)
+    double psll_angle_deg;
+    int n_nulls;                 // Local minima found (may exceed the output capacity)
+    int n_maxima;                // Local maxima found, main lobe included
+    uint64_t evaluations;        // Array factor evaluations used
+} PatternMetrics;
+
+// Element weights and geometry for single-angle evaluations
+typedef struct {
+    const double* weights_re;
+    const double* weights_im;
+    int n_elements;
+    double kd;
+    double sin_steering;
+    uint64_t evaluations;
+} PatternProbe;
+
+/**
+ * Evaluate |AF|^2 and its derivative d|AF|^2/dtheta at one angle
+ * 
+ * dAF/dpsi = sum j n w_n exp(j n psi) comes from the same phasor
+ * recurrence as AF, and dpsi/dtheta = k d cos(theta).
+ */
+static double probe_power(PatternProbe* probe, double theta_rad, double* slope_out) {
+    const double psi = probe->kd * (sin(theta_rad) - probe->sin_steering);
+    const double step_re = cos(psi);
+    const double step_im = sin(psi);
+    double af_re = 0, af_im = 0;
+    double daf_re = 0, daf_im = 0;
+
+    for (int base = 0; base < probe->n_elements; base += PHASOR_RESYNC) {
+        const int end = base + PHASOR_RESYNC < probe->n_elements ? base + PHASOR_RESYNC : probe->n_elements;
+        double z_re = cos(base * psi);
+        double z_im = sin(base * psi);
+
+        for (int n = base; n < end; n++) {
+            const double t_re = probe->weights_re[n] * z_re - probe->weights_im[n] * z_im;
+            const double t_im = probe->weights_re[n] * z_im + probe->weights_im[n] * z_re;
+            af_re += t_re;
+            af_im += t_im;
+            // j * n * term
+            daf_re -= n * t_im;
+            daf_im += n * t_re;
+
+            const double next_re = z_re * step_re - z_im * step_im;
+            z_im = z_re * step_im + z_im * step_re;
+            z_re = next_re;
+        }
+    }
+
+    probe->evaluations++;
+    if (slope_out) {
+        // d|AF|^2/dpsi = 2 Re(conj(AF) * dAF/dpsi)
+        const double dpower_dpsi = 2.0 * (af_re * daf_re + af_im * daf_im);
+        *slope_out = dpower_dpsi * probe->kd * cos(theta_rad);
+    }
+    return af_re * af_re + af_im * af_im;
+}
+
+/**
+ * Find a root of f(theta) in [a, b] with the Illinois variant of regula falsi
+ * 
+ * @param use_slope Root of d|AF|^2/dtheta when true, of |AF|^2 - level otherwise
+ * @param fa, fb Function values at a and b, of opposite sign
+ */
+static double refine_root(PatternProbe* probe, bool use_slope, double level,
+                          double a, double b, double fa, double fb, double tolerance) {
+    int side = 0;
+    for (int iter = 0; iter < PATTERN_REFINE_MAX_ITER && fabs(b - a) > tolerance; iter++) {
+        double c = (a * fb - b * fa) / (fb - fa);
+        if (!(c > fmin(a, b) && c < fmax(a, b))) c = 0.5 * (a + b);
+
+        double slope;
+        const double power = probe_power(probe, c, &slope);
+        const double fc = use_slope ? slope : power - level;
+        if (fc == 0) return c;
+
+        if ((fc > 0) == (fb > 0)) {
+            b = c;
+            fb = fc;
+            if (side == -1) fa *= 0.5;
+            side = -1;
+        } else {
+            a = c;
+            fa = fc;
+            if (side == 1) fb *= 0.5;
+            side = 1;
+        }
+    }
+    return fabs(fa) < fabs(fb) ? a : b;
+}
+
+/**
+ * Measure main lobe, beamwidth, sidelobes and nulls adaptively
+ * 
+ * Samples theta coarsely, about four points per lobe (a step of
+ * pi / (2N) in psi), brackets every sign change of d|AF|^2/dtheta, and
+ * refines each bracket to the tolerance with the analytic derivative.
+ * The half-power points are refined the same way between the main peak
+ * and its neighbouring minima. Range endpoints count as maxima when the
+ * pattern rises towards them. Phase errors are drawn once, as in
+ * calculate_pattern.
+ * 
+ * @param theta_min_deg Start of the angular range in degrees
+ * @param theta_max_deg End of the angular range in degrees
+ * @param tolerance_deg Angular accuracy of refined extrema (<= 0 for 1e-6)
+ * @param null_angles_out Refined local minima in ascending order (may be NULL)
+ * @param max_nulls Capacity of null_angles_out
+ * @param metrics_out Output metrics
+ * @return 0 on success, -1 on error
+ */
+EXPORT int analyze_pattern(
+    int n_elements,
+    double spacing_wavelength,
+    double steering_angle,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std,
+    double theta_min_deg,
+    double theta_max_deg,
+    double tolerance_deg,
+    double* null_angles_out,
+    int max_nulls,
+    PatternMetrics* metrics_out
+) {
+    if (n_elements <= 0 || !metrics_out || !(theta_max_deg > theta_min_deg) || spacing_wavelength <= 0) return -1;
+    if (max_nulls < 0 || (max_nulls > 0 && !null_angles_out)) return -1;
+    if (tolerance_deg <= 0) tolerance_deg = 1e-6;
+
+    const double to_rad = M_PI / 180.0;
+    const double lo = theta_min_deg * to_rad;
+    const double hi = theta_max_deg * to_rad;
+    const double tolerance = tolerance_deg * to_rad;
+
+    uint64_t phase = stats_start();
+    double* weights = (double*)malloc(2 * (size_t)n_elements * sizeof(double));
+    if (!weights) return -1;
+    stats_allocation(2 * (size_t)n_elements * sizeof(double));
+    fill_element_weights(n_elements, amplitude_weights, phase_weights, phase_error_std, 0,
+                         weights, weights + n_elements);
+
+    PatternProbe probe = {
+        weights, weights + n_elements, n_elements,
+        2.0 * M_PI * spacing_wavelength, sin(steering_angle * to_rad), 0
+    };
+
+    // Coarse grid: psi changes by at most kd * dtheta, so this bounds the step in psi
+    const double step_target = M_PI / (2.0 * n_elements * probe.kd);
+    int n_coarse = (int)ceil((hi - lo) / step_target);
+    if (n_coarse < PATTERN_REFINE_MIN_COARSE) n_coarse = PATTERN_REFINE_MIN_COARSE;
+    const double step = (hi - lo) / n_coarse;
+
+    // Extrema in ascending angle; alternate maxima and minima for a smooth pattern
+    size_t capacity = 64, count = 0;
+    double* extrema = (double*)malloc(capacity * 3 * sizeof(double));  // angle, power, +1 max / -1 min
+    if (!extrema) {
+        free(weights);
+        return -1;
+    }
+    stats_allocation(capacity * 3 * sizeof(double));
+    phase = stats_phase(phase, STAT_SETUP_CYCLES);
+
+    double prev_theta = lo;
+    double prev_slope;
+    const double start_power = probe_power(&probe, lo, &prev_slope);
+    bool failed = false;
+
+    // Endpoint maximum when the pattern falls away from the start
+    if (prev_slope < 0) {
+        extrema[0] = lo;
+        extrema[1] = start_power;
+        extrema[2] = 1;
+        count = 1;
+    }
+
+    for (int i = 1; i <= n_coarse && !failed; i++) {
+        const double theta = i == n_coarse ? hi : lo + i * step;
+        double slope;
+        const double power = probe_power(&probe, theta, &slope);
+
+        const bool sign_change = (prev_slope > 0 && slope <= 0) || (prev_slope < 0 && slope >= 0);
+        const bool end_max = i == n_coarse && slope > 0;
+        const int new_items = (sign_change ? 1 : 0) + (end_max ? 1 : 0);
+        if (count + new_items > capacity) {
+            capacity *= 2;
+            double* grown = (double*)realloc(extrema, capacity * 3 * sizeof(double));
+            if (!grown) {
+                failed = true;
+                break;
+            }
+            extrema = grown;
+            stats_allocation(capacity * 3 * sizeof(double));
+        }
+
+        if (sign_change) {
+            const double root = slope == 0 ? theta
+                              : refine_root(&probe, true, 0, prev_theta, theta, prev_slope, slope, tolerance);
+            extrema[3 * count] = root;
+            extrema[3 * count + 1] = probe_power(&probe, root, NULL);
+            extrema[3 * count + 2] = prev_slope > 0 ? 1 : -1;
+            count++;
+        }
+        if (end_max) {
+            extrema[3 * count] = hi;
+            extrema[3 * count + 1] = power;
+            extrema[3 * count + 2] = 1;
+            count++;
+        }
+
+        prev_theta = theta;
+        // A slope of exactly zero at a sample was consumed as an extremum above
+        prev_slope = slope == 0 ? -prev_slope : slope;
+    }
+
+    if (failed) {
+        free(extrema);
+        free(weights);
+        return -1;
+    }
+
+    // Main lobe: strongest maximum, ties going to the one nearest the steering angle
+    int peak = -1;
+    for (size_t e = 0; e < count; e++) {
+        if (extrema[3 * e + 2] < 0) continue;
+        if (peak < 0 || extrema[3 * e + 1] > extrema[3 * peak + 1] * (1 + 1e-12) ||
+            (extrema[3 * e + 1] >= extrema[3 * peak + 1] * (1 - 1e-12) &&
+             fabs(extrema[3 * e] - steering_angle * to_rad) < fabs(extrema[3 * peak] - steering_angle * to_rad))) {
+            peak = (int)e;
+        }
+    }
+
+    PatternMetrics metrics = {0};
+    metrics.psll_db = -INFINITY;
+    metrics.psll_angle_deg = NAN;
+    metrics.peak_angle_deg = NAN;
+    metrics.half_power_left_deg = NAN;
+    metrics.half_power_right_deg = NAN;
+    metrics.beamwidth_3db_deg = NAN;
+
+    double best_sidelobe = 0;
+    for (size_t e = 0; e < count; e++) {
+        if (extrema[3 * e + 2] > 0) {
+            metrics.n_maxima++;
+            if ((int)e != peak && extrema[3 * e + 1] > best_sidelobe) {
+                best_sidelobe = extrema[3 * e + 1];
+                metrics.psll_angle_deg = extrema[3 * e] / to_rad;
+            }
+        } else {
+            if (metrics.n_nulls < max_nulls) null_angles_out[metrics.n_nulls] = extrema[3 * e] / to_rad;
+            metrics.n_nulls++;
+        }
+    }
+
+    if (peak >= 0) {
+        const double peak_theta = extrema[3 * peak];
+        const double peak_power = extrema[3 * peak + 1];
+        const double half = 0.5 * peak_power;
+        metrics.peak_angle_deg = peak_theta / to_rad;
+        metrics.peak_power = peak_power;
+        if (best_sidelobe > 0 && peak_power > 0) {
+            metrics.psll_db = 10.0 * log10(best_sidelobe / peak_power);
+        }
+
+        // Half-power crossings between the peak and the neighbouring minima (or range ends)
+        const double left_limit = peak > 0 ? extrema[3 * (peak - 1)] : lo;
+        const double right_limit = (size_t)peak + 1 < count ? extrema[3 * (peak + 1)] : hi;
+        const double left_power = probe_power(&probe, left_limit, NULL);
+        const double right_power = probe_power(&probe, right_limit, NULL);
+
+        if (left_power < half) {
+            const double root = refine_root(&probe, false, half, left_limit, peak_theta,
+                                            left_power - half, peak_power - half, tolerance);
+            metrics.half_power_left_deg = root / to_rad;
+        }
+        if (right_power < half) {
+            const double root = refine_root(&probe, false, half, peak_theta, right_limit,
+                                            peak_power - half, right_power - half, tolerance);
+            metrics.half_power_right_deg = root / to_rad;
+        }
+        metrics.beamwidth_3db_deg = metrics.half_power_right_deg - metrics.half_power_left_deg;
+    }
+
+    metrics.evaluations = probe.evaluations;
+    *metrics_out = metrics;
+    stats_phase(phase, STAT_KERNEL_CYCLES);
+    stats_add(STAT_CALLS, 1);
+    stats_add(STAT_EVALUATIONS, probe.evaluations * (uint64_t)n_elements);
+
+    free(extrema);
+    free(weights);
+    return 0;
+}
+
+// Summary of a Monte Carlo phase-error run
+typedef struct {
+    uint64_t trials;
+    double psll_mean_db;             // Mean peak sidelobe level relative to the main lobe
+    double psll_std_db;              // (both over the trials with a sidelobe on the grid)
+    double psll_worst_db;            // Highest peak sidelobe level over all trials
+    double pointing_error_mean_deg;  // Mean of (main lobe angle - steering angle)
+    double pointing_error_rms_deg;
+    double pointing_error_max_deg;   // Largest absolute pointing error
+} PatternMonteCarloStats;
+
+// Running reductions over a group of trials; merged with Chan's formula
+typedef struct {
+    uint64_t trials;
+    double* mean_power;   // Per-angle Welford mean of |AF|^2 (n_theta)
+    double* m2_power;     // Per-angle sum of squared deviations (n_theta)
+    uint64_t psll_trials; // Trials with a finite peak sidelobe level
+    double psll_mean;     // Welford mean of those levels in dB
+    double psll_m2;       // Their sum of squared deviations
+    double psll_worst;
+    double pointing_sum;
+    double pointing_sum_sq;
+    double pointing_max;
+} MonteCarloAccumulator;
+
+/**
+ * Locate the main lobe and measure one trial's pattern
+ * 
+ * The main lobe is the strongest angle nearest the steering direction,
+ * extended to the first local minimum on each side. Its extent is compared
+ * in psi (that is, sin(theta)) so the mirror image of the beam behind the
+ * array is not mistaken for a sidelobe on grids wider than +-90 degrees;
+ * grating lobes still count.
+ * 
+ * @param power |AF|^2 per angle
+ * @param psll_db Peak sidelobe level in dB, or -INFINITY when the whole
+ *        grid lies inside the main lobe
+ * @param pointing_deg Main lobe angle, refined with a parabola through the
+ *        peak and its neighbours
+ */
+static void measure_trial(
+    const double* power,
+    const double* psi,
+    const double* theta_deg,
+    int n_theta,
+    double steering_angle,
+    double* psll_db,
+    double* pointing_deg
+) {
+    double peak_power = 0;
+    for (int t = 0; t < n_theta; t++) {
+        if (power[t] > peak_power) peak_power = power[t];
+    }
+
+    // Ties (including the mirrored beam) go to the angle nearest the steering direction
+    int peak = -1;
+    for (int t = 0; t < n_theta; t++) {
+        if (power[t] >= peak_power * (1 - 1e-9) &&
+            (peak < 0 || fabs(theta_deg[t] - steering_angle) < fabs(theta_deg[peak] - steering_angle))) {
+            peak = t;
+        }
+    }
+
+    int left = peak;
+    while (left > 0 && power[left - 1] < power[left]) left--;
+    int right = peak;
+    while (right < n_theta - 1 && power[right + 1] < power[right]) right++;
+
+    double psi_lo = psi[peak];
+    double psi_hi = psi[peak];
+    for (int t = left; t <= right; t++) {
+        if (psi[t] < psi_lo) psi_lo = psi[t];
+        if (psi[t] > psi_hi) psi_hi = psi[t];
+    }
+
+    double sidelobe_power = 0;
+    bool has_sidelobe = false;
+    for (int t = 0; t < n_theta; t++) {
+        if (psi[t] < psi_lo || psi[t] > psi_hi) {
+            has_sidelobe = true;
+            if (power[t] > sidelobe_power) sidelobe_power = power[t];
+        }
+    }
+    if (!has_sidelobe || peak_power <= 0) {
+        *psll_db = -INFINITY;
+    } else {
+        *psll_db = sidelobe_power > 0 ? 10.0 * log10(sidelobe_power / peak_power) : -INFINITY;
+    }
+
+    // Vertex of the parabola through the peak and its neighbours
+    *pointing_deg = theta_deg[peak];
+    if (peak > 0 && peak < n_theta - 1) {
+        const double x0 = theta_deg[peak - 1], x1 = theta_deg[peak], x2 = theta_deg[peak + 1];
+        const double y0 = power[peak - 1], y1 = power[peak], y2 = power[peak + 1];
+        const double denom = (x0 - x1) * (x0 - x2) * (x1 - x2);
+        const double a = (x2 * (y1 - y0) + x1 * (y0 - y2) + x0 * (y2 - y1)) / denom;
+        const double b = (x2 * x2 * (y0 - y1) + x1 * x1 * (y2 - y0) + x0 * x0 * (y1 - y2)) / denom;
+        if (denom != 0 && a < 0) {
+            const double vertex = -b / (2 * a);
+            if (vertex > x0 && vertex < x2) *pointing_deg = vertex;
+        }
+    }
+}
+
+/**
+ * Fold one chunk's accumulator into the running totals (Chan et al.)
+ */
+static void merge_accumulator(MonteCarloAccumulator* total, const MonteCarloAccumulator* part, int n_theta) {
+    if (part->trials == 0) return;
+    const double na = (double)total->trials;
+    const double nb = (double)part->trials;
+    const double n = na + nb;
+
+    for (int t = 0; t < n_theta; t++) {
+        const double delta = part->mean_power[t] - total->mean_power[t];
+        total->mean_power[t] += delta * nb / n;
+        total->m2_power[t] += part->m2_power[t] + delta * delta * na * nb / n;
+    }
+
+    total->trials += part->trials;
+    if (part->psll_trials > 0) {
+        const double pa = (double)total->psll_trials;
+        const double pb = (double)part->psll_trials;
+        const double delta = part->psll_mean - total->psll_mean;
+        total->psll_mean += delta * pb / (pa + pb);
+        total->psll_m2 += part->psll_m2 + delta * delta * pa * pb / (pa + pb);
+        total->psll_trials += part->psll_trials;
+    }
+    if (part->psll_worst > total->psll_worst) total->psll_worst = part->psll_worst;
+    total->pointing_sum += part->pointing_sum;
+    total->pointing_sum_sq += part->pointing_sum_sq;
+    if (part->pointing_max > total->pointing_max) total->pointing_max = part->pointing_max;
+}
+
+/**
+ * Run Monte Carlo phase-error trials and stream their statistics
+ * 
+ * Each trial draws fresh phase errors, evaluates the pattern with the
+ * active kernel and folds it into per-angle Welford accumulators, so only
+ * O(n_theta + n_elements) memory per thread is used however many trials
+ * run. Trials are split into fixed chunks of PATTERN_MC_CHUNK that are
+ * merged in order, and trial i always uses RNG epoch base + i, so results
+ * are bit-identical at any thread count.
+ * 
+ * Peak sidelobe levels outside [psll_min_db, psll_max_db) are counted in
+ * the first or last histogram bin; the range only affects the histogram.
+ * Trials with no sidelobe on the grid (level -inf) go to the first bin,
+ * count towards the worst level, and are left out of the PSLL mean and
+ * standard deviation, which are -inf and 0 if no trial has a sidelobe.
+ * 
+ * @param n_trials Number of trials (> 0)
+ * @param mean_power_out Mean of |AF|^2 per angle (length n_theta)
+ * @param var_power_out Sample variance of |AF|^2 per angle (length n_theta, may be NULL)
+ * @param psll_min_db Lower edge of the sidelobe histogram
+ * @param psll_max_db Upper edge of the sidelobe histogram
+ * @param n_bins Number of histogram bins (0 to skip the histogram)
+ * @param psll_histogram Output counts (length n_bins, may be NULL if n_bins is 0)
+ * @param stats_out Summary statistics (may be NULL)
+ * @return 0 on success, -1 on error
+ */
+EXPORT int monte_carlo_pattern_stats(
+    int n_elements,
+    double spacing_wavelength,
+    double steering_angle,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std,
+    const double* theta_deg,
+    int n_theta,
+    int n_trials,
+    double* mean_power_out,
+    double* var_power_out,
+    double psll_min_db,
+    double psll_max_db,
+    int n_bins,
+    uint64_t* psll_histogram,
+    PatternMonteCarloStats* stats_out
+) {
+    if (n_elements <= 0 || n_theta <= 0 || n_trials <= 0 || !mean_power_out) return -1;
+    if (n_bins < 0 || (n_bins > 0 && (!psll_histogram || !(psll_max_db > psll_min_db)))) return -1;
+
+    // Angle grid without the per-call RNG draw; trials draw their own errors below
+    double* inputs = prepare_pattern_inputs(n_elements, spacing_wavelength, steering_angle,
+                                            amplitude_weights, phase_weights, 0,
+                                            theta_deg, n_theta);
+    if (!inputs) return -1;
+    const double* psi = inputs + 2 * (size_t)n_elements;
+
+    const uint64_t first_epoch = rng_claim_epochs((uint64_t)n_trials);
+    const int n_chunks = (n_trials + PATTERN_MC_CHUNK - 1) / PATTERN_MC_CHUNK;
+    const double bin_width = n_bins > 0 ? (psll_max_db - psll_min_db) / n_bins : 1;
+
+    MonteCarloAccumulator total = {0};
+    total.mean_power = mean_power_out;
+    total.m2_power = var_power_out ? var_power_out : (double*)calloc((size_t)n_theta, sizeof(double));
+    total.psll_worst = -INFINITY;
+    for (int t = 0; t < n_theta; t++) {
+        total.mean_power[t] = 0;
+        total.m2_power[t] = 0;
+    }
+    for (int b = 0; b < n_bins; b++) {
+        psll_histogram[b] = 0;
+    }
+    bool failed = total.m2_power == NULL;
+
+    #pragma omp parallel if(n_chunks > 1 && !failed)
+    {
+        // Thread-local trial buffers
+        double* weights = (double*)malloc(2 * (size_t)n_elements * sizeof(double));
+        double complex* pattern = (double complex*)malloc((size_t)n_theta * sizeof(double complex));
+        double* power = (double*)malloc(3 * (size_t)n_theta * sizeof(double));
+        uint64_t* histogram = (uint64_t*)calloc((size_t)n_bins + 1, sizeof(uint64_t));
+        const bool ready = weights && pattern && power && histogram;
+
+        #pragma omp for ordered schedule(static, 1)
+        for (int c = 0; c < n_chunks; c++) {
+            MonteCarloAccumulator part = {0};
+            part.psll_worst = -INFINITY;
+
+            if (ready) {
+                part.mean_power = power + n_theta;
+                part.m2_power = power + 2 * (size_t)n_theta;
+                for (int t = 0; t < n_theta; t++) {
+                    part.mean_power[t] = 0;
+                    part.m2_power[t] = 0;
+                }
+                for (int b = 0; b < n_bins; b++) {
+                    histogram[b] = 0;
+                }
+
+                const int begin = c * PATTERN_MC_CHUNK;
+                const int end = begin + PATTERN_MC_CHUNK < n_trials ? begin + PATTERN_MC_CHUNK : n_trials;
+                for (int trial = begin; trial < end; trial++) {
+                    const uint64_t key = rng_epoch_key(first_epoch + (uint64_t)trial);
+                    fill_element_weights_keyed(n_elements, amplitude_weights, phase_weights, phase_error_std,
+                                               0, key, weights, weights + n_elements);
+                    active_pattern_kernel->kernel(weights, weights + n_elements, n_elements, psi, n_theta,
+                                                  pattern);
+
+                    // Welford update of the per-angle power
+                    part.trials++;
+                    for (int t = 0; t < n_theta; t++) {
+                        const double re = creal(pattern[t]);
+                        const double im = cimag(pattern[t]);
+                        power[t] = re * re + im * im;
+                        const double delta = power[t] - part.mean_power[t];
+                        part.mean_power[t] += delta / (double)part.trials;
+                        part.m2_power[t] += delta * (power[t] - part.mean_power[t]);
+                    }
+
+                    double psll, pointing;
+                    measure_trial(power, psi, theta_deg, n_theta, steering_angle, &psll, &pointing);
+                    const double pointing_error = pointing - steering_angle;
+
+                    if (isfinite(psll)) {
+                        part.psll_trials++;
+                        const double delta = psll - part.psll_mean;
+                        part.psll_mean += delta / (double)part.psll_trials;
+                        part.psll_m2 += delta * (psll - part.psll_mean);
+                    }
+                    if (psll > part.psll_worst) part.psll_worst = psll;
+                    part.pointing_sum += pointing_error;
+                    part.pointing_sum_sq += pointing_error * pointing_error;
+                    if (fabs(pointing_error) > part.pointing_max) part.pointing_max = fabs(pointing_error);
+
+                    if (n_bins > 0) {
+                        // Clamp before dividing so -inf lands in the first bin too
+                        const double level = psll > psll_min_db ? psll : psll_min_db;
+                        double bin = floor((level - psll_min_db) / bin_width);
+                        if (bin > n_bins - 1) bin = n_bins - 1;
+                        histogram[(int)bin]++;
+                    }
+                }
+            }
+
+            #pragma omp ordered
+            {
+                if (!ready) {
+                    failed = true;
+                } else if (!failed) {
+                    merge_accumulator(&total, &part, n_theta);
+                    for (int b = 0; b < n_bins; b++) {
+                        psll_histogram[b] += histogram[b];
+                    }
+                }
+            }
+        }
+
+        free(histogram);
+        free(power);
+        free(pattern);
+        free(weights);
+    }
+
+    if (!failed) {
+        for (int t = 0; t < n_theta; t++) {
+            total.m2_power[t] = n_trials > 1 ? total.m2_power[t] / (n_trials - 1) : 0;
+        }
+
+        if (stats_out) {
+            const double n = (double)n_trials;
+            const uint64_t psll_n = total.psll_trials;
+            stats_out->trials = total.trials;
+            stats_out->psll_mean_db = psll_n > 0 ? total.psll_mean : -INFINITY;
+            stats_out->psll_std_db = psll_n > 1 ? sqrt(total.psll_m2 / (double)(psll_n - 1)) : 0;
+            stats_out->psll_worst_db = total.psll_worst;
+            stats_out->pointing_error_mean_deg = total.pointing_sum / n;
+            stats_out->pointing_error_rms_deg = sqrt(total.pointing_sum_sq / n);
+            stats_out->pointing_error_max_deg = total.pointing_max;
+        }
+    }
+
+    if (!var_power_out) free(total.m2_power);
+    free(inputs);
+    return failed ? -1 : 0;
+}
+
+// Add noise_std * (n_re + j n_im) to samples [begin, end), one Box-Muller pair per sample index
+static void apply_awgn(double complex* signal, int begin, int end, uint64_t key, double noise_std) {
+    for (int i = begin; i < end; i++) {
+        double noise_re, noise_im;
+        randn_pair(key, (uint64_t)i, &noise_re, &noise_im);
+        signal[i] += noise_std * (noise_re + I * noise_im);
+    }
+}
+
+// Noise standard deviation per real component for a given signal power and SNR
+static double awgn_noise_std(double signal_power, double snr_db) {
+    const double snr_linear = pow(10.0, snr_db / 10.0);
+    const double noise_power = signal_power / snr_linear;
+    return sqrt(noise_power / 2.0);
+}
+
+/**
+ * Add AWGN relative to a known signal power
+ * 
+ * Repeated noisy realizations of the same pattern can pass the power
+ * measured once and skip the reduction pass entirely.
+ * 
+ * @param signal Complex signal array
+ * @param n_samples Number of samples
  * @param snr_db Signal-to-Noise Ratio in dB
+ * @param signal_power Mean |z|^2 of the clean signal, or <= 0 to measure it
  * @return 0 on success, -1 on error
  */
-EXPORT int add_awgn(
+EXPORT int add_awgn_power(
     double complex* signal,
     int n_samples,
-    double snr_db
+    double snr_db,
+    double signal_power
 ) {
+    if (n_samples <= 0) return n_samples == 0 ? 0 : -1;
+    const uint64_t phase = stats_start();
+
     // Calculate signal power
-    double signal_power = 0;
-    for (int i = 0; i < n_samples; i++) {
-        signal_power += cabs(signal[i]) * cabs(signal[i]);
+    if (signal_power <= 0) {
+        signal_power = 0;
+        for (int i = 0; i < n_samples; i++) {
+            signal_power += creal(signal[i]) * creal(signal[i]) + cimag(signal[i]) * cimag(signal[i]);
+        }
+        signal_power /= n_samples;
     }
-    signal_power /= n_samples;
 
-    // Calculate noise power from SNR
-    const double snr_linear = pow(10.0, snr_db / 10.0);
-    const double noise_power = signal_power / snr_linear;
-    const double noise_std = sqrt(noise_power / 2.0);
+    const double noise_std = awgn_noise_std(signal_power, snr_db);
+    const uint64_t key = rng_begin_call();
 
     // Add complex noise to signal
     #pragma omp parallel for if(n_samples > 1000)
     for (int i = 0; i < n_samples; i++) {
-        signal[i] += noise_std * (randn(0, 1) + I * randn(0, 1));
+        apply_awgn(signal, i, i + 1, key, noise_std);
+    }
+    stats_phase(phase, STAT_NOISE_CYCLES);
+    stats_add(STAT_CALLS, 1);
+    stats_add(STAT_RNG_DRAWS, (uint64_t)n_samples);
+
+    return 0;
+}
+
+/**
+ * Add Additive White Gaussian Noise (AWGN) to a signal
+ * 
+ * @param signal Complex signal array
+ * @param n_samples Number of samples
+ * @param snr_db Signal-to-Noise Ratio in dB
+ * @return 0 on success, -1 on error
+ */
+EXPORT int add_awgn(
+    double complex* signal,
+    int n_samples,
+    double snr_db
+) {
+    return add_awgn_power(signal, n_samples, snr_db, 0);
+}
+
+/**
+ * Fused pattern and noise stages on prepared inputs
+ * 
+ * @param tile_power Scratch for per-tile power (ceil(n_theta / PATTERN_NOISE_TILE) doubles)
+ * @return Signal power that set the noise level
+ */
+static double pattern_awgn_core(
+    const double* weights_re,
+    const double* weights_im,
+    int n_elements,
+    const double* psi,
+    int n_theta,
+    uint64_t key,
+    double snr_db,
+    double signal_power,
+    double* tile_power,
+    double complex* pattern_out
+) {
+    const int n_tiles = (n_theta + PATTERN_NOISE_TILE - 1) / PATTERN_NOISE_TILE;
+    const PatternKernel kernel = active_pattern_kernel->kernel;
+
+    if (signal_power > 0) {
+        const double noise_std = awgn_noise_std(signal_power, snr_db);
+
+        #pragma omp parallel for schedule(dynamic) if(n_theta > 1000)
+        for (int tile = 0; tile < n_tiles; tile++) {
+            const int begin = tile * PATTERN_NOISE_TILE;
+            const int end = begin + PATTERN_NOISE_TILE < n_theta ? begin + PATTERN_NOISE_TILE : n_theta;
+            kernel(weights_re, weights_im, n_elements, psi + begin, end - begin, pattern_out + begin);
+            apply_awgn(pattern_out, begin, end, key, noise_std);
+        }
+        return signal_power;
+    }
+
+    // Per-tile partial sums, added in order so the result is thread-count independent
+    #pragma omp parallel for schedule(dynamic) if(n_theta > 1000)
+    for (int tile = 0; tile < n_tiles; tile++) {
+        const int begin = tile * PATTERN_NOISE_TILE;
+        const int end = begin + PATTERN_NOISE_TILE < n_theta ? begin + PATTERN_NOISE_TILE : n_theta;
+        kernel(weights_re, weights_im, n_elements, psi + begin, end - begin, pattern_out + begin);
+
+        double power = 0;
+        for (int t = begin; t < end; t++) {
+            power += creal(pattern_out[t]) * creal(pattern_out[t]) + cimag(pattern_out[t]) * cimag(pattern_out[t]);
+        }
+        tile_power[tile] = power;
+    }
+
+    signal_power = 0;
+    for (int tile = 0; tile < n_tiles; tile++) {
+        signal_power += tile_power[tile];
+    }
+    signal_power /= n_theta;
+
+    const double noise_std = awgn_noise_std(signal_power, snr_db);
+
+    #pragma omp parallel for schedule(dynamic) if(n_theta > 1000)
+    for (int tile = 0; tile < n_tiles; tile++) {
+        const int begin = tile * PATTERN_NOISE_TILE;
+        const int end = begin + PATTERN_NOISE_TILE < n_theta ? begin + PATTERN_NOISE_TILE : n_theta;
+        apply_awgn(pattern_out, begin, end, key, noise_std);
+    }
+    return signal_power;
+}
+
+/**
+ * Calculate a noisy radiation pattern in one fused pass
+ * 
+ * Equivalent to calculate_pattern followed by add_awgn_power, including
+ * RNG consumption, but the angles are processed in tiles of
+ * PATTERN_NOISE_TILE: with a known signal power each tile gets its noise
+ * while still in cache, otherwise the tiles accumulate |z|^2 as they are
+ * generated and a single noise pass follows.
+ * 
+ * @param snr_db Signal-to-Noise Ratio in dB
+ * @param signal_power Mean |AF|^2 of the clean pattern, or <= 0 to measure it
+ * @param signal_power_out Power that set the noise level (may be NULL)
+ * @param pattern_out Output array for pattern (length n_theta)
+ * @return 0 on success, -1 on error
+ */
+EXPORT int calculate_pattern_awgn(
+    int n_elements,
+    double spacing_wavelength,
+    double steering_angle,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std,
+    const double* theta_deg,
+    int n_theta,
+    double snr_db,
+    double signal_power,
+    double* signal_power_out,
+    double complex* pattern_out
+) {
+    if (n_theta <= 0) return n_theta == 0 ? 0 : -1;
+
+    uint64_t phase = stats_start();
+    double* inputs = prepare_pattern_inputs(n_elements, spacing_wavelength, steering_angle,
+                                            amplitude_weights, phase_weights, phase_error_std,
+                                            theta_deg, n_theta);
+    if (!inputs) return -1;
+
+    const int n_tiles = (n_theta + PATTERN_NOISE_TILE - 1) / PATTERN_NOISE_TILE;
+    double* tile_power = (double*)malloc((size_t)n_tiles * sizeof(double));
+    if (!tile_power) {
+        free(inputs);
+        return -1;
+    }
+    stats_allocation((size_t)n_tiles * sizeof(double));
+    phase = stats_phase(phase, STAT_SETUP_CYCLES);
+
+    // Kernel and noise are fused per tile, so both count as kernel cycles
+    const uint64_t key = rng_begin_call();
+    signal_power = pattern_awgn_core(inputs, inputs + n_elements, n_elements, inputs + 2 * (size_t)n_elements,
+                                     n_theta, key, snr_db, signal_power, tile_power, pattern_out);
+    stats_phase(phase, STAT_KERNEL_CYCLES);
+    stats_add(STAT_CALLS, 1);
+    stats_add(STAT_EVALUATIONS, (uint64_t)n_elements * (uint64_t)n_theta);
+    stats_add(STAT_RNG_DRAWS, (uint64_t)n_theta);
+
+    if (signal_power_out) *signal_power_out = signal_power;
+    free(tile_power);
+    free(inputs);
+    return 0;
+}
+
+// Reusable workspace for repeated evaluations on one array and angle grid
+typedef struct {
+    int n_elements;
+    int n_theta;
+    double kd;             // k * d
+    double* sin_theta;     // k * d * sin(theta) per angle
+    double* psi;           // Phase steps for the current steering angle
+    double* weights;       // Element weights, real parts then imaginary parts
+    double* tile_power;    // Scratch for the fused noise path
+} PatternPlan;
+
+/**
+ * Create a pattern plan
+ * 
+ * Allocates every buffer the hot calls need and evaluates sin(theta) once,
+ * so pattern_plan_execute() and pattern_plan_execute_awgn() never allocate.
+ * A plan may be used by one thread at a time; separate plans are
+ * independent.
+ * 
+ * @param n_elements Number of array elements
+ * @param spacing_wavelength Spacing between elements in wavelengths
+ * @param theta_deg Array of angles in degrees (copied)
+ * @param n_theta Length of theta array
+ * @return New plan, or NULL on error
+ */
+EXPORT PatternPlan* pattern_plan_create(
+    int n_elements,
+    double spacing_wavelength,
+    const double* theta_deg,
+    int n_theta
+) {
+    if (n_elements <= 0 || n_theta <= 0) return NULL;
+
+    PatternPlan* plan = (PatternPlan*)calloc(1, sizeof(PatternPlan));
+    if (!plan) return NULL;
+
+    const size_t n_tiles = ((size_t)n_theta + PATTERN_NOISE_TILE - 1) / PATTERN_NOISE_TILE;
+    plan->n_elements = n_elements;
+    plan->n_theta = n_theta;
+    plan->kd = 2.0 * M_PI * spacing_wavelength;
+    plan->sin_theta = (double*)malloc((2 * (size_t)n_theta + n_tiles) * sizeof(double));
+    plan->weights = (double*)malloc(2 * (size_t)n_elements * sizeof(double));
+    if (!plan->sin_theta || !plan->weights) {
+        free(plan->sin_theta);
+        free(plan->weights);
+        free(plan);
+        return NULL;
+    }
+    stats_allocation(sizeof(PatternPlan));
+    stats_allocation((2 * (size_t)n_theta + n_tiles) * sizeof(double));
+    stats_allocation(2 * (size_t)n_elements * sizeof(double));
+    plan->psi = plan->sin_theta + n_theta;
+    plan->tile_power = plan->psi + n_theta;
+
+    for (int t = 0; t < n_theta; t++) {
+        plan->sin_theta[t] = plan->kd * sin(theta_deg[t] * M_PI / 180.0);
+    }
+
+    return plan;
+}
+
+/**
+ * Release a pattern plan
+ */
+EXPORT void pattern_plan_destroy(PatternPlan* plan) {
+    if (!plan) return;
+    free(plan->sin_theta);
+    free(plan->weights);
+    free(plan);
+}
+
+// Fill the plan's weights and phase steps for one call
+static void pattern_plan_prepare(
+    PatternPlan* plan,
+    double steering_angle,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std
+) {
+    fill_element_weights(plan->n_elements, amplitude_weights, phase_weights, phase_error_std, 0,
+                         plan->weights, plan->weights + plan->n_elements);
+
+    const double steering_step = plan->kd * sin(steering_angle * M_PI / 180.0);
+    for (int t = 0; t < plan->n_theta; t++) {
+        plan->psi[t] = plan->sin_theta[t] - steering_step;
+    }
+}
+
+/**
+ * Calculate a radiation pattern with a plan
+ * 
+ * Same result and RNG use as calculate_pattern for the plan's array and
+ * angle grid, without any allocation.
+ * 
+ * @param plan Plan from pattern_plan_create()
+ * @param steering_angle Steering angle in degrees
+ * @param amplitude_weights Array of amplitude weights (length n_elements)
+ * @param phase_weights Array of phase weights in degrees (length n_elements)
+ * @param phase_error_std Standard deviation of phase errors in degrees
+ * @param pattern_out Output array for pattern (length n_theta)
+ * @return 0 on success, -1 on error
+ */
+EXPORT int pattern_plan_execute(
+    PatternPlan* plan,
+    double steering_angle,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std,
+    double complex* pattern_out
+) {
+    if (!plan) return -1;
+
+    uint64_t phase = stats_start();
+    pattern_plan_prepare(plan, steering_angle, amplitude_weights, phase_weights, phase_error_std);
+    phase = stats_phase(phase, STAT_SETUP_CYCLES);
+    active_pattern_kernel->kernel(plan->weights, plan->weights + plan->n_elements, plan->n_elements,
+                                  plan->psi, plan->n_theta, pattern_out);
+    stats_phase(phase, STAT_KERNEL_CYCLES);
+    stats_add(STAT_CALLS, 1);
+    stats_add(STAT_EVALUATIONS, (uint64_t)plan->n_elements * (uint64_t)plan->n_theta);
+    return 0;
+}
+
+/**
+ * Calculate a noisy radiation pattern with a plan
+ * 
+ * Same result and RNG use as calculate_pattern_awgn, without any allocation.
+ * 
+ * @param snr_db Signal-to-Noise Ratio in dB
+ * @param signal_power Mean |AF|^2 of the clean pattern, or <= 0 to measure it
+ * @param signal_power_out Power that set the noise level (may be NULL)
+ * @return 0 on success, -1 on error
+ */
+EXPORT int pattern_plan_execute_awgn(
+    PatternPlan* plan,
+    double steering_angle,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std,
+    double snr_db,
+    double signal_power,
+    double* signal_power_out,
+    double complex* pattern_out
+) {
+    if (!plan) return -1;
+
+    uint64_t phase = stats_start();
+    pattern_plan_prepare(plan, steering_angle, amplitude_weights, phase_weights, phase_error_std);
+    phase = stats_phase(phase, STAT_SETUP_CYCLES);
+    const uint64_t key = rng_begin_call();
+    signal_power = pattern_awgn_core(plan->weights, plan->weights + plan->n_elements, plan->n_elements,
+                                     plan->psi, plan->n_theta, key, snr_db, signal_power, plan->tile_power,
+                                     pattern_out);
+    stats_phase(phase, STAT_KERNEL_CYCLES);
+    stats_add(STAT_CALLS, 1);
+    stats_add(STAT_EVALUATIONS, (uint64_t)plan->n_elements * (uint64_t)plan->n_theta);
+    stats_add(STAT_RNG_DRAWS, (uint64_t)plan->n_theta);
+
+    if (signal_power_out) *signal_power_out = signal_power;
+    return 0;
+}
+
+// Planar arrays
+//
+// Directions are (theta, phi) with theta measured from broadside (the
+// array normal) and phi in the array plane from the x axis, so
+// u = sin(theta) cos(phi) and v = sin(theta) sin(phi). Patterns are
+// row-major n_theta x n_phi.
+
+/**
+ * Direction cosine offsets from the steering direction for a theta x phi grid
+ * 
+ * @param du_out k * (u - u0) per grid point (n_theta * n_phi)
+ * @param dv_out k * (v - v0) per grid point (n_theta * n_phi)
+ */
+static void planar_direction_offsets(
+    double steering_theta,
+    double steering_phi,
+    const double* theta_deg,
+    int n_theta,
+    const double* phi_deg,
+    int n_phi,
+    double* du_out,
+    double* dv_out
+) {
+    const double k = 2.0 * M_PI;
+    const double st0 = sin(steering_theta * M_PI / 180.0);
+    const double u0 = st0 * cos(steering_phi * M_PI / 180.0);
+    const double v0 = st0 * sin(steering_phi * M_PI / 180.0);
+
+    for (int i = 0; i < n_theta; i++) {
+        const double st = sin(theta_deg[i] * M_PI / 180.0);
+        for (int j = 0; j < n_phi; j++) {
+            const double phi = phi_deg[j] * M_PI / 180.0;
+            du_out[(size_t)i * n_phi + j] = k * (st * cos(phi) - u0);
+            dv_out[(size_t)i * n_phi + j] = k * (st * sin(phi) - v0);
+        }
     }
+}
+
+/**
+ * Calculate the pattern of a rectangular planar array
+ * 
+ * Elements sit on an nx x ny lattice with spacings dx, dy. The lattice is
+ * separable: element (m, n) contributes w_mn * exp(j m psi_x) * exp(j n psi_y),
+ * so each row of the array is a linear array in psi_x and goes through the
+ * same dispatched kernels as calculate_pattern, and the rows are combined
+ * with a phasor recurrence in psi_y. Grid points are processed in
+ * cache-resident tiles of PLANAR_TILE, with tiles spread over OpenMP
+ * threads.
+ * 
+ * @param nx Elements along x
+ * @param ny Elements along y
+ * @param dx_wavelength Spacing along x in wavelengths
+ * @param dy_wavelength Spacing along y in wavelengths
+ * @param steering_theta Steering elevation from broadside in degrees
+ * @param steering_phi Steering azimuth in degrees
+ * @param amplitude_weights Amplitude weights, row-major ny x nx
+ * @param phase_weights Phase weights in degrees, row-major ny x nx
+ * @param phase_error_std Standard deviation of phase errors in degrees
+ * @param theta_deg Elevation angles in degrees (length n_theta)
+ * @param phi_deg Azimuth angles in degrees (length n_phi)
+ * @param pattern_out Output, row-major n_theta x n_phi
+ * @return 0 on success, -1 on error
+ */
+EXPORT int calculate_planar_pattern(
+    int nx,
+    int ny,
+    double dx_wavelength,
+    double dy_wavelength,
+    double steering_theta,
+    double steering_phi,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std,
+    const double* theta_deg,
+    int n_theta,
+    const double* phi_deg,
+    int n_phi,
+    double complex* pattern_out
+) {
+    if (nx <= 0 || ny <= 0 || n_theta < 0 || n_phi < 0) return -1;
+
+    const size_t n_elements = (size_t)nx * ny;
+    const size_t n_points = (size_t)n_theta * n_phi;
+    if (n_points == 0) return 0;
+    if (n_points > INT32_MAX) return -1;
+
+    double* buffer = (double*)malloc((2 * n_elements + 2 * n_points) * sizeof(double));
+    if (!buffer) return -1;
+    double* weights_re = buffer;
+    double* weights_im = buffer + n_elements;
+    double* psi_x = buffer + 2 * n_elements;
+    double* psi_y = psi_x + n_points;
+
+    fill_element_weights((int)n_elements, amplitude_weights, phase_weights, phase_error_std, 0,
+                         weights_re, weights_im);
+    planar_direction_offsets(steering_theta, steering_phi, theta_deg, n_theta, phi_deg, n_phi, psi_x, psi_y);
+    for (size_t p = 0; p < n_points; p++) {
+        psi_x[p] *= dx_wavelength;
+        psi_y[p] *= dy_wavelength;
+    }
+
+    const PatternKernel kernel = active_pattern_kernel->kernel;
+    const int n_tiles = (int)((n_points + PLANAR_TILE - 1) / PLANAR_TILE);
+
+    #pragma omp parallel for schedule(dynamic) if(n_tiles > 1)
+    for (int tile = 0; tile < n_tiles; tile++) {
+        const int p0 = tile * PLANAR_TILE;
+        const int width = (int)n_points - p0 < PLANAR_TILE ? (int)n_points - p0 : PLANAR_TILE;
+        double complex row[PLANAR_TILE];
+        double acc_re[PLANAR_TILE] = {0};
+        double acc_im[PLANAR_TILE] = {0};
+        double z_re[PLANAR_TILE], z_im[PLANAR_TILE];
+        double step_re[PLANAR_TILE], step_im[PLANAR_TILE];
+
+        for (int p = 0; p < width; p++) {
+            step_re[p] = cos(psi_y[p0 + p]);
+            step_im[p] = sin(psi_y[p0 + p]);
+        }
 
+        for (int n = 0; n < ny; n++) {
+            // Row phasor exp(j n psi_y), exact every PHASOR_RESYNC rows
+            if (n % PHASOR_RESYNC == 0) {
+                for (int p = 0; p < width; p++) {
+                    z_re[p] = cos(n * psi_y[p0 + p]);
+                    z_im[p] = sin(n * psi_y[p0 + p]);
+                }
+            }
+
+            kernel(weights_re + (size_t)n * nx, weights_im + (size_t)n * nx, nx, psi_x + p0, width, row);
+
+            for (int p = 0; p < width; p++) {
+                const double r_re = creal(row[p]);
+                const double r_im = cimag(row[p]);
+                acc_re[p] += r_re * z_re[p] - r_im * z_im[p];
+                acc_im[p] += r_re * z_im[p] + r_im * z_re[p];
+
+                const double next_re = z_re[p] * step_re[p] - z_im[p] * step_im[p];
+                z_im[p] = z_re[p] * step_im[p] + z_im[p] * step_re[p];
+                z_re[p] = next_re;
+            }
+        }
+
+        for (int p = 0; p < width; p++) {
+            pattern_out[p0 + p] = CMPLX(acc_re[p], acc_im[p]);
+        }
+    }
+
+    free(buffer);
+    return 0;
+}
+
+/**
+ * Calculate the pattern of a planar array with arbitrary element positions
+ * 
+ * Fallback for irregular layouts: every element/direction pair needs its
+ * own phase, so there is no recurrence to exploit. The vector kernels put
+ * adjacent grid points in lanes and use the vector sincos; the portable
+ * kernel blocks points and elements for cache reuse.
+ * 
+ * @param n_elements Number of elements
+ * @param x_wavelength Element x positions in wavelengths (length n_elements)
+ * @param y_wavelength Element y positions in wavelengths (length n_elements)
+ * @param steering_theta Steering elevation from broadside in degrees
+ * @param steering_phi Steering azimuth in degrees
+ * @param amplitude_weights Amplitude weights (length n_elements)
+ * @param phase_weights Phase weights in degrees (length n_elements)
+ * @param phase_error_std Standard deviation of phase errors in degrees
+ * @param theta_deg Elevation angles in degrees (length n_theta)
+ * @param phi_deg Azimuth angles in degrees (length n_phi)
+ * @param pattern_out Output, row-major n_theta x n_phi
+ * @return 0 on success, -1 on error
+ */
+EXPORT int calculate_planar_pattern_positions(
+    int n_elements,
+    const double* x_wavelength,
+    const double* y_wavelength,
+    double steering_theta,
+    double steering_phi,
+    const double* amplitude_weights,
+    const double* phase_weights,
+    double phase_error_std,
+    const double* theta_deg,
+    int n_theta,
+    const double* phi_deg,
+    int n_phi,
+    double complex* pattern_out
+) {
+    if (n_elements <= 0 || n_theta < 0 || n_phi < 0) return -1;
+
+    const size_t n_points = (size_t)n_theta * n_phi;
+    if (n_points == 0) return 0;
+    if (n_points > INT32_MAX) return -1;
+
+    double* buffer = (double*)malloc((2 * (size_t)n_elements + 2 * n_points) * sizeof(double));
+    if (!buffer) return -1;
+    double* weights_re = buffer;
+    double* weights_im = buffer + n_elements;
+    double* du = buffer + 2 * (size_t)n_elements;
+    double* dv = du + n_points;
+
+    fill_element_weights(n_elements, amplitude_weights, phase_weights, phase_error_std, 0,
+                         weights_re, weights_im);
+    planar_direction_offsets(steering_theta, steering_phi, theta_deg, n_theta, phi_deg, n_phi, du, dv);
+
+    active_pattern_kernel->planar_positions(x_wavelength, y_wavelength, weights_re, weights_im, n_elements,
+                                            du, dv, (int)n_points, pattern_out);
+
+    free(buffer);
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1 @@
+"""Tests for the radiation_pattern package."""
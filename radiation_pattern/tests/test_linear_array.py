@@ -1,6 +1,7 @@
 """Tests for the linear array radiation pattern calculator."""
 
 import numpy as np
+import matplotlib.pyplot as plt
 import pytest
 from ..linear_array import ArrayParameters, calculate_pattern, plot_radiation_pattern
 
@@ -0,0 +1,413 @@
+"""Tests for the hybrid Python/C radiation pattern calculator."""
+
+import json
+import math
+import os
+import subprocess
+import sys
+
+import pytest
+
+np = pytest.importorskip("numpy")
+pytest.importorskip("matplotlib")
+
+# The hybrid modules import each other as top-level modules
+PACKAGE_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+sys.path.insert(0, PACKAGE_DIR)
+import linear_array  # noqa: E402
+import linear_array_hybrid as hybrid  # noqa: E402
+import planar_array_hybrid as planar  # noqa: E402
+
+KERNELS = ['scalar', 'generic', 'avx2', 'avx512']
+
+
+def _random_params(n_elements, steering_angle=0.0, spacing_wavelength=0.5, seed=0, **kwargs):
+    rng = np.random.default_rng(seed)
+    return hybrid.ArrayParameters(n_elements=n_elements, spacing_wavelength=spacing_wavelength,
+                                  steering_angle=steering_angle,
+                                  amplitude_weights=rng.uniform(0.5, 1.5, n_elements),
+                                  phase_weights=rng.uniform(-180.0, 180.0, n_elements), **kwargs)
+
+
+def _reference_pattern(params, theta):
+    """Pure NumPy pattern of the same array, without phase errors"""
+    reference = linear_array.ArrayParameters(n_elements=params.n_elements,
+                                             spacing_wavelength=params.spacing_wavelength,
+                                             steering_angle=params.steering_angle,
+                                             amplitude_weights=params.amplitude_weights,
+                                             phase_weights=params.phase_weights)
+    return linear_array.calculate_pattern(reference, theta)
+
+
+def _relative_error(pattern, expected):
+    """Largest deviation relative to the main lobe"""
+    return np.max(np.abs(pattern - expected)) / np.max(np.abs(expected))
+
+
+def _use_kernel(name):
+    try:
+        hybrid.set_pattern_kernel(name)
+    except ValueError:
+        pytest.skip(f"{name} kernel is not supported on this CPU")
+
+
+@pytest.mark.parametrize('kernel', KERNELS)
+@pytest.mark.parametrize('n_elements', [1, 37, 256])
+def test_kernels_match_numpy_reference(kernel, n_elements):
+    params = _random_params(n_elements, steering_angle=-35.0, spacing_wavelength=0.7)
+    theta = np.linspace(-90, 90, 1001)
+    expected = _reference_pattern(params, theta)
+    _use_kernel(kernel)
+    try:
+        assert hybrid.get_pattern_kernel() == kernel
+        assert _relative_error(hybrid.calculate_pattern(params, theta), expected) < 1e-10
+        assert _relative_error(hybrid.calculate_pattern(params, theta, precision='single'), expected) < 1e-5
+        # Grids shorter than a vector exercise the tail handling
+        for n_theta in (1, 3, 4, 7, 8, 9, 17):
+            pattern = hybrid.calculate_pattern(params, theta[:n_theta])
+            assert np.max(np.abs(pattern - expected[:n_theta])) < 1e-10 * np.max(np.abs(expected))
+    finally:
+        hybrid.set_pattern_kernel(None)
+
+
+@pytest.mark.parametrize('kernel', KERNELS)
+def test_kernels_match_libm_at_the_sincos_reduction_bound(kernel):
+    # With a power-of-two spacing psi can be reproduced exactly, and two unit
+    # elements give 1 + exp(j psi), for |psi| up to 2^29 * pi
+    spacing_wavelength = 2.0 ** 28
+    params = hybrid.ArrayParameters(n_elements=2, spacing_wavelength=spacing_wavelength,
+                                    amplitude_weights=np.ones(2), phase_weights=np.zeros(2))
+    theta = np.concatenate([np.random.default_rng(12).uniform(-90, 90, 997), [90.0, -90.0, 30.0]])
+    psi = [2.0 * math.pi * spacing_wavelength * (math.sin(t * math.pi / 180.0) - math.sin(0.0)) for t in theta]
+    expected = np.array([1 + complex(math.cos(p), math.sin(p)) for p in psi])
+    assert max(abs(p) for p in psi) == 2.0 ** 29 * math.pi
+    _use_kernel(kernel)
+    try:
+        assert np.max(np.abs(hybrid.calculate_pattern(params, theta) - expected)) < 1e-12
+    finally:
+        hybrid.set_pattern_kernel(None)
+
+def test_unknown_kernel_rejected():
+    with pytest.raises(ValueError):
+        hybrid.set_pattern_kernel('sse9')
+
+
+@pytest.mark.parametrize('n_elements, spacing_wavelength, steering_angle, n_theta', [
+    (3, 2.0, 60.0, 50),
+    (8, 0.5, 0.0, 181),
+    (64, 0.5, 25.0, 1441),
+    (1000, 0.5, 10.0, 721),
+])
+def test_fft_matches_direct_sum(n_elements, spacing_wavelength, steering_angle, n_theta):
+    params = _random_params(n_elements, steering_angle=steering_angle, spacing_wavelength=spacing_wavelength)
+    theta = np.linspace(-90, 90, n_theta)
+    direct = hybrid.calculate_pattern(params, theta)
+    assert _relative_error(hybrid.calculate_pattern(params, theta, method='fft'), direct) < 1e-4
+
+
+def test_fft_rejects_single_precision():
+    params = _random_params(8)
+    with pytest.raises(ValueError):
+        hybrid.calculate_pattern(params, np.linspace(-90, 90, 19), method='fft', precision='single')
+
+
+@pytest.mark.parametrize('phase_error_std', [0.0, 5.0])
+def test_multibeam_matches_one_pattern_per_beam(phase_error_std):
+    params = _random_params(40, phase_error_std=phase_error_std)
+    theta = np.linspace(-90, 90, 777)
+    steering_angles = np.array([-89.0, -50.0, -10.0, 0.0, 3.0, 33.0, 70.0])
+
+    hybrid._lib.seed_rng(7)
+    patterns = hybrid.calculate_multibeam_pattern(params, theta, steering_angles)
+    # Each beam draws its phase errors in the order separate calls would
+    hybrid._lib.seed_rng(7)
+    for steering_angle, pattern in zip(steering_angles, patterns):
+        params.steering_angle = steering_angle
+        assert np.allclose(pattern, hybrid.calculate_pattern(params, theta), rtol=0, atol=1e-12 * params.n_elements)
+
+
+@pytest.mark.parametrize('phase_error_std', [0.0, 5.0])
+def test_weight_sets_match_one_pattern_per_set(phase_error_std):
+    params = _random_params(40, steering_angle=20.0, phase_error_std=phase_error_std)
+    theta = np.linspace(-90, 90, 777)
+    rng = np.random.default_rng(14)
+    amplitude_sets = rng.uniform(0.5, 1.5, (5, params.n_elements))
+    phase_sets = rng.uniform(-180.0, 180.0, (5, params.n_elements))
+
+    hybrid._lib.seed_rng(9)
+    patterns = hybrid.calculate_weight_set_patterns(params, theta, amplitude_sets, phase_sets)
+    hybrid._lib.seed_rng(9)
+    for amplitude_weights, phase_weights, pattern in zip(amplitude_sets, phase_sets, patterns):
+        params.amplitude_weights = np.ascontiguousarray(amplitude_weights)
+        params.phase_weights = np.ascontiguousarray(phase_weights)
+        assert np.allclose(pattern, hybrid.calculate_pattern(params, theta), rtol=0, atol=1e-12 * params.n_elements)
+
+
+def _run_with_threads(script, threads):
+    """Run a script in a fresh interpreter with OMP_NUM_THREADS set and decode its JSON output"""
+    env = dict(os.environ, OMP_NUM_THREADS=str(threads))
+    proc = subprocess.run([sys.executable, '-c', script], cwd=PACKAGE_DIR, env=env,
+                          capture_output=True, text=True, check=True)
+    return json.loads(proc.stdout)
+
+
+# Grids above 1000 angles take the OpenMP paths
+RANDOM_DRAWS_SCRIPT = """
+import hashlib, json
+import numpy as np
+import linear_array_hybrid as hybrid
+
+rng = np.random.default_rng(15)
+params = hybrid.ArrayParameters(n_elements=50, spacing_wavelength=0.5, steering_angle=10.0,
+                                amplitude_weights=rng.uniform(0.5, 1.5, 50),
+                                phase_weights=rng.uniform(-180.0, 180.0, 50),
+                                phase_error_std=4.0, seed=3)
+theta = np.linspace(-90, 90, 4001)
+digest = lambda a: hashlib.sha256(np.ascontiguousarray(a).tobytes()).hexdigest()
+results = {
+    'phase_errors': digest(hybrid.calculate_pattern(params, theta)),
+    'fused_awgn': digest(hybrid.calculate_pattern(params, theta, snr_db=10.0)),
+    'fft_awgn': digest(hybrid.calculate_pattern(params, theta, snr_db=10.0, method='fft')),
+    'single_awgn': digest(hybrid.calculate_pattern(params, theta, snr_db=10.0, precision='single')),
+    'multibeam': digest(hybrid.calculate_multibeam_pattern(params, theta, [-30.0, 0.0, 40.0], snr_db=10.0)),
+}
+with hybrid.PatternPlan(params, theta) as plan:
+    results['plan_awgn'] = digest(plan.execute(snr_db=10.0))
+print(json.dumps(results))
+"""
+
+
+def test_random_draws_do_not_depend_on_thread_count():
+    serial = _run_with_threads(RANDOM_DRAWS_SCRIPT, 1)
+    for threads in (2, 4):
+        assert _run_with_threads(RANDOM_DRAWS_SCRIPT, threads) == serial
+
+
+# 500 trials span several 32-trial reduction chunks
+MONTE_CARLO_SCRIPT = """
+import hashlib, json
+import numpy as np
+import linear_array_hybrid as hybrid
+
+params = hybrid.ArrayParameters(n_elements=32, spacing_wavelength=0.5, steering_angle=15.0,
+                                phase_error_std=8.0, seed=16)
+stats = hybrid.monte_carlo_statistics(params, np.linspace(-90, 90, 361), 500, (-40.0, 0.0), 40)
+print(json.dumps({name: hashlib.sha256(value.tobytes()).hexdigest() if isinstance(value, np.ndarray) else value
+                  for name, value in stats.items()}))
+"""
+
+
+def test_monte_carlo_is_bit_identical_across_thread_counts():
+    serial = _run_with_threads(MONTE_CARLO_SCRIPT, 1)
+    assert serial['trials'] == 500
+    for threads in (3, 4):
+        assert _run_with_threads(MONTE_CARLO_SCRIPT, threads) == serial
+
+
+def test_monte_carlo_histogram_counts_every_trial():
+    params = hybrid.ArrayParameters(n_elements=32, spacing_wavelength=0.5, phase_error_std=8.0, seed=16)
+    stats = hybrid.monte_carlo_statistics(params, np.linspace(-90, 90, 361), 100, (-40.0, 0.0), 40)
+    assert int(stats['psll_histogram'].sum()) == stats['trials'] == 100
+    assert np.all(stats['var_power'] >= 0)
+
+
+def test_monte_carlo_psll_summary_does_not_depend_on_histogram_range():
+    theta = np.linspace(-90, 90, 3601)
+    runs = []
+    for psll_range in ((-20.0, 0.0), (-100.0, 0.0)):
+        params = hybrid.ArrayParameters(n_elements=32, spacing_wavelength=0.5, amplitude_weights=np.hamming(32),
+                                        phase_error_std=1.0, seed=16)
+        runs.append(hybrid.monte_carlo_statistics(params, theta, 500, psll_range, 40))
+    clipped, wide = runs
+    # A Hamming taper keeps every sidelobe far below -20 dB, so all trials land in the first bin
+    assert int(clipped['psll_histogram'][0]) == 500
+    assert wide['psll_mean_db'] < -35
+    for name in ('psll_mean_db', 'psll_std_db', 'psll_worst_db'):
+        assert clipped[name] == wide[name], name
+    assert wide['psll_std_db'] > 0
+
+    # Without a sidelobe on the grid the level is -inf: first bin, no mean
+    params = hybrid.ArrayParameters(n_elements=32, spacing_wavelength=0.5, phase_error_std=1.0, seed=16)
+    stats = hybrid.monte_carlo_statistics(params, np.linspace(-1, 1, 101), 10, (-20.0, 0.0), 4)
+    assert stats['psll_histogram'].tolist() == [10, 0, 0, 0]
+    assert stats['psll_mean_db'] == stats['psll_worst_db'] == -np.inf and stats['psll_std_db'] == 0
+
+
+def _pattern_then_awgn(params, theta, snr_db, signal_power=None):
+    pattern = hybrid.calculate_pattern(params, theta)
+    assert hybrid._lib.add_awgn_power(pattern, len(pattern), snr_db, signal_power or 0.0) == 0
+    return pattern
+
+
+@pytest.mark.parametrize('n_elements, n_theta, phase_error_std', [(7, 333, 3.0), (50, 4001, 0.0), (50, 4001, 4.0)])
+def test_fused_awgn_matches_pattern_then_noise(n_elements, n_theta, phase_error_std):
+    params = _random_params(n_elements, steering_angle=10.0, phase_error_std=phase_error_std)
+    theta = np.linspace(-90, 90, n_theta)
+    hybrid._lib.seed_rng(5)
+    fused = hybrid.calculate_pattern(params, theta, snr_db=10.0)
+    hybrid._lib.seed_rng(5)
+    separate = _pattern_then_awgn(params, theta, 10.0)
+    # Measuring the signal power sums tiles in another order, so allow a few ulps
+    assert _relative_error(fused, separate) < 1e-12
+
+
+def test_fused_awgn_with_known_power_is_exact():
+    params = _random_params(50, steering_angle=10.0, phase_error_std=4.0)
+    theta = np.linspace(-90, 90, 4001)
+    hybrid._lib.seed_rng(5)
+    fused = hybrid.calculate_pattern(params, theta, snr_db=10.0, signal_power=12.5)
+    hybrid._lib.seed_rng(5)
+    assert np.array_equal(fused, _pattern_then_awgn(params, theta, 10.0, signal_power=12.5))
+
+
+@pytest.mark.parametrize('steering_angle, phase_error_std', [(0.0, 0.0), (25.0, 0.0), (-60.0, 3.0)])
+def test_plan_matches_calculate_pattern(steering_angle, phase_error_std):
+    params = _random_params(40, phase_error_std=phase_error_std)
+    theta = np.linspace(-90, 90, 1500)
+    tolerance = 1e-12 * params.n_elements
+    with hybrid.PatternPlan(params, theta) as plan:
+        hybrid._lib.seed_rng(4)
+        planned = plan.execute(steering_angle=steering_angle).copy()
+        hybrid._lib.seed_rng(4)
+        params.steering_angle = steering_angle
+        assert np.allclose(planned, hybrid.calculate_pattern(params, theta), rtol=0, atol=tolerance)
+
+        hybrid._lib.seed_rng(4)
+        noisy = plan.execute(snr_db=10.0).copy()
+        hybrid._lib.seed_rng(4)
+        assert np.allclose(noisy, hybrid.calculate_pattern(params, theta, snr_db=10.0), rtol=0, atol=tolerance)
+        if phase_error_std == 0:
+            assert plan.signal_power.value == pytest.approx(np.mean(np.abs(planned) ** 2), rel=1e-12)
+
+
+def test_plan_picks_up_new_weights():
+    params = _random_params(16)
+    theta = np.linspace(-90, 90, 181)
+    other = _random_params(16, seed=1)
+    with hybrid.PatternPlan(params, theta) as plan:
+        plan.set_weights(other.amplitude_weights, other.phase_weights)
+        assert np.allclose(plan.execute(), hybrid.calculate_pattern(other, theta), rtol=0, atol=1e-12)
+
+
+@pytest.mark.parametrize('nx, ny, dx, dy, steering_theta, steering_phi, phase_error_std', [
+    (1, 7, 0.5, 0.5, 0.0, 0.0, 0.0),
+    (8, 5, 0.5, 0.6, 20.0, 30.0, 0.0),
+    (16, 16, 0.45, 0.55, -35.0, 120.0, 2.0),
+])
+def test_separable_planar_matches_positions_fallback(nx, ny, dx, dy, steering_theta, steering_phi, phase_error_std):
+    rng = np.random.default_rng(19)
+    amplitude_weights = rng.uniform(0.5, 1.5, (ny, nx))
+    phase_weights = rng.uniform(-180.0, 180.0, (ny, nx))
+    x, y = np.meshgrid(np.arange(nx) * dx, np.arange(ny) * dy)
+    theta = np.linspace(-90, 90, 91)
+    phi = np.linspace(-180, 180, 73)
+
+    def pattern(element_positions):
+        # Reseeding makes both engines draw the same phase errors
+        params = planar.PlanarArrayParameters(nx=nx, ny=ny, dx_wavelength=dx, dy_wavelength=dy,
+                                              steering_theta=steering_theta, steering_phi=steering_phi,
+                                              amplitude_weights=amplitude_weights, phase_weights=phase_weights,
+                                              phase_error_std=phase_error_std,
+                                              element_positions=element_positions, seed=2)
+        return planar.calculate_planar_pattern(params, theta, phi)
+
+    fallback = pattern(np.column_stack([x.ravel(), y.ravel()]))
+    assert _relative_error(pattern(None), fallback) < 1e-12
+
+
+def _uniform_power(n_elements, spacing_wavelength, steering_angle, theta):
+    """|AF|^2 of a uniform array, sin(N psi/2)^2 / sin(psi/2)^2"""
+    psi = 2 * np.pi * spacing_wavelength * (np.sin(np.deg2rad(theta)) - np.sin(np.deg2rad(steering_angle)))
+    half = np.sin(psi / 2)
+    with np.errstate(divide='ignore', invalid='ignore'):
+        power = (np.sin(n_elements * psi / 2) / half) ** 2
+    return np.where(np.abs(half) < 1e-15, float(n_elements ** 2), power)
+
+
+def _half_power_angle(n_elements, spacing_wavelength, steering_angle, inside, outside):
+    """Bisect for |AF|^2 = N^2 / 2 between a point inside and one outside the main lobe"""
+    for _ in range(100):
+        middle = (inside + outside) / 2
+        if _uniform_power(n_elements, spacing_wavelength, steering_angle, middle) > n_elements ** 2 / 2:
+            inside = middle
+        else:
+            outside = middle
+    return (inside + outside) / 2
+
+
+@pytest.mark.parametrize('n_elements, spacing_wavelength, steering_angle', [(8, 0.5, 0.0), (16, 0.5, 20.0), (33, 0.5, 5.0)])
+def test_analyze_pattern_matches_uniform_array_theory(n_elements, spacing_wavelength, steering_angle):
+    params = hybrid.ArrayParameters(n_elements=n_elements, spacing_wavelength=spacing_wavelength,
+                                    steering_angle=steering_angle)
+    metrics = hybrid.analyze_pattern(params, tolerance_deg=1e-9)
+
+    # Nulls sit at sin(theta) = sin(theta0) + m / (N d) for every m not divisible by N
+    u0 = np.sin(np.deg2rad(steering_angle))
+    m = np.array([m for m in range(-2 * n_elements, 2 * n_elements + 1) if m % n_elements])
+    u = u0 + m / (n_elements * spacing_wavelength)
+    nulls = np.sort(np.rad2deg(np.arcsin(u[np.abs(u) < 1])))
+    assert metrics['n_nulls'] == len(nulls)
+    assert np.allclose(np.sort(metrics['null_angles_deg']), nulls, rtol=0, atol=1e-6)
+
+    first_nulls = np.rad2deg(np.arcsin(u0 + np.array([-1, 1]) / (n_elements * spacing_wavelength)))
+    left = _half_power_angle(n_elements, spacing_wavelength, steering_angle, steering_angle, first_nulls[0])
+    right = _half_power_angle(n_elements, spacing_wavelength, steering_angle, steering_angle, first_nulls[1])
+    assert metrics['peak_angle_deg'] == pytest.approx(steering_angle, abs=1e-6)
+    assert metrics['peak_power'] == pytest.approx(n_elements ** 2, rel=1e-9)
+    assert metrics['half_power_left_deg'] == pytest.approx(left, abs=1e-6)
+    assert metrics['half_power_right_deg'] == pytest.approx(right, abs=1e-6)
+    assert metrics['beamwidth_3db_deg'] == pytest.approx(right - left, abs=1e-6)
+
+    theta = np.linspace(-90, 90, 400001)
+    sidelobes = (theta < first_nulls[0]) | (theta > first_nulls[1])
+    psll_db = 10 * np.log10(_uniform_power(n_elements, spacing_wavelength, steering_angle, theta[sidelobes]).max()
+                            / n_elements ** 2)
+    assert metrics['psll_db'] == pytest.approx(psll_db, abs=1e-3)
+
+
+def test_stats_count_calls_evaluations_and_rng_draws():
+    params = hybrid.ArrayParameters(n_elements=8, spacing_wavelength=0.5, phase_error_std=2.0)
+    theta = np.linspace(-90, 90, 100)
+    hybrid.set_stats_enabled(True)
+    try:
+        assert hybrid.get_stats_enabled()
+        hybrid.reset_stats()
+        pattern = hybrid.calculate_pattern(params, theta)
+        stats = hybrid.get_stats()
+        # Box-Muller draws come in pairs, one per two elements or two noise components
+        assert (stats['calls'], stats['evaluations'], stats['rng_draws']) == (1, 800, 4)
+
+        assert hybrid._lib.add_awgn_power(pattern, len(pattern), 10.0, 0.0) == 0
+        stats = hybrid.get_stats()
+        assert (stats['calls'], stats['evaluations'], stats['rng_draws']) == (2, 800, 104)
+
+        hybrid.calculate_pattern(params, theta, snr_db=10.0)
+        stats = hybrid.get_stats()
+        assert (stats['calls'], stats['evaluations'], stats['rng_draws']) == (3, 1600, 208)
+        assert stats['kernel_cycles'] > 0 and stats['kernel_ns'] > 0
+
+        # Batched calls count once, with the terms and draws of every beam or weight set
+        hybrid.reset_stats()
+        hybrid.calculate_multibeam_pattern(params, theta, [0.0, 10.0, -20.0])
+        stats = hybrid.get_stats()
+        assert (stats['calls'], stats['evaluations'], stats['rng_draws']) == (1, 2400, 12)
+        hybrid.calculate_weight_set_patterns(params, theta, np.ones((2, 8)), np.zeros((2, 8)))
+        stats = hybrid.get_stats()
+        assert (stats['calls'], stats['evaluations'], stats['rng_draws']) == (2, 4000, 20)
+        assert stats['kernel_cycles'] > 0 and stats['setup_cycles'] > 0
+
+        hybrid.reset_stats()
+        metrics = hybrid.analyze_pattern(params)
+        stats = hybrid.get_stats()
+        assert (stats['calls'], stats['evaluations'], stats['rng_draws']) == (1, 8 * metrics['evaluations'], 4)
+        assert stats['kernel_cycles'] > 0
+
+        hybrid.reset_stats()
+        stats = hybrid.get_stats()
+        assert stats['calls'] == stats['evaluations'] == stats['rng_draws'] == stats['kernel_cycles'] == 0
+
+        hybrid.set_stats_enabled(False)
+        hybrid.calculate_pattern(params, theta)
+        assert hybrid.get_stats()['calls'] == 0
+    finally:
+        hybrid.set_stats_enabled(False)
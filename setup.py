@@ -1,10 +1,94 @@
-from setuptools import setup, find_packages
+import os
+import platform
+import shutil
+import sys
+import tempfile
+
+from setuptools import setup, find_packages, Extension
+from setuptools.command.build_ext import build_ext
+from setuptools.errors import CompileError, LinkError
+
+import native_build
+
+# C libraries loaded through ctypes, as (directory, library name)
+NATIVE_LIBS = [
+    ("dragon_eggs", "egg_drop_lib"),
+    ("radiation_pattern", "radiation_pattern_lib"),
+    ("life", "life_lib"),
+]
+
+_X86 = platform.machine().lower() in ("x86_64", "amd64", "i386", "i686")
+
+# Every library is built once per ISA level; the loaders in native_build
+# pick the best variant the CPU supports at load time (suffix, extra flags)
+ISA_VARIANTS = [("", [])] + ([(f"_{isa}", flags) for isa, _, flags in native_build.ISA_VARIANTS] if _X86 else [])
+
+
+class build_native(build_ext):
+    """Build the ctypes libraries as plain shared objects with OpenMP.
+
+    The compiler is probed for -fopenmp first; without it the libraries
+    still build, with their parallel loops running serially.
+    """
+
+    def build_extensions(self):
+        self.openmp = self._has_openmp()
+        if not self.openmp:
+            self.warn("compiler does not support -fopenmp, native libraries will run serially")
+        super().build_extensions()
+
+    def build_extension(self, ext):
+        openmp = ["-fopenmp"] if self.openmp else []
+        ext.extra_compile_args = ["-O3"] + openmp + ext.isa_flags
+        ext.extra_link_args = openmp
+        super().build_extension(ext)
+
+    def get_ext_filename(self, ext_name):
+        # ctypes loads the file by name, so no Python ABI tag
+        return os.path.join(*ext_name.split(".")) + (".dll" if sys.platform == "win32" else ".so")
+
+    def get_export_symbols(self, ext):
+        # Not a Python module, there is no PyInit_ function to export
+        return ext.export_symbols
+
+    def _has_openmp(self):
+        flags = ["-fopenmp"]
+        tmp = tempfile.mkdtemp()
+        try:
+            src = os.path.join(tmp, "probe.c")
+            with open(src, "w") as f:
+                f.write("#include <omp.h>\nint main(void) { return omp_get_max_threads() > 0 ? 0 : 1; }\n")
+            objects = self.compiler.compile([src], output_dir=tmp, extra_postargs=flags)
+            self.compiler.link_executable(objects, "probe", output_dir=tmp, extra_postargs=flags)
+            return True
+        except (CompileError, LinkError):
+            return False
+        finally:
+            shutil.rmtree(tmp, ignore_errors=True)
+
+
+def native_extensions():
+    extensions = []
+    for directory, name in NATIVE_LIBS:
+        for suffix, flags in ISA_VARIANTS:
+            ext = Extension(
+                f"{directory}.{name}{suffix}",
+                sources=[os.path.join(directory, f"{name}.c")],
+                libraries=[] if sys.platform == "win32" else ["m"],
+            )
+            ext.isa_flags = flags
+            extensions.append(ext)
+    return extensions
+
 
 setup(
     name="life",
     version="0.1.0",
     description="Conway's Game of Life implementation with visualizations",
     packages=find_packages(),
+    py_modules=["native_build"],
+    ext_modules=native_extensions(),
+    cmdclass={"build_ext": build_native},
     python_requires=">=3.8",
     install_requires=[
         "matplotlib>=3.0",
@@ -15,4 +99,4 @@ setup(
             "pytest>=7.0",
         ],
     },
-)
\ No newline at end of file
+)
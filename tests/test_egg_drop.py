@@ -0,0 +1,367 @@
+import json
+import math
+import os
+import random
+import re
+import shutil
+import subprocess
+import sys
+import threading
+
+import pytest
+
+np = pytest.importorskip("numpy")
+
+EGGS_DIR = os.path.join(os.path.dirname(os.path.dirname(os.path.abspath(__file__))), "dragon_eggs")
+sys.path.insert(0, EGGS_DIR)
+from egg_drop_hybrid import HybridEggDropSolver  # noqa: E402
+
+solver = HybridEggDropSolver()
+
+
+def _fields(result) -> tuple:
+    return int(result["breaking_floor"]), int(result["drops_used"]), int(result["optimal_drops"])
+
+
+def test_find_breaking_points_matches_scalar_calls():
+    rng = random.Random(1)
+    # Heights past 500500 floors use the capped 1000-point schedule
+    heights = [rng.randint(1, 1 << 20) for _ in range(500)] + list(range(1, 40))
+    floors = [rng.randint(1, h) for h in heights]
+    results = solver.find_breaking_points(floors, heights)
+    assert len(results) == len(floors)
+    for result, floor, height in zip(results, floors, heights):
+        assert _fields(result) == solver.find_breaking_point(floor, height)[:3]
+
+
+def test_find_breaking_points_broadcasts_one_height():
+    results = solver.find_breaking_points(range(1, 1001), 1000)
+    assert [int(d) for d in results["drops_used"]] == \
+        [solver.find_breaking_point(floor, 1000)[1] for floor in range(1, 1001)]
+
+
+def test_find_breaking_point_is_thread_safe_under_eviction():
+    heights = [97 * i for i in range(1, 41)]
+    expected = {h: [solver.find_breaking_point(b, h)[:3] for b in range(1, h + 1, 13)] for h in heights}
+    mismatches = []
+
+    def worker(offset):
+        for i in range(400):
+            h = heights[(i * 7 + offset) % len(heights)]
+            got = [solver.find_breaking_point(b, h)[:3] for b in range(1, h + 1, 13)]
+            if got != expected[h]:
+                mismatches.append(h)
+
+    # A cache smaller than the working set evicts plans other threads still hold
+    capacity = solver.lib.get_plan_cache_capacity()
+    solver.set_plan_cache_capacity(4)
+    try:
+        threads = [threading.Thread(target=worker, args=(t,)) for t in range(8)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+    finally:
+        solver.set_plan_cache_capacity(capacity)
+    assert mismatches == []
+
+
+def _floors_near_drop_points(total_floors: int) -> list:
+    k = solver.get_optimal_drops(total_floors)
+    points = [k * (k + 1) // 2 - (k - j) * (k - j + 1) // 2 for j in range(1, min(k, 1000) + 1)]
+    floors = {1, total_floors}
+    for point in points:
+        floors.update(f for f in (point - 1, point, point + 1) if 1 <= f <= total_floors)
+    return sorted(floors)
+
+
+def test_closed_form_matches_simulation_on_small_buildings():
+    for height in range(1, 200):
+        for floor in range(1, height + 1):
+            assert solver.find_breaking_point(floor, height, closed_form=True)[:3] == \
+                solver.find_breaking_point(floor, height)[:3], (floor, height)
+
+
+def test_closed_form_matches_simulation_around_drop_points():
+    rng = random.Random(3)
+    # 500500 floors is the last height whose schedule fits the 1000 drop points
+    for height in (499500, 500500, 500501, 1 << 20):
+        floors = _floors_near_drop_points(height) + [rng.randint(1, height) for _ in range(200)]
+        expected = [solver.find_breaking_point(f, height)[:3] for f in floors]
+        assert [solver.find_breaking_point(f, height, closed_form=True)[:3] for f in floors] == expected
+        results = solver.find_breaking_points(floors, height, closed_form=True)
+        assert [_fields(r) for r in results] == expected
+
+
+def _brute_force_drops(eggs: int, total_floors: int) -> list:
+    """f[e][n]: minimal worst-case drops by the textbook O(k n^2) recurrence"""
+    f = [[0] + [float("inf")] * total_floors] + [[0] * (total_floors + 1) for _ in range(eggs)]
+    for e in range(1, eggs + 1):
+        for n in range(1, total_floors + 1):
+            f[e][n] = 1 + min(max(f[e - 1][x - 1], f[e][n - x]) for x in range(1, n + 1))
+    return f
+
+
+def test_k_egg_drops_match_brute_force():
+    f = _brute_force_drops(4, 80)
+    for eggs in range(1, 5):
+        assert [int(d) for d in solver.get_min_drops_batch(eggs=eggs, total_floors=range(81))] == f[eggs]
+        for n in range(81):
+            assert solver.get_min_drops(eggs=eggs, total_floors=n) == f[eggs][n], (eggs, n)
+
+
+def test_k_egg_plan_meets_its_optimum():
+    f = _brute_force_drops(4, 80)
+    for eggs in range(1, 5):
+        for n in range(81):
+            with solver.create_k_egg_plan(eggs=eggs, total_floors=n) as plan:
+                worst = 0
+                for breaking_floor in range(1, n + 2):
+                    found, drops, optimal, broken = plan.query(breaking_floor)
+                    assert (found, optimal) == (breaking_floor, f[eggs][n])
+                    assert drops <= optimal and broken <= eggs
+                    worst = max(worst, drops)
+                assert worst == f[eggs][n], (eggs, n)
+
+
+def test_64_bit_path_matches_32_bit_where_both_apply():
+    rng = random.Random(5)
+    # Past 500500 floors the 32-bit schedule is capped, so only compare below it
+    heights = list(range(1, 300)) + [rng.randint(1, 500500) for _ in range(50)] + [500500]
+    for height in heights:
+        assert solver.get_optimal_drops64(height) == solver.get_optimal_drops(height)
+        floors = [1, height] + [rng.randint(1, height) for _ in range(20)]
+        expected = [solver.find_breaking_point(f, height)[:3] for f in floors]
+        assert [solver.find_breaking_point64(f, height)[:3] for f in floors] == expected
+        assert [_fields(r) for r in solver.find_breaking_points64(floors, height)] == expected
+
+
+def test_64_bit_optimum_above_4g_floors():
+    for height in (1 << 32, (1 << 32) + 12345, 1 << 50, 18446744070963499500):
+        drops = math.isqrt(8 * height) // 2
+        while drops * (drops + 1) // 2 < height:
+            drops += 1
+        while drops > 0 and (drops - 1) * drops // 2 >= height:
+            drops -= 1
+        assert solver.get_optimal_drops64(height) == drops
+        found, _, optimal, _ = solver.find_breaking_point64(height - 1, height)
+        assert (found, optimal) == (height - 1, drops)
+
+
+def test_64_bit_drop_points_are_bounded_by_default():
+    from egg_drop_hybrid import MAX_DROP_POINTS64
+    points = solver.get_drop_points64(500500)
+    assert len(points) == 1000 and int(points[0]) == 1000 and int(points[-1]) == 500500
+
+    height = 1 << 62
+    drops = solver.get_optimal_drops64(height)
+    with pytest.raises(ValueError, match="max_points"):
+        solver.get_drop_points64(height)
+    points = solver.get_drop_points64(height, max_points=MAX_DROP_POINTS64 + 1)
+    assert len(points) == MAX_DROP_POINTS64 + 1
+    assert [int(p) for p in points[:3]] == [drops, 2 * drops - 1, 3 * drops - 3]
+
+
+@pytest.mark.parametrize('kernel', ['avx512', 'avx2', 'neon'])
+def test_simd_kernels_match_scalar(kernel):
+    rng = random.Random(8)
+    heights = [rng.randint(1, 1 << 22) for _ in range(1003)]
+    floors = [rng.randint(1, h) for h in heights]
+    try:
+        solver.set_simd_kernel('scalar')
+        expected = [_fields(r) for r in solver.find_breaking_points(floors, heights, closed_form=True)]
+        try:
+            solver.set_simd_kernel(kernel)
+        except ValueError:
+            pytest.skip(f"{kernel} is not supported on this CPU")
+        # Counts around the vector width exercise the masked tails
+        for n in (0, 1, 7, 8, 9, len(floors)):
+            results = solver.find_breaking_points(floors[:n], heights[:n], closed_form=True)
+            assert [_fields(r) for r in results] == expected[:n], n
+    finally:
+        solver.set_simd_kernel(None)
+
+
+def _brute_force_sweep(min_floors: int, max_floors: int, num_bins: int) -> tuple:
+    stats = dict(queries=0, total_drops=0, max_drops=0, at_optimal=0, over_optimal=0)
+    worst = None
+    histogram = np.zeros(num_bins, dtype=np.uint64)
+    for height in range(min_floors, max_floors + 1):
+        drops = solver.find_breaking_points(np.arange(1, height + 1), height)["drops_used"].astype(np.int64)
+        optimal = solver.get_optimal_drops(height)
+        most = int(drops.max())
+        # The worst case is the lowest height, then the lowest floor, with the most drops
+        if most > stats["max_drops"]:
+            stats["max_drops"] = most
+            worst = (height, int(np.argmax(drops)) + 1)
+        stats["queries"] += height
+        stats["total_drops"] += int(drops.sum())
+        stats["at_optimal"] += int((drops == optimal).sum())
+        stats["over_optimal"] += int((drops > optimal).sum())
+        histogram += np.bincount(np.minimum(drops, num_bins - 1), minlength=num_bins).astype(np.uint64)
+    stats["worst_total_floors"], stats["worst_breaking_floor"] = worst
+    return stats, histogram
+
+
+def test_sweep_matches_brute_force():
+    # The last range straddles 500500 floors, where the schedule becomes capped
+    for min_floors, max_floors, num_bins in ((1, 150, 12), (40, 60, 40), (1, 1, 3), (500495, 500505, 60)):
+        expected, expected_histogram = _brute_force_sweep(min_floors, max_floors, num_bins)
+        stats, histogram = solver.sweep(min_floors, max_floors, num_bins)
+        assert {name: stats[name] for name in expected} == expected
+        assert stats["mean_drops"] == pytest.approx(expected["total_drops"] / expected["queries"])
+        assert histogram.tolist() == expected_histogram.tolist()
+        for threads in (1, 4):
+            assert solver.sweep(min_floors, max_floors, num_bins, threads)[0] == stats
+
+
+def _build_solver(tmp_path, *flags):
+    if shutil.which("gcc") is None:
+        pytest.skip("gcc is required to build egg_drop_solver")
+    exe = str(tmp_path / ("egg_drop_solver" + "".join(flags)))
+    subprocess.run(["gcc", "-O2", *flags, "-o", exe, os.path.join(EGGS_DIR, "egg_drop_solver.c"), "-lm", "-pthread"],
+                   check=True)
+    return exe
+
+
+# A benchmark small enough to keep the solver tests fast
+_QUICK_BENCH = ["--sizes", "100,1000", "--dist", "uniform,worst", "--batches", "20",
+                "--warmup-batches", "10", "--max-seconds", "0.2"]
+
+
+def test_solver_verify_reports_brute_force_violations(tmp_path):
+    exe = _build_solver(tmp_path)
+    height_limit = 60
+    proc = subprocess.run([exe, "--verify", str(height_limit)], capture_output=True, text=True)
+
+    violations = []
+    for height in range(1, height_limit + 1):
+        drops = [solver.find_breaking_point(f, height)[1] for f in range(1, height + 1)]
+        worst = max(drops)
+        if worst > solver.get_optimal_drops(height):
+            violations.append((height, drops.index(worst) + 1, worst, solver.get_optimal_drops(height)))
+
+    assert proc.returncode == (1 if violations else 0), proc.stderr
+    assert f"Heights checked: 1 - {height_limit}" in proc.stdout
+    assert f"Cross-checked floor by floor: 1 - {height_limit}" in proc.stdout
+    count = re.search(r"Heights exceeding the optimal drops: (\d+)", proc.stdout)
+    assert count and int(count.group(1)) == len(violations)
+    listed = re.findall(r"(\d+) floors: floor (\d+) takes (\d+) drops, optimal (\d+)", proc.stdout)
+    assert [tuple(map(int, v)) for v in listed] == violations[:10]
+
+
+def test_solver_timing_switch_only_changes_the_demo_times(tmp_path):
+    outputs = {}
+    for flags in ((), ("-DEGG_DROP_TIMING=0",)):
+        proc = subprocess.run([_build_solver(tmp_path, *flags), *_QUICK_BENCH, "--format", "csv"],
+                              capture_output=True, text=True)
+        assert proc.returncode == 0, proc.stderr
+        outputs[flags] = proc.stdout
+
+    timed, untimed = outputs[()], outputs[("-DEGG_DROP_TIMING=0",)]
+    times = [[float(t) for t in re.findall(r"^Time: ([\d.]+) ns", out, re.M)] for out in (timed, untimed)]
+    assert len(times[0]) == len(times[1]) == 5
+    assert all(t > 0 for t in times[0]) and all(t == 0 for t in times[1])
+
+    # Results are the same either way, and the benchmark times batches on its own
+    results = re.compile(r"^(?:Found floor|Drops used): .*$", re.M)
+    assert results.findall(timed) == results.findall(untimed) and len(results.findall(timed)) == 10
+    rows = [line.split(",") for line in untimed.splitlines() if re.match(r"\d+,(uniform|worst),", line)]
+    assert len(rows) == 4 and all(float(row[8]) > 0 for row in rows)
+
+
+def test_stats_count_calls_queries_and_plan_cache_use():
+    capacity = solver.lib.get_plan_cache_capacity()
+    # Emptying the cache makes the first lookup of each height a miss
+    solver.set_plan_cache_capacity(0)
+    solver.set_plan_cache_capacity(16)
+    solver.set_stats_enabled(True)
+    try:
+        solver.reset_stats()
+        for _ in range(3):
+            solver.find_breaking_point(5, 100)
+        stats = solver.get_stats()
+        assert (stats["calls"], stats["queries"]) == (3, 3)
+        assert (stats["plan_cache_hits"], stats["plan_cache_misses"], stats["allocations"]) == (2, 1, 1)
+
+        # A batch is one call and looks up each run of equal heights once
+        solver.find_breaking_points([1, 2, 3, 50, 60], [100, 100, 100, 200, 200])
+        stats = solver.get_stats()
+        assert (stats["calls"], stats["queries"]) == (4, 8)
+        assert (stats["plan_cache_hits"], stats["plan_cache_misses"], stats["allocations"]) == (3, 2, 2)
+        assert stats["kernel_cycles"] > 0 and stats["kernel_ns"] > 0
+
+        solver.reset_stats()
+        stats = solver.get_stats()
+        assert stats["calls"] == stats["queries"] == stats["allocations"] == stats["kernel_cycles"] == 0
+
+        solver.set_stats_enabled(False)
+        solver.find_breaking_point(5, 300)
+        assert solver.get_stats()["calls"] == 0
+    finally:
+        solver.set_stats_enabled(False)
+        solver.set_plan_cache_capacity(capacity)
+
+
+def test_plan_cache_evicts_least_recently_used_height():
+    capacity = solver.lib.get_plan_cache_capacity()
+    solver.set_plan_cache_capacity(0)
+    solver.set_plan_cache_capacity(2)
+    solver.set_stats_enabled(True)
+
+    def lookup(height):
+        before = solver.get_stats()["plan_cache_hits"]
+        solver.find_breaking_point(1, height)
+        return solver.get_stats()["plan_cache_hits"] > before
+
+    try:
+        # The hit on 100 makes 200 the least recently used plan, so 300 evicts it
+        assert [lookup(h) for h in (100, 200, 100, 300)] == [False, False, True, False]
+        assert lookup(100)
+        assert not lookup(200)
+    finally:
+        solver.set_stats_enabled(False)
+        solver.set_plan_cache_capacity(capacity)
+
+
+def test_solver_bench_mode_output_and_exit_codes(tmp_path):
+    exe = _build_solver(tmp_path)
+    proc = subprocess.run([exe, "--bench", *_QUICK_BENCH, "--format", "json", "--seed", "7"],
+                          capture_output=True, text=True)
+    assert proc.returncode == 0, proc.stderr
+    report = json.loads(proc.stdout)
+    assert (report["benchmark"], report["seed"], report["max_batches"]) == ("egg_drop_solver", 7, 20)
+    results = report["results"]
+    assert [(r["floors"], r["distribution"]) for r in results] == \
+        [(100, "uniform"), (100, "worst"), (1000, "uniform"), (1000, "worst")]
+    for r in results:
+        assert r["optimal_drops"] == solver.get_optimal_drops(r["floors"])
+        assert 0 < r["batches"] <= 20 and r["warmup_batches"] <= 10
+        assert 0 < r["min_ns"] <= r["p50_ns"] <= r["p99_ns"] <= r["p999_ns"] <= r["max_ns"]
+        assert r["avg_drops"] <= r["max_drops"]
+        if r["distribution"] == "worst":
+            assert r["avg_drops"] == r["max_drops"]
+
+    # The drops depend only on the seed, so CSV reports the same rows
+    proc = subprocess.run([exe, "--bench", *_QUICK_BENCH, "--format", "csv", "--seed", "7"],
+                          capture_output=True, text=True)
+    assert proc.returncode == 0, proc.stderr
+    header, *rows = proc.stdout.splitlines()
+    rows = [dict(zip(header.split(","), row.split(","))) for row in rows]
+    assert [(int(r["floors"]), r["distribution"], float(r["avg_drops"]), int(r["max_drops"])) for r in rows] == \
+        [(r["floors"], r["distribution"], r["avg_drops"], r["max_drops"]) for r in results]
+
+    proc = subprocess.run([exe, "--bench", *_QUICK_BENCH], capture_output=True, text=True)
+    assert proc.returncode == 0 and "Dragon Egg Drop Problem" not in proc.stdout
+    assert proc.stdout.count("Percentiles: p50") == 4
+
+    assert subprocess.run([exe, "--help"], capture_output=True, text=True).stdout.startswith("Usage:")
+    for args, message in ((["--sizes", "0"], "Invalid value for --sizes"),
+                          (["--dist", "bogus"], "Invalid value for --dist"),
+                          (["--format", "xml"], "Invalid value for --format"),
+                          (["--batch-size", "70000"], "Invalid value for --batch-size"),
+                          (["--max-seconds", "-1"], "Invalid value for --max-seconds"),
+                          (["--batches"], "Missing value for --batches"),
+                          (["--frob", "1"], "Unknown option: --frob")):
+        proc = subprocess.run([exe, "--bench", *args], capture_output=True, text=True)
+        assert proc.returncode == 1 and message in proc.stderr, (args, proc.stderr)
@@ -1,8 +1,11 @@
+import random
+
 import pytest
 from typing import FrozenSet
 
 from life import Grid, Game
-from life.game_of_life import Cell
+from life.game_of_life import Cell, format_rule, parse_rule
+from life.life_hybrid import HashLifeBoard, TiledBoard, get_life_lib
 
 
 def test_grid_from_and_to_2d_list_empty():
@@ -18,6 +21,22 @@ def test_grid_immutable_live_cells():
         g.live = set()  # Should not be able to assign to live property
 
 
+def test_grid_live_is_shared_not_copied():
+    g = Grid([(0, 0), (0, 1)])
+    assert g.live is g.live
+    assert g.copy().live is g.live
+    assert g.bounds == (0, 0, 0, 1)
+
+
+def test_grid_to_numpy_matches_2d_list():
+    np = pytest.importorskip("numpy")
+    g = Grid([(-2, 3), (0, 0), (1, 4), (7, 7)])
+    for bounds in (None, (-1, 1, 0, 4), (5, 9, 5, 9)):
+        expected = np.array(g.to_2d_list(bounds), dtype=np.uint8)
+        assert g.to_numpy(bounds).dtype == np.uint8
+        assert (g.to_numpy(bounds) == expected).all()
+
+
 def test_grid_from_and_to_2d_list_bounds():
     data = [
         [0, 1, 0],
@@ -105,6 +124,23 @@ def test_game_rules():
     assert game.apply_rules((0, 0), count=4, is_alive=False) == False  # Stays dead
 
 
+@pytest.mark.parametrize('rule, canonical', [('B3/S', 'B3/S'), ('S23/B36', 'B36/S23'), ('23/3', 'B3/S23')])
+def test_rule_parsing(rule, canonical):
+    assert format_rule(*parse_rule(rule)) == canonical
+
+
+@pytest.mark.parametrize('rule', ['B0/S23', 'B9/S23', 'B3/S23/C4', 'life'])
+def test_invalid_rules_rejected(rule):
+    with pytest.raises(ValueError):
+        parse_rule(rule)
+
+
+def test_highlife_rules():
+    game = Game(rule='B36/S23')
+    assert game.apply_rules((0, 0), count=6, is_alive=False) == True
+    assert game.apply_rules((0, 0), count=6, is_alive=True) == False
+
+
 def test_neighbor_counting():
     # Test neighbor counting for a simple pattern
     game = Game()
@@ -113,4 +149,230 @@ def test_neighbor_counting():
     
     assert counts[(0, 0)] == 2  # Center cell has 2 neighbors
     assert counts[(1, 1)] == 3  # Empty cell with 3 neighbors
-    assert (2, 2) not in counts  # Far cell not in counts since it has no neighbors
\ No newline at end of file
+    assert (2, 2) not in counts  # Far cell not in counts since it has no neighbors
+
+def _native_available() -> bool:
+    try:
+        get_life_lib()
+        return True
+    except RuntimeError:
+        return False
+
+
+native = pytest.mark.skipif(not _native_available(), reason="C engine could not be built")
+
+
+def _soup(size: int, seed: int) -> Grid:
+    rng = random.Random(seed)
+    return Grid((r, c) for r in range(size) for c in range(size) if rng.random() < 0.35)
+
+
+@native
+def test_native_matches_python_on_soup():
+    soup = _soup(48, seed=7)
+    reference = Game(soup, backend='python')
+    engine = Game(soup, backend='native')
+    for _ in range(5):
+        reference.run(20)
+        engine.run(20)
+        assert engine.grid.live == reference.grid.live
+
+
+@native
+def test_native_glider_travels_across_words():
+    # Starts left of the origin and crosses several 64-bit word boundaries
+    glider = {(-5 + r, -70 + c) for r, c in [(0, 1), (1, 2), (2, 0), (2, 1), (2, 2)]}
+    game = Game(Grid(glider), backend='native')
+    game.run(4 * 150)
+    assert game.grid.live == frozenset((r + 150, c + 150) for r, c in glider)
+
+
+def test_default_backend_is_python():
+    assert Game().backend == 'python'
+    assert Game(_soup(8, seed=1)).backend == 'python'
+
+
+@native
+def test_auto_backend_selects_tiled():
+    assert Game(_soup(8, seed=1), backend='auto').backend == 'tiled'
+
+
+@native
+def test_backend_switch_keeps_state():
+    game = Game(_soup(24, seed=3), backend='native')
+    game.run(10)
+    expected = Game(_soup(24, seed=3), backend='python').run(15).live
+    game.set_backend('python')
+    assert game.backend == 'python'
+    game.run(5)
+    assert game.grid.live == expected
+
+
+@native
+def test_hashlife_matches_native():
+    soup = _soup(40, seed=11)
+    engine = Game(soup, backend='native')
+    hashlife = Game(soup, backend='hashlife', memory_limit=HashLifeBoard.min_memory_limit())
+    for steps in (1, 6, 64, 129):
+        engine.run(steps)
+        hashlife.run(steps)
+        assert hashlife.grid.live == engine.grid.live
+
+
+@native
+def test_hashlife_rejects_memory_limits_below_one_block():
+    floor = HashLifeBoard.min_memory_limit()
+    assert 4 << 20 < floor < 8 << 20
+    with pytest.raises(ValueError, match="memory_limit"):
+        Game(_soup(10, seed=1), backend='hashlife', memory_limit=1 << 20)
+    board = HashLifeBoard(_soup(40, seed=11).live, memory_limit=floor)
+    with pytest.raises(ValueError, match="memory_limit"):
+        board.set_memory_limit(floor - 1)
+    board.set_memory_limit(None)
+    board.set_memory_limit(floor)
+    # The floor is honoured: the cache is collected once it outgrows one block
+    board.step(1 << 10)
+    assert board.memory_stats()['gc_runs'] > 0
+
+
+@native
+def test_hashlife_soup_matches_python_past_ten_generations():
+    # The soup fills the centre half of the padded root, so every jump
+    # must leave room for the cells that grow past it
+    soup = _soup(32, seed=3)
+    reference = Game(soup, backend='python')
+    hashlife = Game(soup, backend='hashlife')
+    for steps in (1, 2, 3, 5, 8, 13, 16):
+        reference.run(steps)
+        hashlife.run(steps)
+        assert hashlife.grid.live == reference.grid.live
+
+
+@native
+def test_hashlife_long_horizon_glider():
+    glider = {(r, c) for r, c in [(0, 1), (1, 2), (2, 0), (2, 1), (2, 2)]}
+    game = Game(Grid(glider), backend='hashlife')
+    game.run(4 * 10**9)
+    shift = 10**9
+    assert game.grid.live == frozenset((r + shift, c + shift) for r, c in glider)
+
+
+@native
+def test_tiled_matches_native():
+    soup = Grid((r - 100, c - 37) for r, c in _soup(90, seed=5).live)
+    engine = Game(soup, backend='native')
+    tiled = Game(soup, backend='tiled')
+    for steps in (1, 1, 3, 40, 200):
+        engine.run(steps)
+        tiled.run(steps)
+        assert tiled.grid.live == engine.grid.live
+
+
+@native
+def test_tiled_skips_settled_tiles():
+    # A block and a blinker in separate tiles: nothing needs stepping once settled
+    board = TiledBoard([(0, 0), (0, 1), (1, 0), (1, 1), (200, 10), (200, 11), (200, 12)])
+    board.step(3)
+    stats = board.tile_stats()
+    assert stats['active'] == 0
+    assert stats['flipped'] == 1
+    assert board.population == 7
+
+
+@native
+@pytest.mark.parametrize('backend', ['native', 'tiled'])
+def test_threaded_stepping_matches_serial(backend):
+    soup = _soup(300, seed=13)
+    serial = Game(soup, backend=backend, threads=1)
+    threaded = Game(soup, backend=backend, threads=4)
+    serial.run(60)
+    threaded.run(60)
+    assert threaded.grid.live == serial.grid.live
+
+
+@native
+@pytest.mark.parametrize('backend', ['native', 'tiled', 'hashlife'])
+def test_game_to_numpy_renders_viewport(backend):
+    pytest.importorskip("numpy")
+    game = Game(_soup(70, seed=17), backend=backend)
+    game.run(25)
+    bounds = (-10, 80, 5, 90)
+    rendered = game.to_numpy(bounds)
+    assert (rendered == game.grid.to_numpy(bounds)).all()
+
+
+@native
+@pytest.mark.parametrize('backend', ['python', 'tiled', 'hashlife'])
+@pytest.mark.parametrize('name', ['pattern.rle', 'pattern.mc'])
+def test_pattern_file_round_trip(tmp_path, backend, name):
+    # Offset from the origin so the saved position is checked too
+    soup = Grid((r - 500, c + 3000) for r, c in _soup(80, seed=19).live)
+    game = Game(soup, backend=backend)
+    game.run(30)
+    path = tmp_path / name
+    game.save(path)
+    loaded = Game.from_file(path, backend=backend)
+    assert loaded.generation == 30
+    assert loaded.grid.live == game.grid.live
+    assert Grid.from_file(path).live == game.grid.live
+
+
+@native
+def test_read_standard_rle(tmp_path):
+    path = tmp_path / 'glider.rle'
+    path.write_text("#N Glider\nx = 3, y = 3, rule = B3/S23\nbob$2bo$3o!\n")
+    assert Grid.from_file(path).live == frozenset([(0, 1), (1, 2), (2, 0), (2, 1), (2, 2)])
+    path.write_text("x = 3, y = 3, rule = S23/B36\nbob$2bo$3o!\n")
+    assert Game.from_file(path, backend='tiled').rule == 'B36/S23'
+    path.write_text("x = 3, y = 3, rule = B03/S23\nbob$2bo$3o!\n")
+    with pytest.raises(ValueError):
+        Grid.from_file(path)
+
+
+@native
+@pytest.mark.parametrize('backend', ['tiled', 'hashlife'])
+def test_read_pattern_rejects_files_without_a_header(tmp_path, backend):
+    path = tmp_path / 'bad.rle'
+    for text in ("junk", "", "\n\n", "#N Glider\nbob$2bo$3o!\n", "x = 3\nbob$2bo$3o!\n", "[M1]\n"):
+        path.write_text(text)
+        with pytest.raises(ValueError):
+            Grid.from_file(path)
+        with pytest.raises(ValueError):
+            Game.from_file(path, backend=backend)
+    # Comments and blank lines may precede the header
+    path.write_text("#C comment\n\nx=3,y=3\nbob$2bo$3o!\n")
+    assert len(Game.from_file(path, backend=backend).grid.live) == 5
+
+
+@native
+@pytest.mark.parametrize('backend', ['native', 'tiled', 'hashlife'])
+@pytest.mark.parametrize('rule', ['B36/S23', 'B2/S', 'B3678/S34678', 'B35678/S5678', 'B357/S1358'])
+def test_rule_engines_match_python(backend, rule):
+    # The last rule has no compiled kernel and takes the generic path
+    soup = _soup(40, seed=29)
+    reference = Game(soup, backend='python', rule=rule)
+    engine = Game(soup, backend=backend, rule=rule)
+    for _ in range(3):
+        reference.run(8)
+        engine.run(8)
+        assert engine.grid.live == reference.grid.live
+    engine.rule = reference.rule = 'B3/S23'
+    reference.run(8)
+    engine.run(8)
+    assert engine.grid.live == reference.grid.live
+
+
+@native
+@pytest.mark.parametrize('saver', ['tiled', 'hashlife'])
+@pytest.mark.parametrize('loader', ['native', 'tiled', 'hashlife'])
+def test_checkpointed_run_resumes(tmp_path, saver, loader):
+    soup = _soup(60, seed=23)
+    path = tmp_path / 'run.ckp'
+    game = Game(soup, backend=saver)
+    game.run(100, checkpoint_path=path, checkpoint_interval=40)
+    resumed = Game.from_checkpoint(path, backend=loader)
+    assert resumed.generation == 100
+    assert resumed.grid.live == game.grid.live
+    game.run(50)
+    resumed.run(50)
+    assert resumed.grid.live == game.grid.live
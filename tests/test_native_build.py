@@ -0,0 +1,62 @@
+import ctypes
+import os
+import shutil
+
+import pytest
+
+import native_build
+
+needs_gcc = pytest.mark.skipif(shutil.which("gcc") is None, reason="gcc is required")
+
+
+def _write_source(directory, body="int answer(void) { return 42; }\n"):
+    source = directory / "probe_lib.c"
+    source.write_text(body)
+    return source
+
+
+def _age(path, seconds):
+    stat = os.stat(path)
+    os.utime(path, (stat.st_atime - seconds, stat.st_mtime - seconds))
+
+
+@needs_gcc
+def test_missing_library_is_built(tmp_path):
+    _write_source(tmp_path)
+    lib_path = native_build.native_lib_path(str(tmp_path), "probe_lib")
+    assert lib_path == str(tmp_path / ("probe_lib" + native_build.LIB_EXT))
+    assert ctypes.CDLL(lib_path).answer() == 42
+
+
+@needs_gcc
+def test_stale_library_is_rebuilt(tmp_path):
+    source = _write_source(tmp_path)
+    lib_path = native_build.native_lib_path(str(tmp_path), "probe_lib")
+    _age(lib_path, 60)
+    source.write_text("int answer(void) { return 42; }\nint added(void) { return 7; }\n")
+    # Loading the old build would fail with AttributeError on the new function
+    rebuilt = native_build.native_lib_path(str(tmp_path), "probe_lib")
+    assert os.path.getmtime(rebuilt) >= os.path.getmtime(source)
+    assert ctypes.CDLL(rebuilt).added() == 7
+
+
+def test_stale_isa_variant_is_skipped(tmp_path, monkeypatch):
+    _write_source(tmp_path)
+    isa, required, _ = native_build.ISA_VARIANTS[-1]
+    variant = tmp_path / f"probe_lib_{isa}{native_build.LIB_EXT}"
+    baseline = tmp_path / ("probe_lib" + native_build.LIB_EXT)
+    variant.write_bytes(b"")
+    baseline.write_bytes(b"")
+    monkeypatch.setattr(native_build, "cpu_flags", lambda: frozenset(required))
+    assert native_build.native_lib_path(str(tmp_path), "probe_lib") == str(variant)
+    _age(variant, 60)
+    _age(baseline, -60)
+    assert native_build.native_lib_path(str(tmp_path), "probe_lib") == str(baseline)
+
+
+@needs_gcc
+def test_failed_build_leaves_no_temporary_files(tmp_path):
+    source = _write_source(tmp_path, "this is not C\n")
+    lib_path = str(tmp_path / ("probe_lib" + native_build.LIB_EXT))
+    assert not native_build.build_native_lib(str(source), lib_path)
+    assert sorted(os.listdir(tmp_path)) == ["probe_lib.c"]